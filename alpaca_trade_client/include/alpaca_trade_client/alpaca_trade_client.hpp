@@ -25,6 +25,8 @@ public:
         network_error,
         http_error,
         json_parse_error,
+        rate_limited,
+        duplicate_client_order_id,
     };
 
     alpaca_api_error(error_type type, int http_status, std::string message);
@@ -63,6 +65,15 @@ public:
 
     static std::shared_ptr<alpaca_trade_client> create(net::io_context& ioc, config config);
 
+    //
+    // connection management
+
+    /**
+     * Opens a connection to the trading API and keeps it warm, so the first order after a quiet period does not pay
+     * for DNS, TCP and TLS handshakes. Call once at startup.
+     */
+    [[nodiscard]] net::awaitable<std::expected<void, alpaca_api_error>> preconnect() const;
+
     //
     // /account
 
@@ -80,16 +91,29 @@ public:
 
     [[nodiscard]] net::awaitable<std::expected<std::vector<order>, alpaca_api_error>>         get_all_orders() const;
     [[nodiscard]] net::awaitable<std::expected<std::vector<order_deleted>, alpaca_api_error>> delete_all_orders() const;
+
+    /**
+     * Submits an order. With a client_order_id a failed submission is retried; if the retry is rejected because an
+     * earlier attempt already placed the order, that order is returned. A client_order_id that names some other
+     * order fails with error_type::duplicate_client_order_id.
+     */
     [[nodiscard]] net::awaitable<std::expected<order, alpaca_api_error>> create_order(const notional_order& no) const;
+    [[nodiscard]] net::awaitable<std::expected<order, alpaca_api_error>>
+        get_order_by_client_order_id(const std::string& client_order_id) const;
 
 private:
     explicit alpaca_trade_client(net::io_context& ioc, config cfg);
 
     [[nodiscard]] http::fields create_auth_headers() const;
 
+    // Order entry and cancellation use request_priority::high so they overtake queued account/position polling,
+    // which uses request_priority::low. Order entry opts into retries only with a client_order_id, which Alpaca
+    // deduplicates. Requests without a header_block get the auth headers block.
+
     template<http::verb Verb, typename ReturnType>
     [[nodiscard]] net::awaitable<std::expected<ReturnType, alpaca_api_error>> make_api_request(
         const std::string&                 endpoint,
+        async_rest_client::request_options options,
         http::status                       expected_status = http::status::ok,
         const std::optional<http::fields>& extra_headers   = std::nullopt) const;
 
@@ -97,12 +121,14 @@ private:
     [[nodiscard]] net::awaitable<std::expected<ReturnType, alpaca_api_error>> make_api_request(
         const std::string&                 endpoint,
         const std::string&                 body,
+        async_rest_client::request_options options,
         http::status                       expected_status = http::status::ok,
         const std::optional<http::fields>& extra_headers   = std::nullopt) const;
 
     template<http::verb Verb, typename ReturnType, bool HasBody>
     [[nodiscard]] net::awaitable<std::expected<ReturnType, alpaca_api_error>> make_api_request_impl(
         const std::string&                 endpoint,
+        async_rest_client::request_options options,
         http::status                       expected_status,
         const std::optional<std::string>&  body,
         const std::optional<http::fields>& extra_headers) const;
@@ -110,4 +136,10 @@ private:
 private:
     config                                                _cfg;
     std::shared_ptr<async_rest_client::async_rest_client> _rest_client{};
+
+    /**
+     * Credential headers, formatted once for request_options::header_block; the JSON variant adds Content-Type.
+     */
+    std::string _auth_header_block{};
+    std::string _json_header_block{};
 };
@@ -4,6 +4,7 @@
 #include <array>
 #include <boost/json.hpp>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 
 #include "account.hpp"
@@ -173,8 +174,8 @@ void enum_value_from_tag(json::value& jv, const EnumType& value)
 template<typename EnumType>
 EnumType enum_value_to_tag(const json::value& jv)
 {
-    const std::string value_str = json::value_to<std::string>(jv);
-    constexpr auto&   mappings  = enum_mapping<EnumType>::mappings;
+    const std::string_view value_str = jv.as_string();
+    constexpr auto&        mappings  = enum_mapping<EnumType>::mappings;
 
     auto it = std::find_if(
         mappings.begin(), mappings.end(), [&value_str](const auto& mapping) { return mapping.second == value_str; });
@@ -184,14 +185,14 @@ EnumType enum_value_to_tag(const json::value& jv)
         return it->first;
     }
 
-    throw std::invalid_argument("Invalid enum string: " + value_str);
+    throw std::invalid_argument("Invalid enum string: " + std::string{value_str});
 }
 
 template<typename EnumType>
 EnumType enum_value_to_tag_with_fallback(const json::value& jv, EnumType fallback)
 {
-    const std::string value_str = json::value_to<std::string>(jv);
-    constexpr auto&   mappings  = enum_mapping<EnumType>::mappings;
+    const std::string_view value_str = jv.as_string();
+    constexpr auto&        mappings  = enum_mapping<EnumType>::mappings;
 
     auto it = std::find_if(
         mappings.begin(), mappings.end(), [&value_str](const auto& mapping) { return mapping.second == value_str; });
@@ -206,5 +207,5 @@ EnumType enum_value_to_tag_with_fallback(const json::value& jv, EnumType fallbac
         return fallback;
     }
 
-    throw std::invalid_argument("Invalid enum string: " + value_str);
+    throw std::invalid_argument("Invalid enum string: " + std::string{value_str});
 }
@@ -1,5 +1,28 @@
 #include "alpaca_trade_client/alpaca_trade_client.hpp"
 #include <boost/json.hpp>
+#include <boost/url/encode.hpp>
+#include <boost/url/rfc/unreserved_chars.hpp>
+
+using async_rest_client::request_options;
+using async_rest_client::request_priority;
+
+namespace
+{
+
+// Alpaca allows 200 trading API requests per minute per account; polling may not touch the last 40, which are kept
+// for order entry and exits
+constexpr async_rest_client::rate_limit_options ALPACA_RATE_LIMIT{
+    .requests_per_period = 200, .period = std::chrono::seconds{60}, .high_priority_reserve = 40};
+
+// Alpaca answers a reused client_order_id with 422 and this message
+bool is_duplicate_client_order_id(const alpaca_api_error& error)
+{
+    return error.type() == alpaca_api_error::error_type::http_error
+        && error.http_status() == static_cast<int>(http::status::unprocessable_entity)
+        && error.message().find("client_order_id must be unique") != std::string::npos;
+}
+
+} // anonymous namespace
 
 //
 // alpaca_api_error class
@@ -63,13 +86,24 @@ std::shared_ptr<alpaca_trade_client> alpaca_trade_client::create(net::io_context
 //
 // alpaca_trade_client public methods
 
+net::awaitable<std::expected<void, alpaca_api_error>> alpaca_trade_client::preconnect() const
+{
+    if (const auto ec{co_await _rest_client->preconnect(_cfg.base_url())})
+    {
+        co_return std::unexpected{alpaca_api_error{alpaca_api_error::error_type::network_error, 0, ec.message()}};
+    }
+    co_return std::expected<void, alpaca_api_error>{};
+}
+
 net::awaitable<std::expected<trade_account, alpaca_api_error>> alpaca_trade_client::account() const
 {
-    co_return co_await make_api_request<http::verb::get, trade_account>("/account");
+    co_return co_await make_api_request<http::verb::get, trade_account>(
+        "/account", {.priority = request_priority::low});
 }
 net::awaitable<std::expected<std::vector<position>, alpaca_api_error>> alpaca_trade_client::all_open_positions() const
 {
-    co_return co_await make_api_request<http::verb::get, std::vector<position>>("/positions");
+    co_return co_await make_api_request<http::verb::get, std::vector<position>>(
+        "/positions", {.priority = request_priority::low});
 }
 net::awaitable<std::expected<std::vector<position_closed>, alpaca_api_error>>
     alpaca_trade_client::close_all_positions(const bool cancel_orders) const
@@ -77,30 +111,59 @@ net::awaitable<std::expected<std::vector<position_closed>, alpaca_api_error>>
     const std::string endpoint{
         "/positions?cancel_orders=" + (cancel_orders ? std::string{"true"} : std::string{"false"})};
     co_return co_await make_api_request<http::verb::delete_, std::vector<position_closed>>(
-        endpoint, http::status::multi_status);
+        endpoint, {.priority = request_priority::high}, http::status::multi_status);
 }
 
 net::awaitable<std::expected<std::vector<order>, alpaca_api_error>> alpaca_trade_client::get_all_orders() const
 {
-    co_return co_await make_api_request<http::verb::get, std::vector<order>>("/orders");
+    co_return co_await make_api_request<http::verb::get, std::vector<order>>(
+        "/orders", {.priority = request_priority::low});
 }
 
 net::awaitable<std::expected<std::vector<order_deleted>, alpaca_api_error>>
     alpaca_trade_client::delete_all_orders() const
 {
     co_return co_await make_api_request<http::verb::delete_, std::vector<order_deleted>>(
-        "/orders", http::status::multi_status);
+        "/orders", {.priority = request_priority::high}, http::status::multi_status);
 }
 
 net::awaitable<std::expected<order, alpaca_api_error>> alpaca_trade_client::create_order(const notional_order& no) const
 {
     const auto no_json = json::value_from(no);
 
-    http::fields extra_headers;
-    extra_headers.set(http::field::content_type, "application/json");
+    // Alpaca rejects a second order with the same client_order_id, so only then may a failed submission be resent
+    const request_options options{
+        .priority      = request_priority::high,
+        .is_retry_safe = !no.client_order_id.empty(),
+        .header_block  = _json_header_block};
+
+    auto result{co_await make_api_request<http::verb::post, order>("/orders", json::serialize(no_json), options)};
+    if (result || !is_duplicate_client_order_id(result.error()))
+    {
+        co_return result;
+    }
+
+    // A retried submission can be rejected because the first attempt reached Alpaca even though its response was
+    // lost. The order it placed is the one we asked for, so hand that back instead of failing the entry.
+    auto existing{co_await get_order_by_client_order_id(no.client_order_id)};
+    if (existing && existing->symbol == no.symbol && existing->side == no.side)
+    {
+        co_return existing;
+    }
+    co_return std::unexpected{alpaca_api_error{
+        alpaca_api_error::error_type::duplicate_client_order_id,
+        result.error().http_status(),
+        result.error().message()}};
+}
 
-    co_return co_await make_api_request<http::verb::post, order>(
-        "/orders", json::serialize(no_json), http::status::ok, extra_headers);
+net::awaitable<std::expected<order, alpaca_api_error>>
+    alpaca_trade_client::get_order_by_client_order_id(const std::string& client_order_id) const
+{
+    // only unreserved characters pass unencoded; a query-value charset would let '+' through, read back as a space
+    co_return co_await make_api_request<http::verb::get, order>(
+        "/orders:by_client_order_id?client_order_id="
+            + boost::urls::encode(client_order_id, boost::urls::unreserved_chars),
+        {.priority = request_priority::high});
 }
 
 //
@@ -108,7 +171,9 @@ net::awaitable<std::expected<order, alpaca_api_error>> alpaca_trade_client::crea
 
 alpaca_trade_client::alpaca_trade_client(net::io_context& ioc, config cfg)
     : _cfg{std::move(cfg)},
-      _rest_client{async_rest_client::async_rest_client::create(ioc)}
+      _rest_client{async_rest_client::async_rest_client::create(ioc, {.rate_limit = ALPACA_RATE_LIMIT})},
+      _auth_header_block{async_rest_client::format_header_block(create_auth_headers())},
+      _json_header_block{_auth_header_block + "Content-Type: application/json\r\n"}
 {
 }
 
@@ -123,53 +188,56 @@ http::fields alpaca_trade_client::create_auth_headers() const
 // No body version
 template<http::verb Verb, typename ReturnType>
 net::awaitable<std::expected<ReturnType, alpaca_api_error>> alpaca_trade_client::make_api_request(
-    const std::string&                 endpoint,
-    const http::status                 expected_status,
-    const std::optional<http::fields>& extra_headers) const
+    const std::string&                       endpoint,
+    const async_rest_client::request_options options,
+    const http::status                       expected_status,
+    const std::optional<http::fields>&       extra_headers) const
 {
     co_return co_await make_api_request_impl<Verb, ReturnType, false>(
-        endpoint, expected_status, std::nullopt, extra_headers);
+        endpoint, options, expected_status, std::nullopt, extra_headers);
 }
 
 // With body version
 template<http::verb Verb, typename ReturnType>
 net::awaitable<std::expected<ReturnType, alpaca_api_error>> alpaca_trade_client::make_api_request(
-    const std::string&                 endpoint,
-    const std::string&                 body,
-    http::status                       expected_status,
-    const std::optional<http::fields>& extra_headers) const
+    const std::string&                       endpoint,
+    const std::string&                       body,
+    const async_rest_client::request_options options,
+    http::status                             expected_status,
+    const std::optional<http::fields>&       extra_headers) const
 {
-    co_return co_await make_api_request_impl<Verb, ReturnType, true>(endpoint, expected_status, body, extra_headers);
+    co_return co_await make_api_request_impl<Verb, ReturnType, true>(
+        endpoint, options, expected_status, body, extra_headers);
 }
 
 // Shared implementation
 template<http::verb Verb, typename ReturnType, bool HasBody>
 net::awaitable<std::expected<ReturnType, alpaca_api_error>> alpaca_trade_client::make_api_request_impl(
     const std::string&                 endpoint,
+    async_rest_client::request_options options,
     http::status                       expected_status,
     const std::optional<std::string>&  body,
     const std::optional<http::fields>& extra_headers) const
 {
-    const std::string url{_cfg.base_url() + endpoint};
-    auto              headers = create_auth_headers();
+    const std::string   url{_cfg.base_url() + endpoint};
+    const http::fields& headers{extra_headers ? *extra_headers : async_rest_client::NO_HEADERS};
 
-    if (extra_headers.has_value())
+    // credentials go out as a block formatted once at construction instead of being copied for every request
+    if (options.header_block.empty())
     {
-        for (const auto& field : extra_headers.value())
-        {
-            headers.insert(field.name(), field.value());
-        }
+        options.header_block = _auth_header_block;
     }
 
     auto [ec, res] = co_await [&]()
     {
         if constexpr (HasBody)
         {
-            return _rest_client->request<Verb>(url, headers, body.value());
+            return _rest_client->request<Verb>(url, headers, body.value(), options);
         }
         else
         {
-            return _rest_client->request<Verb>(url, headers);
+            // request() keeps referring to its arguments after this lambda returns, so none may be a temporary
+            return _rest_client->request<Verb>(url, headers, async_rest_client::NO_BODY<http::empty_body>, options);
         }
     }();
 
@@ -178,6 +246,12 @@ net::awaitable<std::expected<ReturnType, alpaca_api_error>> alpaca_trade_client:
         co_return std::unexpected{alpaca_api_error{alpaca_api_error::error_type::network_error, 0, ec.message()}};
     }
 
+    if (res.result() == http::status::too_many_requests)
+    {
+        co_return std::unexpected{
+            alpaca_api_error{alpaca_api_error::error_type::rate_limited, static_cast<int>(res.result()), res.body()}};
+    }
+
     if (res.result() != expected_status)
     {
         co_return std::unexpected{
@@ -186,8 +260,11 @@ net::awaitable<std::expected<ReturnType, alpaca_api_error>> alpaca_trade_client:
 
     try
     {
-        auto             json_value = json::parse(res.body());
-        const ReturnType result     = json::value_to<ReturnType>(json_value);
+        // the document only lives for the decode below, so it is bump-allocated in one arena sized off the body and
+        // released at once; the decoders copy fields straight out of it
+        json::monotonic_resource arena{res.body().size()};
+        const auto               json_value = json::parse(res.body(), &arena);
+        const ReturnType         result     = json::value_to<ReturnType>(json_value);
         co_return result;
     }
     catch (const boost::system::system_error& e)
@@ -3,11 +3,70 @@
 #include "alpaca_trade_client/orders.hpp"
 #include "alpaca_trade_client/position.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace json = boost::json;
+
 //
-// account.hpp JSON serialization implementations
+// single-pass decoding helpers
 //
+// Decoders walk each object once and switch on a hash of the key instead of probing it with contains()/at() per
+// field. Strings are read as views into the parsed document and copied once into the model; enums are matched
+// without an intermediate std::string.
 
-namespace json = boost::json;
+namespace
+{
+
+constexpr std::uint64_t key_hash(const std::string_view key)
+{
+    std::uint64_t hash{14695981039346656037ULL};
+    for (const char c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void assign(std::string& out, const json::value& jv)
+{
+    const json::string& str = jv.as_string();
+    out.assign(str.data(), str.size());
+}
+
+void assign(std::optional<std::string>& out, const json::value& jv)
+{
+    if (jv.is_null())
+        return;
+
+    const json::string& str = jv.as_string();
+    out.emplace(str.data(), str.size());
+}
+
+template<typename T>
+void assign(std::optional<T>& out, const json::value& jv)
+{
+    if (!jv.is_null())
+        out = json::value_to<T>(jv);
+}
+
+// a required key that is absent used to surface as the out_of_range thrown by object::at()
+void require_fields(const std::size_t seen, const std::size_t expected, const char* type)
+{
+    if (seen != expected)
+        throw std::invalid_argument(std::string{type} + ": missing required field");
+}
+
+} // namespace
+
+//
+// account.hpp JSON serialization implementations
+//
 
 void tag_invoke(json::value_from_tag, json::value& jv, const account_status& status)
 {
@@ -21,80 +80,130 @@ account_status tag_invoke(json::value_to_tag<account_status>, const json::value&
 
 trade_account tag_invoke(json::value_to_tag<trade_account>, const json::value& jv)
 {
-    const auto&   obj = jv.as_object();
     trade_account account;
-
-    account.id       = json::value_to<std::string>(obj.at("id"));
-    account.status   = json::value_to<account_status>(obj.at("status"));
-    account.currency = json::value_to<std::string>(obj.at("currency"));
-
-    if (obj.contains("account_number") && !obj.at("account_number").is_null())
-        account.account_number = json::value_to<std::string>(obj.at("account_number"));
-    if (obj.contains("cash") && !obj.at("cash").is_null())
-        account.cash = json::value_to<std::string>(obj.at("cash"));
-    if (obj.contains("portfolio_value") && !obj.at("portfolio_value").is_null())
-        account.portfolio_value = json::value_to<std::string>(obj.at("portfolio_value"));
-    if (obj.contains("non_marginable_buying_power") && !obj.at("non_marginable_buying_power").is_null())
-        account.non_marginable_buying_power = json::value_to<std::string>(obj.at("non_marginable_buying_power"));
-    if (obj.contains("accrued_fees") && !obj.at("accrued_fees").is_null())
-        account.accrued_fees = json::value_to<std::string>(obj.at("accrued_fees"));
-    if (obj.contains("pending_transfer_in") && !obj.at("pending_transfer_in").is_null())
-        account.pending_transfer_in = json::value_to<std::string>(obj.at("pending_transfer_in"));
-    if (obj.contains("pending_transfer_out") && !obj.at("pending_transfer_out").is_null())
-        account.pending_transfer_out = json::value_to<std::string>(obj.at("pending_transfer_out"));
-    if (obj.contains("created_at") && !obj.at("created_at").is_null())
-        account.created_at = json::value_to<std::string>(obj.at("created_at"));
-    if (obj.contains("long_market_value") && !obj.at("long_market_value").is_null())
-        account.long_market_value = json::value_to<std::string>(obj.at("long_market_value"));
-    if (obj.contains("short_market_value") && !obj.at("short_market_value").is_null())
-        account.short_market_value = json::value_to<std::string>(obj.at("short_market_value"));
-    if (obj.contains("equity") && !obj.at("equity").is_null())
-        account.equity = json::value_to<std::string>(obj.at("equity"));
-    if (obj.contains("last_equity") && !obj.at("last_equity").is_null())
-        account.last_equity = json::value_to<std::string>(obj.at("last_equity"));
-    if (obj.contains("multiplier") && !obj.at("multiplier").is_null())
-        account.multiplier = json::value_to<std::string>(obj.at("multiplier"));
-    if (obj.contains("buying_power") && !obj.at("buying_power").is_null())
-        account.buying_power = json::value_to<std::string>(obj.at("buying_power"));
-    if (obj.contains("initial_margin") && !obj.at("initial_margin").is_null())
-        account.initial_margin = json::value_to<std::string>(obj.at("initial_margin"));
-    if (obj.contains("maintenance_margin") && !obj.at("maintenance_margin").is_null())
-        account.maintenance_margin = json::value_to<std::string>(obj.at("maintenance_margin"));
-    if (obj.contains("sma") && !obj.at("sma").is_null())
-        account.sma = json::value_to<std::string>(obj.at("sma"));
-    if (obj.contains("balance_asof") && !obj.at("balance_asof").is_null())
-        account.balance_asof = json::value_to<std::string>(obj.at("balance_asof"));
-    if (obj.contains("last_maintenance_margin") && !obj.at("last_maintenance_margin").is_null())
-        account.last_maintenance_margin = json::value_to<std::string>(obj.at("last_maintenance_margin"));
-    if (obj.contains("daytrading_buying_power") && !obj.at("daytrading_buying_power").is_null())
-        account.daytrading_buying_power = json::value_to<std::string>(obj.at("daytrading_buying_power"));
-    if (obj.contains("regt_buying_power") && !obj.at("regt_buying_power").is_null())
-        account.regt_buying_power = json::value_to<std::string>(obj.at("regt_buying_power"));
-    if (obj.contains("options_buying_power") && !obj.at("options_buying_power").is_null())
-        account.options_buying_power = json::value_to<std::string>(obj.at("options_buying_power"));
-    if (obj.contains("intraday_adjustments") && !obj.at("intraday_adjustments").is_null())
-        account.intraday_adjustments = json::value_to<std::string>(obj.at("intraday_adjustments"));
-    if (obj.contains("pending_reg_taf_fees") && !obj.at("pending_reg_taf_fees").is_null())
-        account.pending_reg_taf_fees = json::value_to<std::string>(obj.at("pending_reg_taf_fees"));
-    if (obj.contains("daytrade_count") && !obj.at("daytrade_count").is_null())
-        account.daytrade_count = json::value_to<int>(obj.at("daytrade_count"));
-    if (obj.contains("options_approved_level") && !obj.at("options_approved_level").is_null())
-        account.options_approved_level = json::value_to<int>(obj.at("options_approved_level"));
-    if (obj.contains("options_trading_level") && !obj.at("options_trading_level").is_null())
-        account.options_trading_level = json::value_to<int>(obj.at("options_trading_level"));
-    if (obj.contains("pattern_day_trader") && !obj.at("pattern_day_trader").is_null())
-        account.pattern_day_trader = json::value_to<bool>(obj.at("pattern_day_trader"));
-    if (obj.contains("trade_suspended_by_user") && !obj.at("trade_suspended_by_user").is_null())
-        account.trade_suspended_by_user = json::value_to<bool>(obj.at("trade_suspended_by_user"));
-    if (obj.contains("trading_blocked") && !obj.at("trading_blocked").is_null())
-        account.trading_blocked = json::value_to<bool>(obj.at("trading_blocked"));
-    if (obj.contains("transfers_blocked") && !obj.at("transfers_blocked").is_null())
-        account.transfers_blocked = json::value_to<bool>(obj.at("transfers_blocked"));
-    if (obj.contains("account_blocked") && !obj.at("account_blocked").is_null())
-        account.account_blocked = json::value_to<bool>(obj.at("account_blocked"));
-    if (obj.contains("shorting_enabled") && !obj.at("shorting_enabled").is_null())
-        account.shorting_enabled = json::value_to<bool>(obj.at("shorting_enabled"));
-
+    std::size_t   required{0};
+
+    for (const auto& [key, value] : jv.as_object())
+    {
+        switch (key_hash(key))
+        {
+            case key_hash("id"):
+                assign(account.id, value);
+                ++required;
+                break;
+            case key_hash("status"):
+                account.status = json::value_to<account_status>(value);
+                ++required;
+                break;
+            case key_hash("currency"):
+                assign(account.currency, value);
+                ++required;
+                break;
+            case key_hash("account_number"):
+                assign(account.account_number, value);
+                break;
+            case key_hash("cash"):
+                assign(account.cash, value);
+                break;
+            case key_hash("portfolio_value"):
+                assign(account.portfolio_value, value);
+                break;
+            case key_hash("non_marginable_buying_power"):
+                assign(account.non_marginable_buying_power, value);
+                break;
+            case key_hash("accrued_fees"):
+                assign(account.accrued_fees, value);
+                break;
+            case key_hash("pending_transfer_in"):
+                assign(account.pending_transfer_in, value);
+                break;
+            case key_hash("pending_transfer_out"):
+                assign(account.pending_transfer_out, value);
+                break;
+            case key_hash("created_at"):
+                assign(account.created_at, value);
+                break;
+            case key_hash("long_market_value"):
+                assign(account.long_market_value, value);
+                break;
+            case key_hash("short_market_value"):
+                assign(account.short_market_value, value);
+                break;
+            case key_hash("equity"):
+                assign(account.equity, value);
+                break;
+            case key_hash("last_equity"):
+                assign(account.last_equity, value);
+                break;
+            case key_hash("multiplier"):
+                assign(account.multiplier, value);
+                break;
+            case key_hash("buying_power"):
+                assign(account.buying_power, value);
+                break;
+            case key_hash("initial_margin"):
+                assign(account.initial_margin, value);
+                break;
+            case key_hash("maintenance_margin"):
+                assign(account.maintenance_margin, value);
+                break;
+            case key_hash("sma"):
+                assign(account.sma, value);
+                break;
+            case key_hash("balance_asof"):
+                assign(account.balance_asof, value);
+                break;
+            case key_hash("last_maintenance_margin"):
+                assign(account.last_maintenance_margin, value);
+                break;
+            case key_hash("daytrading_buying_power"):
+                assign(account.daytrading_buying_power, value);
+                break;
+            case key_hash("regt_buying_power"):
+                assign(account.regt_buying_power, value);
+                break;
+            case key_hash("options_buying_power"):
+                assign(account.options_buying_power, value);
+                break;
+            case key_hash("intraday_adjustments"):
+                assign(account.intraday_adjustments, value);
+                break;
+            case key_hash("pending_reg_taf_fees"):
+                assign(account.pending_reg_taf_fees, value);
+                break;
+            case key_hash("daytrade_count"):
+                assign(account.daytrade_count, value);
+                break;
+            case key_hash("options_approved_level"):
+                assign(account.options_approved_level, value);
+                break;
+            case key_hash("options_trading_level"):
+                assign(account.options_trading_level, value);
+                break;
+            case key_hash("pattern_day_trader"):
+                assign(account.pattern_day_trader, value);
+                break;
+            case key_hash("trade_suspended_by_user"):
+                assign(account.trade_suspended_by_user, value);
+                break;
+            case key_hash("trading_blocked"):
+                assign(account.trading_blocked, value);
+                break;
+            case key_hash("transfers_blocked"):
+                assign(account.transfers_blocked, value);
+                break;
+            case key_hash("account_blocked"):
+                assign(account.account_blocked, value);
+                break;
+            case key_hash("shorting_enabled"):
+                assign(account.shorting_enabled, value);
+                break;
+            default:
+                break;
+        }
+    }
+
+    require_fields(required, 3, "trade_account");
     return account;
 }
 
@@ -211,30 +320,90 @@ position_side tag_invoke(json::value_to_tag<position_side>, const json::value& j
 
 position tag_invoke(json::value_to_tag<position>, const json::value& jv)
 {
-    const auto& obj = jv.as_object();
     position    pos;
-
-    pos.asset_id                 = json::value_to<std::string>(obj.at("asset_id"));
-    pos.symbol                   = json::value_to<std::string>(obj.at("symbol"));
-    pos.exchange                 = json::value_to<asset_exchange>(obj.at("exchange"));
-    pos.asset_class_type         = json::value_to<asset_class>(obj.at("asset_class"));
-    pos.avg_entry_price          = json::value_to<std::string>(obj.at("avg_entry_price"));
-    pos.qty                      = json::value_to<std::string>(obj.at("qty"));
-    pos.side                     = json::value_to<position_side>(obj.at("side"));
-    pos.market_value             = json::value_to<std::string>(obj.at("market_value"));
-    pos.cost_basis               = json::value_to<std::string>(obj.at("cost_basis"));
-    pos.unrealized_pl            = json::value_to<std::string>(obj.at("unrealized_pl"));
-    pos.unrealized_plpc          = json::value_to<std::string>(obj.at("unrealized_plpc"));
-    pos.unrealized_intraday_pl   = json::value_to<std::string>(obj.at("unrealized_intraday_pl"));
-    pos.unrealized_intraday_plpc = json::value_to<std::string>(obj.at("unrealized_intraday_plpc"));
-    pos.current_price            = json::value_to<std::string>(obj.at("current_price"));
-    pos.lastday_price            = json::value_to<std::string>(obj.at("lastday_price"));
-    pos.change_today             = json::value_to<std::string>(obj.at("change_today"));
-    pos.asset_marginable         = json::value_to<bool>(obj.at("asset_marginable"));
-
-    if (obj.contains("qty_available") && !obj.at("qty_available").is_null())
-        pos.qty_available = json::value_to<std::string>(obj.at("qty_available"));
-
+    std::size_t required{0};
+
+    for (const auto& [key, value] : jv.as_object())
+    {
+        switch (key_hash(key))
+        {
+            case key_hash("asset_id"):
+                assign(pos.asset_id, value);
+                ++required;
+                break;
+            case key_hash("symbol"):
+                assign(pos.symbol, value);
+                ++required;
+                break;
+            case key_hash("exchange"):
+                pos.exchange = json::value_to<asset_exchange>(value);
+                ++required;
+                break;
+            case key_hash("asset_class"):
+                pos.asset_class_type = json::value_to<asset_class>(value);
+                ++required;
+                break;
+            case key_hash("avg_entry_price"):
+                assign(pos.avg_entry_price, value);
+                ++required;
+                break;
+            case key_hash("qty"):
+                assign(pos.qty, value);
+                ++required;
+                break;
+            case key_hash("side"):
+                pos.side = json::value_to<position_side>(value);
+                ++required;
+                break;
+            case key_hash("market_value"):
+                assign(pos.market_value, value);
+                ++required;
+                break;
+            case key_hash("cost_basis"):
+                assign(pos.cost_basis, value);
+                ++required;
+                break;
+            case key_hash("unrealized_pl"):
+                assign(pos.unrealized_pl, value);
+                ++required;
+                break;
+            case key_hash("unrealized_plpc"):
+                assign(pos.unrealized_plpc, value);
+                ++required;
+                break;
+            case key_hash("unrealized_intraday_pl"):
+                assign(pos.unrealized_intraday_pl, value);
+                ++required;
+                break;
+            case key_hash("unrealized_intraday_plpc"):
+                assign(pos.unrealized_intraday_plpc, value);
+                ++required;
+                break;
+            case key_hash("current_price"):
+                assign(pos.current_price, value);
+                ++required;
+                break;
+            case key_hash("lastday_price"):
+                assign(pos.lastday_price, value);
+                ++required;
+                break;
+            case key_hash("change_today"):
+                assign(pos.change_today, value);
+                ++required;
+                break;
+            case key_hash("asset_marginable"):
+                pos.asset_marginable = value.as_bool();
+                ++required;
+                break;
+            case key_hash("qty_available"):
+                assign(pos.qty_available, value);
+                break;
+            default:
+                break;
+        }
+    }
+
+    require_fields(required, 17, "position");
     return pos;
 }
 
@@ -331,62 +500,135 @@ position_intent tag_invoke(json::value_to_tag<position_intent>, const json::valu
 
 order tag_invoke(json::value_to_tag<order>, const json::value& jv)
 {
-    const auto& obj = jv.as_object();
     order       o;
-
-    o.id                 = json::value_to<std::string>(obj.at("id"));
-    o.client_order_id    = json::value_to<std::string>(obj.at("client_order_id"));
-    o.created_at         = json::value_to<std::string>(obj.at("created_at"));
-    o.asset_id           = json::value_to<std::string>(obj.at("asset_id"));
-    o.symbol             = json::value_to<std::string>(obj.at("symbol"));
-    o.asset_class_type   = json::value_to<asset_class>(obj.at("asset_class"));
-    o.filled_qty         = json::value_to<std::string>(obj.at("filled_qty"));
-    o.order_class_type   = json::value_to<order_class>(obj.at("order_class"));
-    o.type               = json::value_to<order_type>(obj.at("order_type"));
-    o.side               = json::value_to<order_side>(obj.at("side"));
-    o.time_in_force_type = json::value_to<time_in_force>(obj.at("time_in_force"));
-    o.status             = json::value_to<order_status>(obj.at("status"));
-    o.extended_hours     = json::value_to<bool>(obj.at("extended_hours"));
-
-    if (obj.contains("updated_at") && !obj.at("updated_at").is_null())
-        o.updated_at = json::value_to<std::string>(obj.at("updated_at"));
-    if (obj.contains("submitted_at") && !obj.at("submitted_at").is_null())
-        o.submitted_at = json::value_to<std::string>(obj.at("submitted_at"));
-    if (obj.contains("filled_at") && !obj.at("filled_at").is_null())
-        o.filled_at = json::value_to<std::string>(obj.at("filled_at"));
-    if (obj.contains("expired_at") && !obj.at("expired_at").is_null())
-        o.expired_at = json::value_to<std::string>(obj.at("expired_at"));
-    if (obj.contains("canceled_at") && !obj.at("canceled_at").is_null())
-        o.canceled_at = json::value_to<std::string>(obj.at("canceled_at"));
-    if (obj.contains("failed_at") && !obj.at("failed_at").is_null())
-        o.failed_at = json::value_to<std::string>(obj.at("failed_at"));
-    if (obj.contains("replaced_at") && !obj.at("replaced_at").is_null())
-        o.replaced_at = json::value_to<std::string>(obj.at("replaced_at"));
-    if (obj.contains("replaced_by") && !obj.at("replaced_by").is_null())
-        o.replaced_by = json::value_to<std::string>(obj.at("replaced_by"));
-    if (obj.contains("replaces") && !obj.at("replaces").is_null())
-        o.replaces = json::value_to<std::string>(obj.at("replaces"));
-    if (obj.contains("notional") && !obj.at("notional").is_null())
-        o.notional = json::value_to<std::string>(obj.at("notional"));
-    if (obj.contains("qty") && !obj.at("qty").is_null())
-        o.qty = json::value_to<std::string>(obj.at("qty"));
-    if (obj.contains("filled_avg_price") && !obj.at("filled_avg_price").is_null())
-        o.filled_avg_price = json::value_to<std::string>(obj.at("filled_avg_price"));
-    if (obj.contains("limit_price") && !obj.at("limit_price").is_null())
-        o.limit_price = json::value_to<std::string>(obj.at("limit_price"));
-    if (obj.contains("stop_price") && !obj.at("stop_price").is_null())
-        o.stop_price = json::value_to<std::string>(obj.at("stop_price"));
-    if (obj.contains("trail_percent") && !obj.at("trail_percent").is_null())
-        o.trail_percent = json::value_to<std::string>(obj.at("trail_percent"));
-    if (obj.contains("trail_price") && !obj.at("trail_price").is_null())
-        o.trail_price = json::value_to<std::string>(obj.at("trail_price"));
-    if (obj.contains("hwm") && !obj.at("hwm").is_null())
-        o.hwm = json::value_to<std::string>(obj.at("hwm"));
-    if (obj.contains("position_intent") && !obj.at("position_intent").is_null())
-        o.position_intent_type = json::value_to<position_intent>(obj.at("position_intent"));
-    if (obj.contains("legs") && !obj.at("legs").is_null())
-        o.legs = json::value_to<std::vector<order>>(obj.at("legs"));
-
+    std::size_t required{0};
+
+    for (const auto& [key, value] : jv.as_object())
+    {
+        switch (key_hash(key))
+        {
+            case key_hash("id"):
+                assign(o.id, value);
+                ++required;
+                break;
+            case key_hash("client_order_id"):
+                assign(o.client_order_id, value);
+                ++required;
+                break;
+            case key_hash("created_at"):
+                assign(o.created_at, value);
+                ++required;
+                break;
+            case key_hash("asset_id"):
+                assign(o.asset_id, value);
+                ++required;
+                break;
+            case key_hash("symbol"):
+                assign(o.symbol, value);
+                ++required;
+                break;
+            case key_hash("asset_class"):
+                o.asset_class_type = json::value_to<asset_class>(value);
+                ++required;
+                break;
+            case key_hash("filled_qty"):
+                assign(o.filled_qty, value);
+                ++required;
+                break;
+            case key_hash("order_class"):
+                o.order_class_type = json::value_to<order_class>(value);
+                ++required;
+                break;
+            case key_hash("order_type"):
+                o.type = json::value_to<order_type>(value);
+                ++required;
+                break;
+            case key_hash("side"):
+                o.side = json::value_to<order_side>(value);
+                ++required;
+                break;
+            case key_hash("time_in_force"):
+                o.time_in_force_type = json::value_to<time_in_force>(value);
+                ++required;
+                break;
+            case key_hash("status"):
+                o.status = json::value_to<order_status>(value);
+                ++required;
+                break;
+            case key_hash("extended_hours"):
+                o.extended_hours = value.as_bool();
+                ++required;
+                break;
+            case key_hash("updated_at"):
+                assign(o.updated_at, value);
+                break;
+            case key_hash("submitted_at"):
+                assign(o.submitted_at, value);
+                break;
+            case key_hash("filled_at"):
+                assign(o.filled_at, value);
+                break;
+            case key_hash("expired_at"):
+                assign(o.expired_at, value);
+                break;
+            case key_hash("canceled_at"):
+                assign(o.canceled_at, value);
+                break;
+            case key_hash("failed_at"):
+                assign(o.failed_at, value);
+                break;
+            case key_hash("replaced_at"):
+                assign(o.replaced_at, value);
+                break;
+            case key_hash("replaced_by"):
+                assign(o.replaced_by, value);
+                break;
+            case key_hash("replaces"):
+                assign(o.replaces, value);
+                break;
+            case key_hash("notional"):
+                assign(o.notional, value);
+                break;
+            case key_hash("qty"):
+                assign(o.qty, value);
+                break;
+            case key_hash("filled_avg_price"):
+                assign(o.filled_avg_price, value);
+                break;
+            case key_hash("limit_price"):
+                assign(o.limit_price, value);
+                break;
+            case key_hash("stop_price"):
+                assign(o.stop_price, value);
+                break;
+            case key_hash("trail_percent"):
+                assign(o.trail_percent, value);
+                break;
+            case key_hash("trail_price"):
+                assign(o.trail_price, value);
+                break;
+            case key_hash("hwm"):
+                assign(o.hwm, value);
+                break;
+            case key_hash("position_intent"):
+                assign(o.position_intent_type, value);
+                break;
+            case key_hash("legs"):
+                if (!value.is_null())
+                {
+                    const auto& legs = value.as_array();
+                    o.legs.emplace();
+                    o.legs->reserve(legs.size());
+                    for (const auto& leg : legs)
+                        o.legs->push_back(json::value_to<order>(leg));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    require_fields(required, 13, "order");
     return o;
 }
 
@@ -222,3 +222,57 @@ TEST_F(AlpacaTradeClientIntegrationTest, InvalidCredentials)
     _ioc.run();
     EXPECT_NO_THROW(future.get());
 }
+
+// A resubmitted client_order_id is answered with the order the first submission placed
+TEST_F(AlpacaTradeClientIntegrationTest, ResubmittedClientOrderIdReturnsExistingOrder)
+{
+    auto future = net::co_spawn(
+        _ioc,
+        [this]() -> net::awaitable<void>
+        {
+            const std::string client_order_id{
+                "resubmit-" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count())};
+            const notional_order test_order{
+                .symbol          = "PLTR",
+                .notional        = "1",
+                .side            = order_side::BUY,
+                .extended_hours  = false,
+                .client_order_id = client_order_id};
+
+            auto first_result = co_await _client->create_order(test_order);
+            EXPECT_TRUE(first_result.has_value()) << "Failed to create order: " << first_result.error().message();
+
+            if (!first_result.has_value())
+                co_return;
+
+            auto second_result = co_await _client->create_order(test_order);
+            EXPECT_TRUE(second_result.has_value())
+                << "Resubmission should return the existing order: " << second_result.error().message();
+
+            if (second_result.has_value())
+            {
+                EXPECT_EQ(second_result->id, first_result->id) << "Resubmission should not place a second order";
+                EXPECT_EQ(second_result->client_order_id, client_order_id);
+            }
+
+            auto mismatched_order   = test_order;
+            mismatched_order.symbol = "AAPL";
+            auto mismatched_result  = co_await _client->create_order(mismatched_order);
+            EXPECT_FALSE(mismatched_result.has_value()) << "A reused client_order_id for another order should fail";
+
+            if (!mismatched_result.has_value())
+            {
+                EXPECT_EQ(mismatched_result.error().type(), alpaca_api_error::error_type::duplicate_client_order_id);
+            }
+
+            auto cancel_result = co_await _client->delete_all_orders();
+            EXPECT_TRUE(cancel_result.has_value()) << "Failed to cancel orders: " << cancel_result.error().message();
+
+            auto close_result = co_await _client->close_all_positions(true);
+            EXPECT_TRUE(close_result.has_value()) << "Failed to close positions: " << close_result.error().message();
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
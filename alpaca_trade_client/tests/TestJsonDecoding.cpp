@@ -0,0 +1,137 @@
+#include "alpaca_trade_client/account.hpp"
+#include "alpaca_trade_client/orders.hpp"
+#include "alpaca_trade_client/position.hpp"
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace json = boost::json;
+
+namespace
+{
+
+constexpr auto ORDER_JSON = R"({
+    "id": "61e69015-8549-4bfd-b9c3-01e75843f47d",
+    "client_order_id": "eb9e2aaa-f71a-4f51-b5b4-52a6c565dad4",
+    "created_at": "2025-06-19T14:30:00.000Z",
+    "updated_at": "2025-06-19T14:30:01.000Z",
+    "submitted_at": "2025-06-19T14:30:00.100Z",
+    "filled_at": null,
+    "expired_at": null,
+    "canceled_at": null,
+    "failed_at": null,
+    "replaced_at": null,
+    "replaced_by": null,
+    "replaces": null,
+    "asset_id": "b0b6dd9d-8b9b-48a9-ba46-b9d54906e415",
+    "symbol": "AAPL",
+    "asset_class": "us_equity",
+    "notional": "500",
+    "qty": null,
+    "filled_qty": "0",
+    "filled_avg_price": null,
+    "order_class": "bracket",
+    "order_type": "market",
+    "type": "market",
+    "side": "buy",
+    "time_in_force": "day",
+    "limit_price": null,
+    "stop_price": null,
+    "status": "accepted",
+    "extended_hours": false,
+    "legs": [{
+        "id": "0f7d1ba4-1a04-4c2b-9b3c-3a2a3e5d9f10",
+        "client_order_id": "3c0b0d5e-2d4c-4d1d-9e8b-1f2e3d4c5b6a",
+        "created_at": "2025-06-19T14:30:00.000Z",
+        "asset_id": "b0b6dd9d-8b9b-48a9-ba46-b9d54906e415",
+        "symbol": "AAPL",
+        "asset_class": "us_equity",
+        "filled_qty": "0",
+        "order_class": "bracket",
+        "order_type": "limit",
+        "side": "sell",
+        "time_in_force": "day",
+        "limit_price": "210.5",
+        "status": "new",
+        "extended_hours": false,
+        "legs": null
+    }],
+    "trail_percent": null,
+    "trail_price": null,
+    "hwm": null,
+    "position_intent": "buy_to_open",
+    "subtag": null,
+    "source": null
+})";
+
+} // namespace
+
+TEST(JsonDecodingTest, DecodesOrderWithLegsInOnePass)
+{
+    const auto o = json::value_to<order>(json::parse(ORDER_JSON));
+
+    EXPECT_EQ(o.id, "61e69015-8549-4bfd-b9c3-01e75843f47d");
+    EXPECT_EQ(o.symbol, "AAPL");
+    EXPECT_EQ(o.notional, "500");
+    EXPECT_FALSE(o.qty.has_value());
+    EXPECT_FALSE(o.filled_at.has_value());
+    EXPECT_EQ(o.order_class_type, order_class::BRACKET);
+    EXPECT_EQ(o.type, order_type::MARKET);
+    EXPECT_EQ(o.side, order_side::BUY);
+    EXPECT_EQ(o.position_intent_type, position_intent::BUY_TO_OPEN);
+
+    ASSERT_TRUE(o.legs.has_value());
+    ASSERT_EQ(o.legs->size(), 1u);
+    EXPECT_EQ(o.legs->front().type, order_type::LIMIT);
+    EXPECT_EQ(o.legs->front().limit_price, "210.5");
+    EXPECT_FALSE(o.legs->front().legs.has_value());
+}
+
+TEST(JsonDecodingTest, OrderRoundTripsThroughValueFrom)
+{
+    const auto o       = json::value_to<order>(json::parse(ORDER_JSON));
+    const auto decoded = json::value_to<order>(json::value_from(o));
+
+    EXPECT_EQ(decoded.client_order_id, o.client_order_id);
+    EXPECT_EQ(decoded.updated_at, o.updated_at);
+    EXPECT_EQ(decoded.status, o.status);
+    ASSERT_TRUE(decoded.legs.has_value());
+    EXPECT_EQ(decoded.legs->front().id, o.legs->front().id);
+}
+
+TEST(JsonDecodingTest, MissingRequiredFieldThrows)
+{
+    auto jv = json::parse(ORDER_JSON);
+    jv.as_object().erase("symbol");
+
+    EXPECT_THROW(json::value_to<order>(jv), std::invalid_argument);
+}
+
+TEST(JsonDecodingTest, DecodesPositionAndAccount)
+{
+    const auto pos = json::value_to<position>(json::parse(R"({
+        "asset_id": "b0b6dd9d-8b9b-48a9-ba46-b9d54906e415", "symbol": "AAPL", "exchange": "NASDAQ",
+        "asset_class": "us_equity", "avg_entry_price": "200.1", "qty": "5", "qty_available": null, "side": "long",
+        "market_value": "1010", "cost_basis": "1000.5", "unrealized_pl": "9.5", "unrealized_plpc": "0.0095",
+        "unrealized_intraday_pl": "1", "unrealized_intraday_plpc": "0.001", "current_price": "202",
+        "lastday_price": "201", "change_today": "0.005", "asset_marginable": true})"));
+
+    EXPECT_EQ(pos.exchange, asset_exchange::NASDAQ);
+    EXPECT_EQ(pos.side, position_side::LONG);
+    EXPECT_EQ(pos.cost_basis, "1000.5");
+    EXPECT_FALSE(pos.qty_available.has_value());
+    EXPECT_TRUE(pos.asset_marginable);
+
+    const auto account = json::value_to<trade_account>(json::parse(R"({
+        "id": "904837e3-3b76-47ec-b432-046db621571b", "status": "ACTIVE", "currency": "USD",
+        "buying_power": "4000.32", "daytrade_count": 2, "pattern_day_trader": false, "sma": null})"));
+
+    EXPECT_EQ(account.status, account_status::ACTIVE);
+    EXPECT_EQ(account.buying_power, "4000.32");
+    EXPECT_EQ(account.daytrade_count, 2);
+    EXPECT_EQ(account.pattern_day_trader, false);
+    EXPECT_FALSE(account.sma.has_value());
+}
@@ -2,16 +2,30 @@
 
 #include "base_task.hpp"
 #include "concepts.hpp"
+#include "connection_pool.hpp"
+#include "rate_limiter.hpp"
+#include "request_options.hpp"
+#include "request_priority.hpp"
+#include "retry_policy.hpp"
+#include "tls_session_cache.hpp"
 #include "typed_task.hpp"
 #include "utils.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/cancel_at.hpp>
 #include <boost/asio/ssl.hpp>
 #include <boost/beast.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/url.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <deque>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace async_rest_client
 {
@@ -23,59 +37,201 @@ namespace net       = boost::asio;
 namespace ssl       = boost::asio::ssl;
 using tcp           = boost::asio::ip::tcp;
 
+struct client_options
+{
+    /**
+     * Keep-alive connections the client may hold open to one origin; requests to an origin beyond this wait in the
+     * queue for a connection to become free.
+     */
+    std::size_t max_connections_per_origin{4};
+
+    /**
+     * Idle connections are not reused after this long. Keep it below the server's keep-alive timeout so the client
+     * retires a connection before the server closes it under a request.
+     */
+    std::chrono::seconds idle_timeout{50};
+
+    /**
+     * How often origins registered with preconnect() are checked: stale or expired idle connections are dropped and
+     * replaced, so a warm connection is ready when the next request arrives.
+     */
+    std::chrono::seconds keepalive_interval{10};
+
+    /**
+     * Requests written back-to-back on one connection before their responses are read (HTTP/1.1 pipelining); 1 sends
+     * them one at a time. A batch holds queued idempotent requests to the same origin, plus at most one other request
+     * at its end. An origin that closes a pipelined connection gets one request at a time from then on.
+     */
+    std::size_t pipeline_depth{1};
+
+    /**
+     * Deadline of requests that set no request_options::timeout, counted from submission.
+     */
+    std::chrono::milliseconds request_timeout{10000};
+
+    retry_policy retry{};
+
+    /**
+     * Client-side request budget. Queued requests over it are delayed, never dropped; a 429 response blocks the
+     * queue for its Retry-After and is retried like a transport failure.
+     */
+    rate_limit_options rate_limit{};
+};
+
+/**
+ * Defaults of async_rest_client::request()'s headers and body. It refers to its arguments until the request completes,
+ * so they must not be temporaries where the request may be awaited after the statement that started it.
+ */
+inline const http::fields NO_HEADERS{};
+
+template<typename Body>
+inline const typename Body::value_type NO_BODY{};
+
+/**
+ * Queues requests by priority and dispatches them concurrently over a pool of keep-alive connections per origin.
+ *
+ * Whenever a connection to a request's origin is free (or may still be opened), the highest-priority queued request
+ * for that origin is sent on it; requests of equal priority go out in submission order. With pipeline_depth above 1,
+ * further queued requests for the same origin are pipelined behind it. All work runs on the io_context, so the
+ * client must only be used from its thread.
+ */
 class async_rest_client : public std::enable_shared_from_this<async_rest_client>
 {
 public:
-    static std::shared_ptr<async_rest_client> create(net::io_context& ioc);
+    static std::shared_ptr<async_rest_client> create(net::io_context& ioc, client_options options = {});
 
     ~async_rest_client();
 
+    /**
+     * Opens a connection to the url's origin ahead of the first request and parks it in the pool. Does nothing if a
+     * connection to that origin is already idle, or if the origin has no free slot.
+     */
     net::awaitable<boost::system::error_code> connect(std::string_view url_sv);
 
+    /**
+     * Keeps idle connections to the url's origin open from now on: opens them now and, every
+     * keepalive_interval, replaces the ones the server closed or that reached idle_timeout. Use at startup for the
+     * origins latency-critical requests go to, so they never wait for DNS, TCP and TLS handshakes.
+     *
+     * The keepalive timer keeps the io_context busy for as long as the client exists.
+     *
+     * @param connections idle connections to maintain, at most max_connections_per_origin
+     * @return error of the first connection attempt that failed; the origin stays registered regardless
+     */
+    net::awaitable<boost::system::error_code> preconnect(std::string_view url_sv, std::size_t connections = 1);
+
+    /**
+     * @return TLS session resumption statistics of all connections made so far
+     */
+    [[nodiscard]]
+    const tls_session_cache& tls_sessions() const;
+
+    /**
+     * Sends a request and waits for its response, retrying transport failures as client_options::retry allows.
+     *
+     * Completes with timed_out if no response arrived by the deadline, and with operation_aborted if the awaiting
+     * coroutine is cancelled through its cancellation slot; either way the request stops holding a connection by its
+     * deadline at the latest.
+     *
+     * url, headers and body are not copied: every attempt serializes straight from them, so they must stay alive
+     * until the request completes. Arguments of the co_await expression awaiting the request do.
+     */
     template<
         http::verb Verb,
         typename RequestBody  = typename default_body_types<Verb>::request_body,
         typename ResponseBody = typename default_body_types<Verb>::response_body>
         requires ValidVerbBodyCombination<Verb, RequestBody, ResponseBody>
-    net::awaitable<std::tuple<boost::system::error_code, http::response<ResponseBody>>>
-        request(std::string_view url, http::fields headers = {}, typename RequestBody::value_type body = {});
+    net::awaitable<std::tuple<boost::system::error_code, http::response<ResponseBody>>> request(
+        std::string_view                        url,
+        const http::fields&                     headers = NO_HEADERS,
+        const typename RequestBody::value_type& body    = NO_BODY<RequestBody>,
+        request_options                         options = {});
 
 private:
-    enum class connection_state
+    //
+    // Private Ctor
+
+    async_rest_client(net::io_context& ioc, client_options options);
+
+    void enqueue_task(std::unique_ptr<base_task>&& task, request_priority priority);
+
+    /**
+     * Starts every queued task that can get a connection, highest priority first.
+     */
+    void dispatch();
+
+    net::awaitable<void> run_task(
+        std::shared_ptr<async_rest_client> self, std::unique_ptr<base_task> task, std::shared_ptr<connection> conn);
+
+    struct queued_task
     {
-        NOT_CONNECTED,
-        CONNECTING,
-        CONNECTED
+        std::unique_ptr<base_task> task{};
+        std::size_t                priority{};
     };
 
-    //
-    // Private Ctor
+    /**
+     * Moves the tasks that may be pipelined behind batch's first one out of the queues, scanning from the given
+     * queue position on.
+     */
+    void collect_pipeline(std::vector<queued_task>& batch, std::size_t priority, std::size_t index);
+
+    net::awaitable<void> run_pipeline(
+        std::shared_ptr<async_rest_client> self, std::vector<queued_task> batch, std::shared_ptr<connection> conn);
 
-    explicit async_rest_client(net::io_context& ioc);
+    /**
+     * Handles batch's tasks from completed on, which got no response: idempotent ones go back to the front of their
+     * queue, the others fail with ec. If nothing completed, the first one fails too, so a broken origin cannot keep
+     * a batch queued forever.
+     */
+    void requeue_unanswered(std::vector<queued_task>& batch, std::size_t completed, boost::system::error_code ec);
 
-    net::awaitable<void> process_queue();
-    void                 enqueue_task(std::unique_ptr<base_task>&& task);
-    net::awaitable<void> graceful_shutdown();
+    /**
+     * Runs dispatch() at when, for tasks held back by the rate limiter.
+     */
+    void schedule_dispatch(rate_limiter::clock::time_point when);
+
+    /**
+     * Opens connections to url's origin until it has target idle ones or reaches its limit.
+     */
+    net::awaitable<boost::system::error_code> top_up(boost::url url, std::size_t target);
+
+    /**
+     * Runs every keepalive_interval until the client is destroyed.
+     */
+    net::awaitable<void> maintain_warm_connections(std::weak_ptr<async_rest_client> weak_self);
 
     //
     // Task helpers
 
     template<http::verb Verb, typename RequestBody, typename ResponseBody>
-    std::unique_ptr<base_task>
-        make_task(std::string_view url, http::fields headers = {}, typename RequestBody::value_type body = {});
+    std::unique_ptr<base_task> make_task(
+        std::string_view                        url,
+        const http::fields&                     headers,
+        std::string_view                        header_block,
+        const typename RequestBody::value_type& body,
+        std::chrono::steady_clock::time_point   deadline);
 
-    std::deque<std::unique_ptr<base_task>> _tasks;
-    bool                                   _is_processing{false};
+    std::array<std::deque<std::unique_ptr<base_task>>, REQUEST_PRIORITY_COUNT> _tasks{};
 
-    net::io_context&                                      _ioc;
-    ssl::context                                          _ssl_ctx;
-    std::unique_ptr<beast::tcp_stream>                    _tcp_stream;
-    std::unique_ptr<beast::ssl_stream<beast::tcp_stream>> _ssl_stream;
-    std::unique_ptr<beast::flat_buffer>                   _buffer;
+    struct warm_origin
+    {
+        boost::url  url{};
+        std::size_t connections{};
+    };
 
-    boost::url       _current_origin{};
-    connection_state _connection_state{connection_state::NOT_CONNECTED};
-    bool             _is_tls{false};
+    net::io_context&  _ioc;
+    client_options    _options;
+    ssl::context      _ssl_ctx;
+    tls_session_cache _session_cache;
+    connection_pool   _pool;
+    rate_limiter      _rate_limiter;
+
+    net::steady_timer                              _dispatch_timer;
+    std::optional<rate_limiter::clock::time_point> _dispatch_wakeup{};
+
+    std::unordered_map<std::string, warm_origin> _warm_origins{};
+    net::steady_timer                            _keepalive_timer;
+    bool                                         _is_maintaining{false};
 };
 
 //
@@ -83,25 +239,70 @@ private:
 
 template<http::verb Verb, typename RequestBody, typename ResponseBody>
     requires ValidVerbBodyCombination<Verb, RequestBody, ResponseBody>
-net::awaitable<std::tuple<boost::system::error_code, http::response<ResponseBody>>>
-    async_rest_client::request(std::string_view url, http::fields headers, typename RequestBody::value_type body)
+net::awaitable<std::tuple<boost::system::error_code, http::response<ResponseBody>>> async_rest_client::request(
+    std::string_view                        url,
+    const http::fields&                     headers,
+    const typename RequestBody::value_type& body,
+    const request_options                   options)
 {
     LOG_INFO("making {} request to {}", http_verb_to_string<Verb>(), url);
 
-    auto task{make_task<Verb, RequestBody, ResponseBody>(std::move(url), std::move(headers), std::move(body))};
-    typed_task<RequestBody, ResponseBody>* task_ptr{static_cast<typed_task<RequestBody, ResponseBody>*>(task.get())};
-    enqueue_task(std::move(task));
+    const auto deadline{std::chrono::steady_clock::now() + options.timeout.value_or(_options.request_timeout)};
+    const bool may_retry{is_idempotent(Verb) || options.is_retry_safe};
+
+    for (std::size_t attempt{1};; ++attempt)
+    {
+        // each attempt serializes a fresh task from the same arguments
+        auto task{make_task<Verb, RequestBody, ResponseBody>(url, headers, options.header_block, body, deadline)};
+        typed_task<RequestBody, ResponseBody>* task_ptr{
+            static_cast<typed_task<RequestBody, ResponseBody>*>(task.get())};
+        enqueue_task(std::move(task), options.priority);
+
+        auto [ec, response]{co_await task_ptr->async_wait(net::cancel_at(deadline, net::as_tuple(net::use_awaitable)))};
+
+        const auto now{std::chrono::steady_clock::now()};
+        if (ec && now >= deadline)
+        {
+            LOG_ERROR("{} request to {} timed out", http_verb_to_string<Verb>(), url);
+            co_return std::make_tuple(boost::system::error_code{net::error::timed_out}, std::move(response));
+        }
+
+        // a 429 with Retry-After is held back by the rate limiter until then and needs no backoff; any other 429 gets
+        // the backoff of a transport failure, so it is not resent straight into the throttle. The limiter only sees
+        // this response once run_task() resumes, so its Retry-After is read here directly.
+        const bool is_throttled{!ec && response.result() == http::status::too_many_requests};
+        const bool is_held_back{
+            is_throttled && (parse_rate_limit_feedback(response.result(), response.base()).retry_after ||
+                             _rate_limiter.next_available(options.priority, now) > now)};
+        const auto delay{is_held_back ? std::chrono::milliseconds{0} : _options.retry.backoff(attempt)};
+        if ((!ec && !is_throttled) || ec == net::error::operation_aborted || !may_retry ||
+            attempt >= _options.retry.max_attempts || now + delay >= deadline)
+        {
+            co_return std::make_tuple(ec, std::move(response));
+        }
+
+        LOG_WARN("{} request to {} failed ({}), retrying in {} ms", http_verb_to_string<Verb>(), url,
+                 is_throttled ? std::string{"429"} : ec.message(), delay.count());
 
-    auto [ec, response]{co_await task_ptr->async_wait()};
-    co_return std::make_tuple(ec, std::move(response));
+        net::steady_timer timer{_ioc};
+        timer.expires_after(delay);
+        if (auto [timer_ec] = co_await timer.async_wait(net::as_tuple(net::use_awaitable)); timer_ec)
+        {
+            co_return std::make_tuple(timer_ec, http::response<ResponseBody>{});
+        }
+    }
 }
 
 template<http::verb Verb, typename RequestBody, typename ResponseBody>
-std::unique_ptr<base_task>
-    async_rest_client::make_task(std::string_view url, http::fields headers, typename RequestBody::value_type body)
+std::unique_ptr<base_task> async_rest_client::make_task(
+    std::string_view                            url,
+    const http::fields&                         headers,
+    const std::string_view                      header_block,
+    const typename RequestBody::value_type&     body,
+    const std::chrono::steady_clock::time_point deadline)
 {
     return std::make_unique<typed_task<RequestBody, ResponseBody>>(
-        _ioc.get_executor(), Verb, std::move(url), std::move(headers), std::move(body));
+        _ioc.get_executor(), Verb, url, headers, header_block, body, deadline);
 }
 
 } // namespace async_rest_client
@@ -1,23 +1,81 @@
 #pragma once
 
 #include "connection_context.hpp"
+#include "rate_limiter.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/url.hpp>
+#include <chrono>
 
 namespace async_rest_client
 {
 
 namespace net = boost::asio;
 
+/**
+ * Outcome of reading one response. The task is completed only if ec is not set; otherwise the caller decides whether
+ * to fail it or send it again.
+ */
+struct read_result
+{
+    boost::system::error_code ec{};
+
+    /**
+     * false if the server announced it closes the connection after this response
+     */
+    bool keep_alive{false};
+};
+
 struct base_task
 {
-    virtual ~base_task()                                             = default;
+    virtual ~base_task() = default;
+
+    /**
+     * Writes the request and reads the response, completing the task either way.
+     */
     virtual net::awaitable<bool> send(http_connection_context& ctx)  = 0;
     virtual net::awaitable<bool> send(https_connection_context& ctx) = 0;
-    virtual void                 fail(boost::system::error_code ec)  = 0;
+
+    /**
+     * Pipelining halves of send(): write_request() only writes, read_response() reads the next response off the
+     * connection and completes the task on success. Neither completes the task on failure. A task may be written
+     * again after a failure.
+     */
+    virtual net::awaitable<boost::system::error_code> write_request(http_connection_context& ctx)  = 0;
+    virtual net::awaitable<boost::system::error_code> write_request(https_connection_context& ctx) = 0;
+    virtual net::awaitable<read_result>               read_response(http_connection_context& ctx)  = 0;
+    virtual net::awaitable<read_result>               read_response(https_connection_context& ctx) = 0;
+
+    virtual void fail(boost::system::error_code ec) = 0;
+
+    [[nodiscard]]
+    virtual boost::urls::url_view endpoint() const = 0;
+
+    /**
+     * Time by which the request must have completed; writes and reads are cut off there.
+     */
+    [[nodiscard]]
+    virtual std::chrono::steady_clock::time_point deadline() const = 0;
+
+    /**
+     * @return true once the task completed, failed or was abandoned by its caller; a queued task that is done is
+     * dropped instead of being sent
+     */
+    [[nodiscard]]
+    virtual bool is_done() const = 0;
+
+    /**
+     * @return rate-limit headers of the response; empty until one was read
+     */
+    [[nodiscard]]
+    virtual const rate_limit_feedback& feedback() const = 0;
+
+    /**
+     * @return true if sending the request twice has the same effect as sending it once (RFC 9110 section 9.2.2), so
+     * it may be pipelined and resent when the connection closes before its response
+     */
     [[nodiscard]]
-    virtual const boost::url& endpoint() const = 0;
+    virtual bool is_idempotent() const = 0;
 };
 
 } // namespace async_rest_client
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "base_task.hpp"
+#include "tls_session_cache.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/url.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace async_rest_client
+{
+
+namespace beast = boost::beast;
+namespace net   = boost::asio;
+namespace ssl   = boost::asio::ssl;
+
+/**
+ * Outcome of connection::send_pipelined().
+ */
+struct pipeline_result
+{
+    /**
+     * Leading tasks that got their response and are complete; the others got none and were not completed.
+     */
+    std::size_t completed{0};
+
+    /**
+     * Why the remaining tasks got no response; not set if every task completed.
+     */
+    boost::system::error_code ec{};
+};
+
+/**
+ * One keep-alive HTTP or HTTPS connection to a single origin (scheme, host and port). Requests sent over it run one
+ * at a time, unless they are pipelined with send_pipelined(); concurrency comes from holding several connections in a
+ * connection_pool.
+ */
+class connection
+{
+public:
+    /**
+     * @param origin url whose scheme, host and port this connection serves; nothing is opened until connect()
+     * @param session_cache resumes TLS sessions of earlier connections to the same origin
+     */
+    connection(net::io_context& ioc, ssl::context& ssl_ctx, tls_session_cache& session_cache, boost::url origin);
+
+    ~connection();
+
+    connection(const connection&)            = delete;
+    connection& operator=(const connection&) = delete;
+
+    /**
+     * Resolves, connects and (for https) performs the TLS handshake. Returns immediately if already connected.
+     *
+     * @param deadline connecting and the handshake fail with a timeout there, or after 30 seconds if that is earlier
+     */
+    net::awaitable<boost::system::error_code>
+        connect(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /**
+     * Runs task over this connection. The connection must be connected.
+     *
+     * @return false if the exchange failed; the connection is closed then, as the stream is in an unknown state
+     */
+    net::awaitable<bool> send(base_task& task);
+
+    /**
+     * Writes every task's request back-to-back, then reads the responses in the same order (HTTP/1.1 pipelining), so
+     * the batch costs one round trip instead of one per task. The connection must be connected.
+     *
+     * Stops at the first response that fails or that announces the server closes the connection; the tasks after it
+     * are left for the caller to fail or resend, and the connection is closed.
+     */
+    net::awaitable<pipeline_result> send_pipelined(std::span<base_task* const> tasks);
+
+    /**
+     * Closes without a TLS close_notify, for connections that failed or are being dropped.
+     */
+    void close();
+
+    [[nodiscard]]
+    bool is_connected() const;
+
+    /**
+     * Checks without blocking whether the peer closed the connection (or sent anything, such as a TLS close_notify,
+     * while no request was outstanding) since it went idle. Servers drop idle keep-alive connections silently; a
+     * request sent on one would fail.
+     */
+    [[nodiscard]]
+    bool is_stale() const;
+
+    /**
+     * Starts the idle clock; the pool calls this when the connection is returned.
+     */
+    void mark_idle();
+
+    [[nodiscard]]
+    std::chrono::steady_clock::duration idle_for() const;
+
+    [[nodiscard]]
+    const boost::url& origin() const;
+
+private:
+    enum class connection_state
+    {
+        NOT_CONNECTED,
+        CONNECTING,
+        CONNECTED
+    };
+
+    template<typename Context>
+    net::awaitable<pipeline_result> exchange_pipelined(Context& ctx, std::span<base_task* const> tasks);
+
+    void close_socket();
+
+    void reset_streams();
+
+    net::io_context&                                      _ioc;
+    ssl::context&                                         _ssl_ctx;
+    tls_session_cache&                                    _session_cache;
+    boost::url                                            _origin;
+    std::string                                           _origin_key;
+    bool                                                  _is_tls;
+    std::unique_ptr<beast::tcp_stream>                    _tcp_stream;
+    std::unique_ptr<beast::ssl_stream<beast::tcp_stream>> _ssl_stream;
+    beast::flat_buffer                                    _buffer{};
+    connection_state                                      _connection_state{connection_state::NOT_CONNECTED};
+    std::chrono::steady_clock::time_point                 _idle_since{std::chrono::steady_clock::now()};
+};
+
+} // namespace async_rest_client
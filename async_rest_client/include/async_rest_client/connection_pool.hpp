@@ -0,0 +1,128 @@
+#pragma once
+
+#include "connection.hpp"
+#include "tls_session_cache.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/url.hpp>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace async_rest_client
+{
+
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+
+/**
+ * Keep-alive connections grouped by origin, at most max_connections_per_origin open per origin at a time.
+ *
+ * A connection is either idle in the pool or lent out by acquire() until release(). Connections to different
+ * origins are independent, so switching between hosts no longer tears down TLS sessions. Idle connections the server
+ * closed, or that idled longer than idle_timeout (and so are about to be closed by the server), are never lent out.
+ */
+class connection_pool
+{
+public:
+    connection_pool(
+        net::io_context&     ioc,
+        ssl::context&        ssl_ctx,
+        tls_session_cache&   session_cache,
+        std::size_t          max_connections_per_origin,
+        std::chrono::seconds idle_timeout);
+
+    /**
+     * @return an idle connection to url's origin, most recently used first, or a new unconnected one if the origin is
+     * below its limit; nullptr if every connection the origin may have is lent out
+     */
+    [[nodiscard]]
+    std::shared_ptr<connection> acquire(boost::urls::url_view url);
+
+    /**
+     * @return a new unconnected connection to url's origin, or nullptr if the origin is at its limit
+     */
+    [[nodiscard]]
+    std::shared_ptr<connection> acquire_new(boost::urls::url_view url);
+
+    /**
+     * Returns a connection from acquire(). Connected ones go back to the idle list, closed ones free their slot.
+     */
+    void release(std::shared_ptr<connection> conn);
+
+    [[nodiscard]]
+    std::size_t max_connections_per_origin() const;
+
+    /**
+     * @return connections to url's origin that are idle or lent out
+     */
+    [[nodiscard]]
+    std::size_t open_connections(boost::urls::url_view url) const;
+
+    [[nodiscard]]
+    std::size_t idle_connections(boost::urls::url_view url) const;
+
+    /**
+     * Closes idle connections that are stale or expired, for every origin.
+     */
+    void prune_idle();
+
+    /**
+     * @return false once disable_pipelining() was called for url's origin
+     */
+    [[nodiscard]]
+    bool supports_pipelining(boost::urls::url_view url) const;
+
+    /**
+     * Sends requests to url's origin one at a time from now on, for servers that close pipelined connections.
+     */
+    void disable_pipelining(boost::urls::url_view url);
+
+private:
+    struct origin_slots
+    {
+        std::vector<std::shared_ptr<connection>> idle{};
+        std::size_t                              open{0};
+        bool                                     pipelining{true};
+    };
+
+    /**
+     * @return true if conn may be lent out again; otherwise closes it and frees its slot
+     */
+    bool keep_idle(origin_slots& slots, connection& conn);
+
+    std::shared_ptr<connection> open_new(origin_slots& slots, boost::urls::url_view url);
+
+    net::io_context&                              _ioc;
+    ssl::context&                                 _ssl_ctx;
+    tls_session_cache&                            _session_cache;
+    std::size_t                                   _max_connections_per_origin;
+    std::chrono::seconds                          _idle_timeout;
+    /**
+     * Lets origins be looked up by the string_view url_view::encoded_origin() returns, without building a string.
+     */
+    struct origin_hash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::string_view origin) const noexcept
+        {
+            return std::hash<std::string_view>{}(origin);
+        }
+    };
+
+    /**
+     * @return url's origin, added if not seen before
+     */
+    origin_slots& slots_for(boost::urls::url_view url);
+
+    std::unordered_map<std::string, origin_slots, origin_hash, std::equal_to<>> _origins{};
+};
+
+} // namespace async_rest_client
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace async_rest_client
+{
+
+/**
+ * Free list of equally sized memory blocks, so objects created and destroyed per request reuse their memory instead
+ * of going to the heap every time. Not thread-safe: each thread keeps its own cache (see typed_task).
+ */
+class block_cache
+{
+public:
+    block_cache(std::size_t block_size, std::size_t max_cached);
+
+    ~block_cache();
+
+    block_cache(const block_cache&)            = delete;
+    block_cache& operator=(const block_cache&) = delete;
+
+    [[nodiscard]]
+    void* allocate();
+
+    /**
+     * Keeps block for the next allocate(), or frees it if max_cached blocks are kept already.
+     */
+    void deallocate(void* block) noexcept;
+
+private:
+    std::size_t        _block_size;
+    std::size_t        _max_cached;
+    std::vector<void*> _blocks{};
+};
+
+/**
+ * String buffer taken from a per-thread cache and given back, with its capacity, on destruction. Once buffers have
+ * grown to the size of the largest request, filling one no longer allocates.
+ */
+class pooled_buffer
+{
+public:
+    pooled_buffer();
+
+    ~pooled_buffer();
+
+    pooled_buffer(const pooled_buffer&)            = delete;
+    pooled_buffer& operator=(const pooled_buffer&) = delete;
+
+    [[nodiscard]]
+    std::string& str();
+
+    [[nodiscard]]
+    std::string_view view() const;
+
+private:
+    std::string _buffer{};
+};
+
+} // namespace async_rest_client
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "request_priority.hpp"
+
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/status.hpp>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace async_rest_client
+{
+
+namespace http = boost::beast::http;
+
+struct rate_limit_options
+{
+    /**
+     * Requests the client may send per period, across all origins; 0 leaves the rate to the server, whose Retry-After
+     * and rate-limit headers are still honoured.
+     */
+    std::size_t requests_per_period{0};
+
+    std::chrono::seconds period{60};
+
+    /**
+     * Part of the budget only high-priority requests may spend, so polling at normal or low priority never uses up
+     * what order entry and exits need. Lower-priority requests are delayed instead.
+     */
+    std::size_t high_priority_reserve{0};
+};
+
+/**
+ * Rate-limit state a server reported with a response.
+ */
+struct rate_limit_feedback
+{
+    /**
+     * X-RateLimit-Remaining: requests left in the server's current window
+     */
+    std::optional<std::size_t> remaining{};
+
+    /**
+     * X-RateLimit-Reset: when the server's window restarts
+     */
+    std::optional<std::chrono::system_clock::time_point> reset{};
+
+    /**
+     * Retry-After of a 429 or 503 response
+     */
+    std::optional<std::chrono::seconds> retry_after{};
+};
+
+/**
+ * Reads the rate-limit headers of a response. Retry-After is only read as delay-seconds; an HTTP-date is ignored.
+ */
+[[nodiscard]]
+rate_limit_feedback parse_rate_limit_feedback(http::status status, const http::fields& headers);
+
+/**
+ * Token bucket gating when queued requests may be sent.
+ *
+ * The bucket holds up to requests_per_period tokens and refills continuously, so the budget is spread over the
+ * period instead of being spent in a burst at its start. Every request takes one token; normal and low priority
+ * requests leave the last high_priority_reserve tokens alone. Server feedback only ever makes the bucket stricter:
+ * it lowers the tokens to what the server says remain, and blocks every request until a Retry-After or an exhausted
+ * window has passed.
+ */
+class rate_limiter
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit rate_limiter(rate_limit_options options, clock::time_point now = clock::now());
+
+    /**
+     * Takes a token if a request of this priority may be sent now.
+     */
+    [[nodiscard]]
+    bool try_acquire(request_priority priority, clock::time_point now = clock::now());
+
+    /**
+     * @return earliest time try_acquire(priority) can succeed; now or earlier if it would succeed already
+     */
+    [[nodiscard]]
+    clock::time_point next_available(request_priority priority, clock::time_point now = clock::now()) const;
+
+    void update(const rate_limit_feedback& feedback, clock::time_point now = clock::now());
+
+    /**
+     * @return tokens in the bucket at now; 0 when client-side limiting is disabled
+     */
+    [[nodiscard]]
+    double tokens(clock::time_point now = clock::now()) const;
+
+private:
+    [[nodiscard]]
+    bool is_enabled() const;
+
+    [[nodiscard]]
+    double reserve(request_priority priority) const;
+
+    void refill(clock::time_point now);
+
+    rate_limit_options _options;
+    double             _capacity;
+    double             _tokens_per_second;
+    double             _tokens;
+    clock::time_point  _last_refill;
+    clock::time_point  _blocked_until{};
+};
+
+} // namespace async_rest_client
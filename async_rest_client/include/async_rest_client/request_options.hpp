@@ -0,0 +1,36 @@
+#pragma once
+
+#include "request_priority.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+namespace async_rest_client
+{
+
+struct request_options
+{
+    request_priority priority{request_priority::normal};
+
+    /**
+     * Time from submission until the request is abandoned, queueing, connecting and retries included; overrides
+     * client_options::request_timeout.
+     */
+    std::optional<std::chrono::milliseconds> timeout{};
+
+    /**
+     * Lets the retry policy resend a non-idempotent request, for requests the server deduplicates, such as an order
+     * carrying a client_order_id.
+     */
+    bool is_retry_safe{false};
+
+    /**
+     * Preformatted header lines ("Name: value\r\n" each) sent in addition to the headers argument, e.g. credentials
+     * formatted once with format_header_block() instead of copied into http::fields for every request. Must stay valid
+     * until the request completes.
+     */
+    std::string_view header_block{};
+};
+
+} // namespace async_rest_client
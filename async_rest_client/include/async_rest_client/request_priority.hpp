@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+namespace async_rest_client
+{
+
+/**
+ * Order in which queued requests are dispatched: all queued high requests go out before any normal one, and so on.
+ * Requests of equal priority keep their submission order.
+ */
+enum class request_priority
+{
+    high,
+    normal,
+    low
+};
+
+inline constexpr std::size_t REQUEST_PRIORITY_COUNT{3};
+
+constexpr std::size_t priority_index(const request_priority priority) noexcept
+{
+    return static_cast<std::size_t>(priority);
+}
+
+} // namespace async_rest_client
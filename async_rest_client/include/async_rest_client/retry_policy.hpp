@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace async_rest_client
+{
+
+/**
+ * How often, and how soon, a request that failed on the transport (connect, write or read error) or was answered with
+ * 429 Too Many Requests is sent again. Only idempotent requests, and requests marked request_options::is_retry_safe,
+ * are retried, and never past their deadline. A 429 whose Retry-After the rate limiter is already waiting out is resent
+ * once that has passed instead of after a backoff. Other HTTP error responses are returned, not retried.
+ */
+struct retry_policy
+{
+    /**
+     * Attempts per request, the first one included; 1 disables retries.
+     */
+    std::size_t max_attempts{3};
+
+    /**
+     * Wait before the first retry; it doubles with every further retry, up to max_backoff.
+     */
+    std::chrono::milliseconds initial_backoff{50};
+    std::chrono::milliseconds max_backoff{1000};
+
+    /**
+     * @param attempt the attempt that failed, starting at 1
+     */
+    [[nodiscard]]
+    constexpr std::chrono::milliseconds backoff(const std::size_t attempt) const noexcept
+    {
+        auto delay{initial_backoff};
+        for (std::size_t i{1}; i < attempt && delay < max_backoff; ++i)
+            delay *= 2;
+        return std::min(delay, max_backoff);
+    }
+};
+
+} // namespace async_rest_client
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <boost/asio/ssl.hpp>
+#include <cstddef>
+#include <openssl/ssl.h>
+#include <string>
+#include <unordered_map>
+
+namespace async_rest_client
+{
+
+namespace ssl = boost::asio::ssl;
+
+/**
+ * Client-side TLS session cache keyed by origin, so a new connection to a host we already talked to resumes the
+ * previous session (abbreviated handshake, one round trip less and no certificate verification) instead of running a
+ * full handshake.
+ *
+ * Sessions are stored from OpenSSL's new-session callback, which also catches tickets a server sends after the
+ * handshake, and survive the connections they were negotiated on. One cache is installed per ssl::context.
+ */
+class tls_session_cache
+{
+public:
+    explicit tls_session_cache(ssl::context& ssl_ctx);
+
+    ~tls_session_cache();
+
+    tls_session_cache(const tls_session_cache&)            = delete;
+    tls_session_cache& operator=(const tls_session_cache&) = delete;
+
+    /**
+     * Offers the cached session for origin to ssl and tags ssl so sessions it negotiates are cached under origin.
+     * Call before the handshake; origin must outlive ssl.
+     */
+    void prepare(SSL* ssl, const std::string& origin);
+
+    /**
+     * Counts a completed handshake on ssl as resumed or full.
+     */
+    void record_handshake(SSL* ssl);
+
+    [[nodiscard]]
+    std::size_t resumed_handshakes() const;
+
+    [[nodiscard]]
+    std::size_t full_handshakes() const;
+
+private:
+    static int on_new_session(SSL* ssl, SSL_SESSION* session);
+
+    void store(const std::string& origin, SSL_SESSION* session);
+
+    std::unordered_map<std::string, SSL_SESSION*> _sessions{};
+    std::size_t                                   _resumed_handshakes{0};
+    std::size_t                                   _full_handshakes{0};
+};
+
+} // namespace async_rest_client
@@ -4,11 +4,18 @@
 #include "concepts.hpp"
 #include "formatter.hpp"
 #include "my_logger.hpp"
+#include "pooled_storage.hpp"
 #include "utils.hpp"
 
 #include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/beast.hpp>
 #include <boost/url.hpp>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
 #include <string_view>
 
 namespace async_rest_client
@@ -23,38 +30,95 @@ template<typename ReqBody, typename ResBody>
 class typed_task final : public base_task
 {
 public:
+    /**
+     * Serializes the request right away, so nothing of headers, header_block or request_payload is kept.
+     *
+     * @param header_block preformatted header lines sent after headers, see serialize_request()
+     */
     typed_task(
-        net::io_context::executor_type executor,
-        http::verb                     verb,
-        std::string_view               url,
-        http::fields                   headers,
-        typename ReqBody::value_type   request_payload);
+        net::io_context::executor_type        executor,
+        http::verb                            verb,
+        std::string_view                      url,
+        const http::fields&                   headers,
+        std::string_view                      header_block,
+        const typename ReqBody::value_type&   request_payload,
+        std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * Tasks are created and destroyed for every request, so their memory is recycled through a per-thread
+     * block_cache. A task must be destroyed on the thread that created it, which the client's single io_context
+     * thread guarantees.
+     */
+    static void* operator new(std::size_t size);
+    static void  operator delete(void* block, std::size_t size) noexcept;
 
     //
     // Start of base_task methods
 
-    net::awaitable<bool> send(http_connection_context& ctx) override;
-    net::awaitable<bool> send(https_connection_context& ctx) override;
-    void                 fail(boost::system::error_code ec) override;
+    net::awaitable<bool>                      send(http_connection_context& ctx) override;
+    net::awaitable<bool>                      send(https_connection_context& ctx) override;
+    net::awaitable<boost::system::error_code> write_request(http_connection_context& ctx) override;
+    net::awaitable<boost::system::error_code> write_request(https_connection_context& ctx) override;
+    net::awaitable<read_result>               read_response(http_connection_context& ctx) override;
+    net::awaitable<read_result>               read_response(https_connection_context& ctx) override;
+    void                                      fail(boost::system::error_code ec) override;
 
     //
     // Start of typed_task methods
 
-    net::awaitable<std::tuple<boost::system::error_code, http::response<ResBody>>> async_wait();
+    /**
+     * Waits for the response. Cancelling the wait through token's cancellation slot abandons the request: the wait
+     * completes with operation_aborted right away, a queued request is dropped and the response to one in flight is
+     * discarded.
+     */
+    template<typename CompletionToken>
+    auto async_wait(CompletionToken&& token);
+
+    [[nodiscard]]
+    boost::urls::url_view endpoint() const override;
+
+    [[nodiscard]]
+    bool is_idempotent() const override;
+
+    [[nodiscard]]
+    std::chrono::steady_clock::time_point deadline() const override;
+
+    [[nodiscard]]
+    bool is_done() const override;
 
     [[nodiscard]]
-    const boost::url& endpoint() const override;
+    const rate_limit_feedback& feedback() const override;
 
 private:
+    static constexpr std::size_t MAX_CACHED_TASKS{64};
+
+    static block_cache& blocks();
+
+    void complete(boost::system::error_code ec, http::response<ResBody> res);
+
+    /**
+     * Called through the cancellation slot of the async_wait() handler.
+     */
+    void abandon();
+
     template<SupportedStreamType Stream>
     net::awaitable<bool> run_impl(Stream& stream, beast::flat_buffer& buffer);
 
+    template<SupportedStreamType Stream>
+    net::awaitable<boost::system::error_code> write_impl(Stream& stream);
+
+    template<SupportedStreamType Stream>
+    net::awaitable<read_result> read_impl(Stream& stream, beast::flat_buffer& buffer);
+
     net::any_completion_handler<void(boost::system::error_code, http::response<ResBody>)> _handler{};
     net::io_context::executor_type                                                        _executor;
-    boost::url                                                                            _endpoint{};
+    endpoint_url                                                                          _endpoint{};
     http::verb                                                                            _verb{};
-    http::fields                                                                          _headers{};
-    typename ReqBody::value_type                                                          _request_payload{};
+    pooled_buffer                                                                         _wire{};
+    std::chrono::steady_clock::time_point                                                 _deadline;
+    net::cancellation_slot                                                                _cancellation_slot{};
+    rate_limit_feedback                                                                   _feedback{};
+    bool                                                                                  _is_done{false};
 };
 
 //
@@ -66,17 +130,42 @@ private:
 template<typename ReqBody, typename ResBody>
     requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
 typed_task<ReqBody, ResBody>::typed_task(
-    net::io_context::executor_type executor,
-    const http::verb               verb,
-    const std::string_view         url,
-    http::fields                   headers,
-    typename ReqBody::value_type   request_payload)
+    net::io_context::executor_type              executor,
+    const http::verb                            verb,
+    const std::string_view                      url,
+    const http::fields&                         headers,
+    const std::string_view                      header_block,
+    const typename ReqBody::value_type&         request_payload,
+    const std::chrono::steady_clock::time_point deadline)
     : _executor{std::move(executor)},
-      _endpoint{make_http_https_url(url)},
+      _endpoint{url},
       _verb{verb},
-      _headers{std::move(headers)},
-      _request_payload{std::move(request_payload)}
+      _deadline{deadline}
 {
+    normalize_http_https_url(_endpoint);
+
+    std::string_view body{};
+    if constexpr (std::same_as<ReqBody, http::string_body>)
+    {
+        body = request_payload;
+    }
+    serialize_request(_wire.str(), _verb, _endpoint, headers, header_block, body);
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+void* typed_task<ReqBody, ResBody>::operator new(const std::size_t size)
+{
+    static_assert(alignof(typed_task) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    assert(size == sizeof(typed_task) && "typed_task is final");
+    return blocks().allocate();
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+void typed_task<ReqBody, ResBody>::operator delete(void* block, std::size_t) noexcept
+{
+    blocks().deallocate(block);
 }
 
 //
@@ -96,87 +185,226 @@ net::awaitable<bool> typed_task<ReqBody, ResBody>::send(https_connection_context
     co_return co_await run_impl(ctx.stream, ctx.buffer);
 }
 
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+net::awaitable<boost::system::error_code> typed_task<ReqBody, ResBody>::write_request(http_connection_context& ctx)
+{
+    co_return co_await write_impl(ctx.stream);
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+net::awaitable<boost::system::error_code> typed_task<ReqBody, ResBody>::write_request(https_connection_context& ctx)
+{
+    co_return co_await write_impl(ctx.stream);
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+net::awaitable<read_result> typed_task<ReqBody, ResBody>::read_response(http_connection_context& ctx)
+{
+    co_return co_await read_impl(ctx.stream, ctx.buffer);
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+net::awaitable<read_result> typed_task<ReqBody, ResBody>::read_response(https_connection_context& ctx)
+{
+    co_return co_await read_impl(ctx.stream, ctx.buffer);
+}
+
 template<typename ReqBody, typename ResBody>
     requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
 void typed_task<ReqBody, ResBody>::fail(boost::system::error_code ec)
 {
-    if (_handler)
-    {
-        std::move(_handler)(ec, http::response<ResBody>{});
-    }
+    complete(ec, http::response<ResBody>{});
 }
 
 template<typename ReqBody, typename ResBody>
     requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
-net::awaitable<std::tuple<boost::system::error_code, http::response<ResBody>>>
-    typed_task<ReqBody, ResBody>::async_wait()
+template<typename CompletionToken>
+auto typed_task<ReqBody, ResBody>::async_wait(CompletionToken&& token)
 {
-    auto [ec, response] = co_await net::async_initiate<void(boost::system::error_code, http::response<ResBody>)>(
+    return net::async_initiate<CompletionToken, void(boost::system::error_code, http::response<ResBody>)>(
         [this]<typename Handler>(Handler&& handler)
         {
+            if (auto slot{net::get_associated_cancellation_slot(handler)}; slot.is_connected())
+            {
+                _cancellation_slot = slot;
+                slot.assign([this](net::cancellation_type) { abandon(); });
+            }
+
             _handler = [w = net::make_work_guard(_executor), h = std::forward<Handler>(handler)](
                            auto error_code, auto res) mutable { std::move(h)(error_code, std::move(res)); };
         },
-        net::as_tuple(net::use_awaitable));
-
-    co_return std::make_tuple(ec, std::move(response));
+        token);
 }
 
 template<typename ReqBody, typename ResBody>
     requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
-const boost::url& typed_task<ReqBody, ResBody>::endpoint() const
+boost::urls::url_view typed_task<ReqBody, ResBody>::endpoint() const
 {
     return _endpoint;
 }
 
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+bool typed_task<ReqBody, ResBody>::is_idempotent() const
+{
+    return async_rest_client::is_idempotent(_verb);
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+std::chrono::steady_clock::time_point typed_task<ReqBody, ResBody>::deadline() const
+{
+    return _deadline;
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+bool typed_task<ReqBody, ResBody>::is_done() const
+{
+    return _is_done;
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+const rate_limit_feedback& typed_task<ReqBody, ResBody>::feedback() const
+{
+    return _feedback;
+}
+
 //
 // Start of private methods
 
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+block_cache& typed_task<ReqBody, ResBody>::blocks()
+{
+    thread_local block_cache cache{sizeof(typed_task), MAX_CACHED_TASKS};
+    return cache;
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+void typed_task<ReqBody, ResBody>::complete(const boost::system::error_code ec, http::response<ResBody> res)
+{
+    if (_is_done)
+    {
+        LOG_TRACE("discarding result of abandoned request to {}", _endpoint.c_str());
+        return;
+    }
+    _is_done = true;
+
+    if (_cancellation_slot.is_connected())
+    {
+        _cancellation_slot.clear();
+    }
+    if (_handler)
+    {
+        std::move(_handler)(ec, std::move(res));
+    }
+}
+
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+void typed_task<ReqBody, ResBody>::abandon()
+{
+    if (_is_done || !_handler)
+    {
+        return;
+    }
+    _is_done = true;
+    LOG_INFO("request to {} abandoned", _endpoint.c_str());
+
+    // the handler must not run inside the cancellation signal that is calling us, as it may destroy that signal
+    net::post(
+        _executor,
+        [handler = std::move(_handler)]() mutable
+        { std::move(handler)(boost::system::error_code{net::error::operation_aborted}, http::response<ResBody>{}); });
+}
+
 template<typename ReqBody, typename ResBody>
     requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
 template<SupportedStreamType Stream>
 net::awaitable<bool> typed_task<ReqBody, ResBody>::run_impl(Stream& stream, beast::flat_buffer& buffer)
 {
-    try
+    if (const auto write_ec{co_await write_impl(stream)})
     {
-        http::request<ReqBody> req{_verb, _endpoint.encoded_target(), 11};
-        req.set(http::field::host, _endpoint.encoded_host());
-        req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        complete(write_ec, http::response<ResBody>{});
+        co_return false;
+    }
 
-        for (const auto& header : _headers)
-            req.set(header.name_string(), header.value());
+    if (const auto result{co_await read_impl(stream, buffer)}; result.ec)
+    {
+        complete(result.ec, http::response<ResBody>{});
+        co_return false;
+    }
 
-        req.set(http::field::connection, "keep-alive");
+    buffer.consume(buffer.size());
+    co_return true;
+}
 
-        req.body() = std::move(_request_payload);
-        req.prepare_payload();
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+template<SupportedStreamType Stream>
+net::awaitable<boost::system::error_code> typed_task<ReqBody, ResBody>::write_impl(Stream& stream)
+{
+    try
+    {
+        beast::get_lowest_layer(stream).expires_at(_deadline);
 
+        // only the request line: the headers carry credentials
         LOG_INFO("sending request to {}", _endpoint.encoded_host());
-        LOG_TRACE("request: {}", req);
+        LOG_TRACE("request: {}", _wire.view().substr(0, _wire.view().find('\r')));
 
-        co_await http::async_write(stream, req, net::use_awaitable);
+        co_await net::async_write(stream, net::buffer(_wire.view()), net::use_awaitable);
+        co_return boost::system::error_code{};
+    }
+    catch (const boost::system::system_error& e)
+    {
+        LOG_ERROR("{}: {}", e.code().message(), e.what());
+        co_return e.code();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("{}", e.what());
+        co_return boost::system::error_code{boost::system::errc::io_error, boost::system::generic_category()};
+    }
+}
 
+template<typename ReqBody, typename ResBody>
+    requires SupportedRequestBody<ReqBody> && SupportedResponseBody<ResBody>
+template<SupportedStreamType Stream>
+net::awaitable<read_result> typed_task<ReqBody, ResBody>::read_impl(Stream& stream, beast::flat_buffer& buffer)
+{
+    try
+    {
+        // only the bytes of this response are consumed; pipelined responses behind it stay in the buffer
         http::response<ResBody> res{};
+        beast::get_lowest_layer(stream).expires_at(_deadline);
         co_await http::async_read(stream, buffer, res, net::use_awaitable);
-        buffer.consume(buffer.size());
 
-        assert(_handler && "Handler must be set before run_impl is called");
+        // an idle keep-alive connection must not be closed when this request's deadline passes
+        beast::get_lowest_layer(stream).expires_never();
+
+        const bool keep_alive{res.keep_alive()};
+        _feedback = parse_rate_limit_feedback(res.result(), res);
         LOG_TRACE("response: {}", res);
-        std::move(_handler)(boost::system::error_code{}, std::move(res));
-        co_return true;
+        complete(boost::system::error_code{}, std::move(res));
+        co_return read_result{.keep_alive = keep_alive};
     }
     catch (const boost::system::system_error& e)
     {
         LOG_ERROR("{}: {}", e.code().message(), e.what());
-        std::move(_handler)(e.code(), http::response<ResBody>{});
-        co_return false;
+        co_return read_result{.ec = e.code()};
     }
     catch (const std::exception& e)
     {
         LOG_ERROR("{}", e.what());
-        boost::system::error_code ec{boost::system::errc::io_error, boost::system::generic_category()};
-        std::move(_handler)(ec, http::response<ResBody>{});
-        co_return false;
+        co_return read_result{
+            .ec = boost::system::error_code{boost::system::errc::io_error, boost::system::generic_category()}};
     }
 }
 } // namespace async_rest_client
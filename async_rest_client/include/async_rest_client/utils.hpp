@@ -1,19 +1,69 @@
 #pragma once
 
+#include <boost/beast/http/fields.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/url.hpp>
+#include <boost/url/static_url.hpp>
+#include <cstddef>
+#include <string>
 #include <string_view>
 
 namespace http = boost::beast::http;
 
 namespace async_rest_client
 {
+/**
+ * Longest url a request may have; endpoints are kept in fixed-capacity storage so parsing them does not allocate.
+ */
+inline constexpr std::size_t MAX_URL_LENGTH{1024};
+
+using endpoint_url = boost::urls::static_url<MAX_URL_LENGTH>;
+
+/**
+ * Checks that url is http or https and sets the scheme's default port if it has none.
+ *
+ * @throws boost::system::system_error if the scheme is neither http nor https
+ */
+void normalize_http_https_url(boost::urls::url_base& url);
+
 /**
  * @param url_sv url to normalize
  * @return url with default port if port is missing based off of scheme
  */
 boost::url make_http_https_url(const std::string_view& url_sv);
 
+/**
+ * @return headers as "Name: value\r\n" lines, for request_options::header_block
+ */
+std::string format_header_block(const http::fields& headers);
+
+/**
+ * Writes a complete HTTP/1.1 request (request line, headers, body) into out, replacing its content, so it can be
+ * written to a connection as is and written again when resent. Host and User-Agent are added unless headers has
+ * them; Connection and Content-Length are always set here.
+ *
+ * @param header_block preformatted header lines ("Name: value\r\n" each), appended verbatim
+ */
+void serialize_request(
+    std::string&           out,
+    http::verb             verb,
+    boost::urls::url_view  endpoint,
+    const http::fields&    headers,
+    std::string_view       header_block,
+    std::string_view       body);
+
+/**
+ * @return true if sending a request with this method twice has the same effect as sending it once (RFC 9110 section
+ * 9.2.2)
+ */
+constexpr bool is_idempotent(const http::verb method) noexcept
+{
+    using http::verb;
+
+    return method == verb::get || method == verb::head || method == verb::put || method == verb::delete_ ||
+           method == verb::options || method == verb::trace;
+}
+
 template<http::verb Verb>
 constexpr std::string_view http_verb_to_string() noexcept
 {
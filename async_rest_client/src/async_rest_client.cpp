@@ -1,33 +1,38 @@
 #include "async_rest_client/async_rest_client.hpp"
 
-#include "async_rest_client/connection_context.hpp"
+#include "async_rest_client/connection_pool.hpp"
 #include "async_rest_client/typed_task.hpp"
 #include "async_rest_client/utils.hpp"
 #include "my_logger.hpp"
 
-#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/url.hpp>
+#include <algorithm>
 #include <cassert>
-#include <chrono>
+#include <cstddef>
 #include <memory>
-#include <openssl/ssl.h>
 #include <string_view>
+#include <vector>
 
 namespace async_rest_client
 {
 
-std::shared_ptr<async_rest_client> async_rest_client::create(net::io_context& ioc)
+std::shared_ptr<async_rest_client> async_rest_client::create(net::io_context& ioc, client_options options)
 {
-    return std::shared_ptr<async_rest_client>{new async_rest_client{ioc}};
+    return std::shared_ptr<async_rest_client>{new async_rest_client{ioc, options}};
 }
 
-async_rest_client::async_rest_client(net::io_context& ioc)
+async_rest_client::async_rest_client(net::io_context& ioc, const client_options options)
     : _ioc{ioc},
+      _options{options},
       _ssl_ctx{ssl::context::tlsv12_client},
-      _tcp_stream{std::make_unique<beast::tcp_stream>(_ioc)},
-      _ssl_stream{std::make_unique<beast::ssl_stream<beast::tcp_stream>>(_ioc, _ssl_ctx)},
-      _buffer{std::make_unique<beast::flat_buffer>()}
+      _session_cache{_ssl_ctx},
+      _pool{_ioc, _ssl_ctx, _session_cache, options.max_connections_per_origin, options.idle_timeout},
+      _rate_limiter{options.rate_limit},
+      _dispatch_timer{_ioc},
+      _keepalive_timer{_ioc}
 {
     _ssl_ctx.set_default_verify_paths();
     _ssl_ctx.set_verify_mode(ssl::verify_peer);
@@ -37,23 +42,12 @@ async_rest_client::~async_rest_client()
 {
     const boost::system::error_code ec{boost::system::errc::operation_canceled, boost::system::generic_category()};
 
-    while (!_tasks.empty())
+    for (auto& tasks : _tasks)
     {
-        _tasks.front()->fail(ec);
-        _tasks.pop_front();
-    }
-
-    if (_connection_state == connection_state::CONNECTED)
-    {
-        if (_is_tls)
-        {
-            boost::system::error_code shutdown_ec;
-            _ssl_stream->shutdown(shutdown_ec); // NOLINT
-            beast::get_lowest_layer(*_ssl_stream).close();
-        }
-        else
+        while (!tasks.empty())
         {
-            _tcp_stream->close();
+            tasks.front()->fail(ec);
+            tasks.pop_front();
         }
     }
 }
@@ -61,14 +55,37 @@ async_rest_client::~async_rest_client()
 net::awaitable<boost::system::error_code> async_rest_client::connect(std::string_view url_sv)
 {
     LOG_INFO("connecting to {}", url_sv);
-    if (_connection_state == connection_state::CONNECTING)
+
+    boost::url url{};
+    try
+    {
+        url = make_http_https_url(url_sv);
+    }
+    catch (const boost::system::system_error& e)
+    {
+        LOG_ERROR("{}", e.what());
+        co_return e.code();
+    }
+
+    auto conn{_pool.acquire(url)};
+    if (!conn)
     {
-        LOG_WARN("calling connect() while already in connecting state");
-        co_return boost::system::error_code{
-            boost::system::errc::operation_in_progress, boost::system::generic_category()};
+        LOG_INFO("all connections to {} are in use", url.encoded_origin());
+        co_return make_error_code(boost::system::errc::success);
     }
 
-    _connection_state = connection_state::CONNECTING;
+    const auto ec{co_await conn->connect()};
+    _pool.release(std::move(conn));
+
+    // a request may have been queued while this connection was busy connecting
+    dispatch();
+    co_return ec;
+}
+
+net::awaitable<boost::system::error_code> async_rest_client::preconnect(
+    std::string_view url_sv, const std::size_t connections)
+{
+    LOG_INFO("keeping {} connection(s) to {} warm", connections, url_sv);
 
     boost::url url{};
     try
@@ -78,189 +95,291 @@ net::awaitable<boost::system::error_code> async_rest_client::connect(std::string
     catch (const boost::system::system_error& e)
     {
         LOG_ERROR("{}", e.what());
-        _connection_state = connection_state::NOT_CONNECTED;
         co_return e.code();
     }
 
-    _is_tls = url.scheme() == "https";
+    const std::size_t target{std::min(connections, _pool.max_connections_per_origin())};
+    _warm_origins[std::string{url.encoded_origin()}] = warm_origin{.url = url, .connections = target};
 
-    if (_is_tls && !SSL_set_tlsext_host_name(_ssl_stream->native_handle(), url.host().c_str()))
+    if (!_is_maintaining)
     {
-        LOG_ERROR("SSL_set_tlsext_host_name failed");
-        boost::system::error_code ec{static_cast<int>(ERR_get_error()), net::error::get_ssl_category()};
-        _connection_state = connection_state::NOT_CONNECTED;
-        co_return ec;
+        _is_maintaining = true;
+        net::co_spawn(_ioc, maintain_warm_connections(weak_from_this()), net::detached);
     }
 
-    tcp::resolver resolver{_ioc};
-    auto [resolve_ec, endpoints]{
-        co_await resolver.async_resolve(url.host(), url.port(), net::as_tuple(net::use_awaitable))};
+    co_return co_await top_up(std::move(url), target);
+}
 
-    if (resolve_ec)
-    {
-        LOG_ERROR("async_resolve() failed");
-        _connection_state = connection_state::NOT_CONNECTED;
-        co_return resolve_ec;
-    }
+const tls_session_cache& async_rest_client::tls_sessions() const
+{
+    return _session_cache;
+}
+
+void async_rest_client::enqueue_task(std::unique_ptr<base_task>&& task, const request_priority priority)
+{
+    auto& tasks{_tasks[priority_index(priority)]};
+    tasks.push_back(std::move(task));
+    LOG_TRACE("enqueued task {}", tasks.back()->endpoint().buffer());
+
+    dispatch();
+}
 
-    if (_is_tls)
+void async_rest_client::dispatch()
+{
+    for (std::size_t priority{0}; priority < REQUEST_PRIORITY_COUNT; ++priority)
     {
-        beast::get_lowest_layer(*_ssl_stream).expires_after(std::chrono::seconds(30));
-        auto [connect_ec, endpoint] =
-            co_await beast::get_lowest_layer(*_ssl_stream).async_connect(endpoints, net::as_tuple(net::use_awaitable));
+        auto& tasks{_tasks[priority]};
 
-        if (connect_ec)
+        // a task whose origin has no free connection waits; tasks behind it for other origins may still go out
+        for (std::size_t index{0}; index < tasks.size();)
         {
-            LOG_ERROR("async_connect() failed");
-            _connection_state = connection_state::NOT_CONNECTED;
-            co_return connect_ec;
-        }
+            if (tasks[index]->is_done())
+            {
+                // abandoned by its caller while queued
+                tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(index));
+                continue;
+            }
 
-        beast::get_lowest_layer(*_ssl_stream).expires_after(std::chrono::seconds(30));
-        auto [handshake_ec] =
-            co_await _ssl_stream->async_handshake(ssl::stream_base::client, net::as_tuple(net::use_awaitable));
+            // lower priorities keep a larger reserve, so when this task has to wait nothing behind it may go either
+            const auto now{rate_limiter::clock::now()};
+            const auto available{_rate_limiter.next_available(static_cast<request_priority>(priority), now)};
+            if (available > now)
+            {
+                schedule_dispatch(available);
+                return;
+            }
 
-        if (handshake_ec)
-        {
-            LOG_ERROR("async_handshake() failed");
-            _connection_state = connection_state::NOT_CONNECTED;
-            co_return handshake_ec;
-        }
-    }
-    else
-    {
-        _tcp_stream->expires_after(std::chrono::seconds(30));
-        auto [connect_ec, endpoint] = co_await _tcp_stream->async_connect(endpoints, net::as_tuple(net::use_awaitable));
+            auto conn{_pool.acquire(tasks[index]->endpoint())};
+            if (!conn)
+            {
+                ++index;
+                continue;
+            }
 
-        if (connect_ec)
-        {
-            LOG_ERROR("async_connect() failed");
-            _connection_state = connection_state::NOT_CONNECTED;
-            co_return connect_ec;
+            [[maybe_unused]] const bool has_token{
+                _rate_limiter.try_acquire(static_cast<request_priority>(priority), now)};
+            assert(has_token);
+
+            std::unique_ptr<base_task> task{std::move(tasks[index])};
+            tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(index));
+            LOG_TRACE("dispatching task {}", task->endpoint().buffer());
+
+            if (_options.pipeline_depth > 1 && task->is_idempotent() && _pool.supports_pipelining(task->endpoint()))
+            {
+                std::vector<queued_task> batch{};
+                batch.push_back(queued_task{.task = std::move(task), .priority = priority});
+                collect_pipeline(batch, priority, index);
+
+                if (batch.size() > 1)
+                {
+                    net::co_spawn(
+                        _ioc, run_pipeline(shared_from_this(), std::move(batch), std::move(conn)), net::detached);
+                    continue;
+                }
+                task = std::move(batch.front().task);
+            }
+
+            net::co_spawn(_ioc, run_task(shared_from_this(), std::move(task), std::move(conn)), net::detached);
         }
     }
-
-    _connection_state = connection_state::CONNECTED;
-    _current_origin   = std::move(url);
-    LOG_INFO("successfully connected to {}", url_sv);
-    co_return make_error_code(boost::system::errc::success);
 }
 
-void async_rest_client::enqueue_task(std::unique_ptr<base_task>&& task)
+net::awaitable<void> async_rest_client::run_task(
+    std::shared_ptr<async_rest_client> self, std::unique_ptr<base_task> task, std::shared_ptr<connection> conn)
 {
-    _tasks.push_back(std::move(task));
-    LOG_TRACE("enqueued task {}", _tasks.front()->endpoint().c_str());
-    LOG_TRACE("{} tasks in queue", _tasks.size());
-
-    if (!_is_processing)
+    // self keeps the client, and with it the pool conn returns to, alive until the task is done
+    if (const auto connect_ec{co_await conn->connect(task->deadline())})
+    {
+        LOG_ERROR("failed to connect to {}", conn->origin().encoded_origin());
+        task->fail(connect_ec);
+    }
+    else if (!task->is_done())
     {
-        LOG_TRACE("spawning process_queue() coroutine...");
-        net::co_spawn(_ioc, process_queue(), net::detached);
+        co_await conn->send(*task);
+        _rate_limiter.update(task->feedback());
     }
+
+    _pool.release(std::move(conn));
+    dispatch();
 }
 
-net::awaitable<void> async_rest_client::process_queue()
+void async_rest_client::collect_pipeline(
+    std::vector<queued_task>& batch, const std::size_t priority, const std::size_t index)
 {
-    assert(!_is_processing && "process_queue is being launched more than one time");
+    const auto origin{batch.front().task->endpoint().encoded_origin()};
 
-    _is_processing = true;
-
-    LOG_TRACE("starting request task queue processing");
-
-    while (!_tasks.empty())
+    for (std::size_t p{priority}; p < REQUEST_PRIORITY_COUNT; ++p)
     {
-        const std::unique_ptr<base_task>& current_task{_tasks.front()};
-
-        const boost::url& task_endpoint{current_task->endpoint()};
+        auto& tasks{_tasks[p]};
+        for (std::size_t i{p == priority ? index : 0}; i < tasks.size();)
+        {
+            if (batch.size() == _options.pipeline_depth)
+            {
+                return;
+            }
+            if (tasks[i]->is_done())
+            {
+                tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            if (tasks[i]->endpoint().encoded_origin() != origin)
+            {
+                ++i;
+                continue;
+            }
 
-        bool is_new_connection_required{false};
+            if (!_rate_limiter.try_acquire(static_cast<request_priority>(p)))
+            {
+                return;
+            }
 
-        if (_connection_state != connection_state::CONNECTED)
-        {
-            // Not current connect
+            const bool is_idempotent{tasks[i]->is_idempotent()};
+            batch.push_back(queued_task{.task = std::move(tasks[i]), .priority = p});
+            tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(i));
 
-            is_new_connection_required = true;
-        }
-        else if (_current_origin.encoded_origin() != task_endpoint.encoded_origin())
-        {
-            // Connected to a different host
-            is_new_connection_required = true;
-            co_await graceful_shutdown();
+            // nothing may follow a request that must not be sent twice: it could not be resent if the server closed
+            if (!is_idempotent)
+            {
+                return;
+            }
         }
+    }
+}
 
-        if (is_new_connection_required)
-        {
-            const std::string_view new_origin{task_endpoint.encoded_origin()};
+net::awaitable<void> async_rest_client::run_pipeline(
+    std::shared_ptr<async_rest_client> self, std::vector<queued_task> batch, std::shared_ptr<connection> conn)
+{
+    if (const auto connect_ec{co_await conn->connect(batch.front().task->deadline())})
+    {
+        LOG_ERROR("failed to connect to {}", conn->origin().encoded_origin());
+        requeue_unanswered(batch, 0, connect_ec);
+    }
+    else
+    {
+        // tasks abandoned while connecting are not sent
+        std::erase_if(batch, [](const auto& queued) { return queued.task->is_done(); });
 
-            LOG_INFO("changing connected host from {} -> {}", _current_origin.host(), new_origin);
+        std::vector<base_task*> tasks{};
+        for (const auto& queued : batch)
+            tasks.push_back(queued.task.get());
 
-            if (const auto connect_ec = co_await connect(new_origin))
-            {
-                LOG_ERROR("failed to change connection from {} -> {}", _current_origin.host(), new_origin);
+        const auto result{co_await conn->send_pipelined(tasks)};
+        for (std::size_t i{0}; i < result.completed; ++i)
+            _rate_limiter.update(tasks[i]->feedback());
 
-                current_task->fail(connect_ec);
-                _tasks.pop_front();
-                continue;
+        if (result.completed < batch.size())
+        {
+            // a server that answered some of the batch and then closed does not pipeline; one that answered nothing
+            // may just have dropped the connection
+            if (result.completed > 0)
+            {
+                _pool.disable_pipelining(conn->origin());
             }
+            requeue_unanswered(batch, result.completed, result.ec);
         }
+    }
+
+    _pool.release(std::move(conn));
+    dispatch();
+}
 
-        if (_is_tls)
+void async_rest_client::requeue_unanswered(
+    std::vector<queued_task>& batch, const std::size_t completed, const boost::system::error_code ec)
+{
+    // back to front, so requeued tasks keep their order at the front of their queues
+    for (std::size_t i{batch.size()}; i-- > completed;)
+    {
+        auto& [task, priority]{batch[i]};
+        if (task->is_idempotent() && (completed > 0 || i > 0))
         {
-            connection_context ctx{*_ssl_stream, *_buffer};
-            co_await current_task->send(ctx);
+            LOG_INFO("resending {} after the pipelined connection closed", task->endpoint().buffer());
+            _tasks[priority].push_front(std::move(task));
         }
         else
         {
-            connection_context ctx{*_tcp_stream, *_buffer};
-            co_await current_task->send(ctx);
+            task->fail(ec);
         }
-
-        _tasks.pop_front();
     }
-
-    LOG_TRACE("done processing all request tasks");
-
-    _is_processing = false;
-
-    co_return;
 }
 
-net::awaitable<void> async_rest_client::graceful_shutdown()
+void async_rest_client::schedule_dispatch(const rate_limiter::clock::time_point when)
 {
-    if (_connection_state != connection_state::CONNECTED)
+    if (_dispatch_wakeup && *_dispatch_wakeup <= when)
     {
-        LOG_WARN("calling graceful_shutdown() when not connected");
-        co_return;
+        return;
     }
 
-    if (_is_tls)
-    {
-        auto [ec] = co_await _ssl_stream->async_shutdown(net::as_tuple(net::use_awaitable));
+    LOG_TRACE("rate limited, dispatching again in {} ms",
+              std::chrono::duration_cast<std::chrono::milliseconds>(when - rate_limiter::clock::now()).count());
+
+    // re-arming cancels the later wake-up, if any
+    _dispatch_wakeup = when;
+    _dispatch_timer.expires_at(when);
+    _dispatch_timer.async_wait(
+        [weak_self = weak_from_this()](const boost::system::error_code ec)
+        {
+            if (ec)
+            {
+                return;
+            }
+            if (const auto self{weak_self.lock()})
+            {
+                self->_dispatch_wakeup.reset();
+                self->dispatch();
+            }
+        });
+}
 
-        if (ec == ssl::error::stream_truncated)
-            ec = {};
+net::awaitable<boost::system::error_code> async_rest_client::top_up(boost::url url, const std::size_t target)
+{
+    while (_pool.idle_connections(url) < target)
+    {
+        auto conn{_pool.acquire_new(url)};
+        if (!conn)
+        {
+            break;
+        }
 
-        beast::get_lowest_layer(*_ssl_stream).close();
-        _ssl_stream = std::make_unique<beast::ssl_stream<beast::tcp_stream>>(_ioc, _ssl_ctx);
+        const auto ec{co_await conn->connect()};
+        _pool.release(std::move(conn));
+        dispatch();
 
         if (ec)
         {
-            throw boost::system::system_error{ec, "SSL shutdown failed"};
+            LOG_ERROR("failed to pre-connect to {}: {}", url.encoded_origin(), ec.message());
+            co_return ec;
         }
     }
-    else
+    co_return boost::system::error_code{};
+}
+
+net::awaitable<void> async_rest_client::maintain_warm_connections(std::weak_ptr<async_rest_client> weak_self)
+{
+    while (true)
     {
-        _tcp_stream->close();
-        _tcp_stream = std::make_unique<beast::tcp_stream>(_ioc);
-    }
+        _keepalive_timer.expires_after(_options.keepalive_interval);
+        if (auto [ec] = co_await _keepalive_timer.async_wait(net::as_tuple(net::use_awaitable)); ec)
+        {
+            // the timer is cancelled when the client is destroyed; this must not be touched anymore
+            co_return;
+        }
 
-    _buffer->consume(_buffer->size());
+        const auto self{weak_self.lock()};
+        if (!self)
+        {
+            co_return;
+        }
+
+        _pool.prune_idle();
 
-    _current_origin.clear();
-    _is_tls = false;
+        // preconnect() may register origins while a top-up is connecting, so iterate over a copy
+        std::vector<warm_origin> origins{};
+        for (const auto& [key, origin] : _warm_origins)
+            origins.push_back(origin);
 
-    _connection_state = connection_state::NOT_CONNECTED;
-    co_return;
+        for (auto& origin : origins)
+            co_await top_up(std::move(origin.url), origin.connections);
+    }
 }
 
 } // namespace async_rest_client
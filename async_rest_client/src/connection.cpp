@@ -0,0 +1,273 @@
+#include "async_rest_client/connection.hpp"
+
+#include "async_rest_client/connection_context.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <openssl/ssl.h>
+#include <sys/socket.h>
+
+namespace async_rest_client
+{
+
+using tcp = boost::asio::ip::tcp;
+
+connection::connection(
+    net::io_context& ioc, ssl::context& ssl_ctx, tls_session_cache& session_cache, boost::url origin)
+    : _ioc{ioc},
+      _ssl_ctx{ssl_ctx},
+      _session_cache{session_cache},
+      _origin{std::move(origin)},
+      _origin_key{_origin.encoded_origin()},
+      _is_tls{_origin.scheme() == "https"}
+{
+    reset_streams();
+}
+
+connection::~connection()
+{
+    if (_connection_state == connection_state::CONNECTED && _is_tls)
+    {
+        boost::system::error_code shutdown_ec;
+        _ssl_stream->shutdown(shutdown_ec); // NOLINT
+    }
+    close_socket();
+}
+
+net::awaitable<boost::system::error_code> connection::connect(const std::chrono::steady_clock::time_point deadline)
+{
+    if (_connection_state == connection_state::CONNECTED)
+    {
+        co_return boost::system::error_code{};
+    }
+    if (_connection_state == connection_state::CONNECTING)
+    {
+        LOG_WARN("calling connect() while already in connecting state");
+        co_return boost::system::error_code{
+            boost::system::errc::operation_in_progress, boost::system::generic_category()};
+    }
+
+    LOG_INFO("connecting to {}", _origin.encoded_origin());
+    _connection_state = connection_state::CONNECTING;
+
+    if (_is_tls && !SSL_set_tlsext_host_name(_ssl_stream->native_handle(), _origin.host().c_str()))
+    {
+        LOG_ERROR("SSL_set_tlsext_host_name failed");
+        boost::system::error_code ec{static_cast<int>(ERR_get_error()), net::error::get_ssl_category()};
+        _connection_state = connection_state::NOT_CONNECTED;
+        co_return ec;
+    }
+
+    tcp::resolver resolver{_ioc};
+    auto [resolve_ec, endpoints]{
+        co_await resolver.async_resolve(_origin.host(), _origin.port(), net::as_tuple(net::use_awaitable))};
+
+    if (resolve_ec)
+    {
+        LOG_ERROR("async_resolve() failed");
+        _connection_state = connection_state::NOT_CONNECTED;
+        co_return resolve_ec;
+    }
+
+    beast::tcp_stream& tcp_stream{_is_tls ? beast::get_lowest_layer(*_ssl_stream) : *_tcp_stream};
+
+    const auto connect_deadline{std::min(deadline, std::chrono::steady_clock::now() + std::chrono::seconds(30))};
+    tcp_stream.expires_at(connect_deadline);
+    auto [connect_ec, endpoint] = co_await tcp_stream.async_connect(endpoints, net::as_tuple(net::use_awaitable));
+
+    if (connect_ec)
+    {
+        LOG_ERROR("async_connect() failed");
+        reset_streams();
+        co_return connect_ec;
+    }
+
+    // lets the OS notice a peer that vanished without closing while the connection idles in the pool
+    boost::system::error_code option_ec;
+    tcp_stream.socket().set_option(net::socket_base::keep_alive{true}, option_ec); // NOLINT
+
+    if (_is_tls)
+    {
+        _session_cache.prepare(_ssl_stream->native_handle(), _origin_key);
+
+        tcp_stream.expires_at(connect_deadline);
+        auto [handshake_ec] =
+            co_await _ssl_stream->async_handshake(ssl::stream_base::client, net::as_tuple(net::use_awaitable));
+
+        if (handshake_ec)
+        {
+            LOG_ERROR("async_handshake() failed");
+            reset_streams();
+            co_return handshake_ec;
+        }
+
+        _session_cache.record_handshake(_ssl_stream->native_handle());
+        LOG_TRACE(
+            "TLS handshake with {} {}",
+            _origin_key,
+            SSL_session_reused(_ssl_stream->native_handle()) ? "resumed a cached session" : "was a full handshake");
+    }
+
+    // the connect deadline must not carry over to requests sent later over this keep-alive connection
+    tcp_stream.expires_never();
+
+    _connection_state = connection_state::CONNECTED;
+    LOG_INFO("successfully connected to {}", _origin.encoded_origin());
+    co_return make_error_code(boost::system::errc::success);
+}
+
+net::awaitable<bool> connection::send(base_task& task)
+{
+    bool ok{false};
+    if (_is_tls)
+    {
+        connection_context ctx{*_ssl_stream, _buffer};
+        ok = co_await task.send(ctx);
+    }
+    else
+    {
+        connection_context ctx{*_tcp_stream, _buffer};
+        ok = co_await task.send(ctx);
+    }
+
+    if (!ok)
+    {
+        close();
+    }
+    co_return ok;
+}
+
+net::awaitable<pipeline_result> connection::send_pipelined(const std::span<base_task* const> tasks)
+{
+    if (_is_tls)
+    {
+        https_connection_context ctx{*_ssl_stream, _buffer};
+        co_return co_await exchange_pipelined(ctx, tasks);
+    }
+
+    http_connection_context ctx{*_tcp_stream, _buffer};
+    co_return co_await exchange_pipelined(ctx, tasks);
+}
+
+void connection::close()
+{
+    if (_connection_state == connection_state::NOT_CONNECTED)
+    {
+        return;
+    }
+
+    close_socket();
+    reset_streams();
+}
+
+bool connection::is_connected() const
+{
+    return _connection_state == connection_state::CONNECTED;
+}
+
+bool connection::is_stale() const
+{
+    if (!is_connected())
+    {
+        return true;
+    }
+
+    auto&      socket{_is_tls ? beast::get_lowest_layer(*_ssl_stream).socket() : _tcp_stream->socket()};
+    char       byte{};
+    const auto n{::recv(socket.native_handle(), &byte, 1, MSG_PEEK | MSG_DONTWAIT)};
+
+    // 0 is an orderly close, data means the server is closing (or misbehaving); only "nothing to read" is healthy
+    return n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
+void connection::mark_idle()
+{
+    _idle_since = std::chrono::steady_clock::now();
+}
+
+std::chrono::steady_clock::duration connection::idle_for() const
+{
+    return std::chrono::steady_clock::now() - _idle_since;
+}
+
+const boost::url& connection::origin() const
+{
+    return _origin;
+}
+
+template<typename Context>
+net::awaitable<pipeline_result> connection::exchange_pipelined(Context& ctx, const std::span<base_task* const> tasks)
+{
+    LOG_TRACE("pipelining {} requests to {}", tasks.size(), _origin_key);
+
+    // a failed write does not lose the responses to the requests already written, so those are still read
+    std::size_t               written{0};
+    boost::system::error_code write_ec{};
+    for (auto* task : tasks)
+    {
+        if ((write_ec = co_await task->write_request(ctx)))
+        {
+            break;
+        }
+        ++written;
+    }
+
+    pipeline_result result{};
+    bool            keep_alive{true};
+    while (result.completed < written && keep_alive)
+    {
+        const auto response{co_await tasks[result.completed]->read_response(ctx)};
+        if (response.ec)
+        {
+            result.ec = response.ec;
+            break;
+        }
+        keep_alive = response.keep_alive;
+        ++result.completed;
+    }
+
+    if (result.completed < tasks.size() && !result.ec)
+    {
+        result.ec = write_ec ? write_ec : boost::system::error_code{net::error::connection_aborted};
+    }
+
+    if (result.ec || !keep_alive)
+    {
+        close();
+    }
+    co_return result;
+}
+
+void connection::close_socket()
+{
+    boost::system::error_code ec;
+    if (_is_tls)
+    {
+        beast::get_lowest_layer(*_ssl_stream).socket().close(ec); // NOLINT
+    }
+    else
+    {
+        _tcp_stream->socket().close(ec); // NOLINT
+    }
+}
+
+void connection::reset_streams()
+{
+    // an ssl_stream cannot be reused after its TCP connection closed, so both are recreated
+    if (_is_tls)
+    {
+        _ssl_stream = std::make_unique<beast::ssl_stream<beast::tcp_stream>>(_ioc, _ssl_ctx);
+    }
+    else
+    {
+        _tcp_stream = std::make_unique<beast::tcp_stream>(_ioc);
+    }
+    _buffer.consume(_buffer.size());
+    _connection_state = connection_state::NOT_CONNECTED;
+}
+
+} // namespace async_rest_client
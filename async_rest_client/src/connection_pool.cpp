@@ -0,0 +1,141 @@
+#include "async_rest_client/connection_pool.hpp"
+
+#include "my_logger.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace async_rest_client
+{
+
+connection_pool::connection_pool(
+    net::io_context&           ioc,
+    ssl::context&              ssl_ctx,
+    tls_session_cache&         session_cache,
+    const std::size_t          max_connections_per_origin,
+    const std::chrono::seconds idle_timeout)
+    : _ioc{ioc},
+      _ssl_ctx{ssl_ctx},
+      _session_cache{session_cache},
+      _max_connections_per_origin{max_connections_per_origin},
+      _idle_timeout{idle_timeout}
+{
+    assert(max_connections_per_origin > 0 && "a pool needs at least one connection per origin");
+}
+
+std::shared_ptr<connection> connection_pool::acquire(const boost::urls::url_view url)
+{
+    auto& slots{slots_for(url)};
+
+    // most recently used first: it is the least likely to have been closed by the server while idle
+    while (!slots.idle.empty())
+    {
+        auto conn{std::move(slots.idle.back())};
+        slots.idle.pop_back();
+        if (keep_idle(slots, *conn))
+        {
+            return conn;
+        }
+    }
+
+    return open_new(slots, url);
+}
+
+std::shared_ptr<connection> connection_pool::acquire_new(const boost::urls::url_view url)
+{
+    return open_new(slots_for(url), url);
+}
+
+void connection_pool::release(std::shared_ptr<connection> conn)
+{
+    auto& slots{slots_for(conn->origin())};
+    if (conn->is_connected())
+    {
+        conn->mark_idle();
+        slots.idle.push_back(std::move(conn));
+    }
+    else
+    {
+        assert(slots.open > 0);
+        --slots.open;
+    }
+}
+
+std::size_t connection_pool::max_connections_per_origin() const
+{
+    return _max_connections_per_origin;
+}
+
+std::size_t connection_pool::open_connections(const boost::urls::url_view url) const
+{
+    const auto it{_origins.find(std::string_view{url.encoded_origin()})};
+    return it == _origins.end() ? 0 : it->second.open;
+}
+
+std::size_t connection_pool::idle_connections(const boost::urls::url_view url) const
+{
+    const auto it{_origins.find(std::string_view{url.encoded_origin()})};
+    return it == _origins.end() ? 0 : it->second.idle.size();
+}
+
+void connection_pool::prune_idle()
+{
+    for (auto& [origin, slots] : _origins)
+    {
+        std::erase_if(slots.idle, [this, &slots](const auto& conn) { return !keep_idle(slots, *conn); });
+    }
+}
+
+bool connection_pool::supports_pipelining(const boost::urls::url_view url) const
+{
+    const auto it{_origins.find(std::string_view{url.encoded_origin()})};
+    return it == _origins.end() || it->second.pipelining;
+}
+
+void connection_pool::disable_pipelining(const boost::urls::url_view url)
+{
+    auto& slots{slots_for(url)};
+    if (slots.pipelining)
+    {
+        LOG_WARN("{} closed a pipelined connection, sending requests to it one at a time", url.encoded_origin());
+        slots.pipelining = false;
+    }
+}
+
+connection_pool::origin_slots& connection_pool::slots_for(const boost::urls::url_view url)
+{
+    const std::string_view origin{url.encoded_origin()};
+    if (const auto it{_origins.find(origin)}; it != _origins.end())
+    {
+        return it->second;
+    }
+    return _origins.emplace(std::string{origin}, origin_slots{}).first->second;
+}
+
+bool connection_pool::keep_idle(origin_slots& slots, connection& conn)
+{
+    if (conn.idle_for() < _idle_timeout && !conn.is_stale())
+    {
+        return true;
+    }
+
+    LOG_INFO("dropping idle connection to {}", conn.origin().encoded_origin());
+    conn.close();
+    assert(slots.open > 0);
+    --slots.open;
+    return false;
+}
+
+std::shared_ptr<connection> connection_pool::open_new(origin_slots& slots, const boost::urls::url_view url)
+{
+    if (slots.open == _max_connections_per_origin)
+    {
+        return nullptr;
+    }
+
+    ++slots.open;
+    LOG_TRACE("opening connection {} of {} to {}", slots.open, _max_connections_per_origin, url.encoded_origin());
+    return std::make_shared<connection>(_ioc, _ssl_ctx, _session_cache, boost::url{url.encoded_origin()});
+}
+
+} // namespace async_rest_client
@@ -0,0 +1,91 @@
+#include "async_rest_client/pooled_storage.hpp"
+
+#include <new>
+
+namespace async_rest_client
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_CACHED_BUFFERS{64};
+
+std::vector<std::string>& cached_buffers()
+{
+    thread_local std::vector<std::string> buffers{};
+    return buffers;
+}
+
+} // anonymous namespace
+
+//
+// block_cache
+
+block_cache::block_cache(const std::size_t block_size, const std::size_t max_cached)
+    : _block_size{block_size},
+      _max_cached{max_cached}
+{
+    // deallocate() must not allocate
+    _blocks.reserve(max_cached);
+}
+
+block_cache::~block_cache()
+{
+    for (void* block : _blocks)
+        ::operator delete(block, _block_size);
+}
+
+void* block_cache::allocate()
+{
+    if (_blocks.empty())
+    {
+        return ::operator new(_block_size);
+    }
+
+    void* block{_blocks.back()};
+    _blocks.pop_back();
+    return block;
+}
+
+void block_cache::deallocate(void* block) noexcept
+{
+    if (_blocks.size() == _max_cached)
+    {
+        ::operator delete(block, _block_size);
+        return;
+    }
+    _blocks.push_back(block);
+}
+
+//
+// pooled_buffer
+
+pooled_buffer::pooled_buffer()
+{
+    if (auto& buffers{cached_buffers()}; !buffers.empty())
+    {
+        _buffer = std::move(buffers.back());
+        buffers.pop_back();
+    }
+}
+
+pooled_buffer::~pooled_buffer()
+{
+    if (auto& buffers{cached_buffers()}; buffers.size() < MAX_CACHED_BUFFERS)
+    {
+        _buffer.clear();
+        buffers.push_back(std::move(_buffer));
+    }
+}
+
+std::string& pooled_buffer::str()
+{
+    return _buffer;
+}
+
+std::string_view pooled_buffer::view() const
+{
+    return _buffer;
+}
+
+} // namespace async_rest_client
@@ -0,0 +1,152 @@
+#include "async_rest_client/rate_limiter.hpp"
+
+#include "my_logger.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+
+namespace async_rest_client
+{
+
+namespace
+{
+
+template<typename T>
+std::optional<T> parse_number(const http::fields& headers, const boost::beast::string_view name)
+{
+    const auto it{headers.find(name)};
+    if (it == headers.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto value{it->value()};
+    T          number{};
+    const auto [end, ec]{std::from_chars(value.data(), value.data() + value.size(), number)};
+    if (ec != std::errc{} || end != value.data() + value.size())
+    {
+        return std::nullopt;
+    }
+    return number;
+}
+
+} // anonymous namespace
+
+rate_limit_feedback parse_rate_limit_feedback(const http::status status, const http::fields& headers)
+{
+    rate_limit_feedback feedback{};
+    feedback.remaining = parse_number<std::size_t>(headers, "X-RateLimit-Remaining");
+
+    if (const auto reset{parse_number<std::int64_t>(headers, "X-RateLimit-Reset")})
+    {
+        feedback.reset = std::chrono::system_clock::time_point{std::chrono::seconds{*reset}};
+    }
+
+    if (status == http::status::too_many_requests || status == http::status::service_unavailable)
+    {
+        if (const auto retry_after{parse_number<std::int64_t>(headers, "Retry-After")})
+        {
+            feedback.retry_after = std::chrono::seconds{*retry_after};
+        }
+    }
+    return feedback;
+}
+
+rate_limiter::rate_limiter(const rate_limit_options options, const clock::time_point now)
+    : _options{options},
+      _capacity{static_cast<double>(options.requests_per_period)},
+      _tokens_per_second{_capacity / static_cast<double>(options.period.count())},
+      _tokens{_capacity},
+      _last_refill{now}
+{
+    assert(options.period.count() > 0 && "the rate limit period must be positive");
+    assert(
+        (!is_enabled() || options.high_priority_reserve < options.requests_per_period) &&
+        "the high-priority reserve must leave a budget for other requests");
+}
+
+bool rate_limiter::try_acquire(const request_priority priority, const clock::time_point now)
+{
+    if (next_available(priority, now) > now)
+    {
+        return false;
+    }
+
+    if (is_enabled())
+    {
+        refill(now);
+        _tokens -= 1.0;
+    }
+    return true;
+}
+
+rate_limiter::clock::time_point rate_limiter::next_available(
+    const request_priority priority, const clock::time_point now) const
+{
+    if (!is_enabled())
+    {
+        return std::max(now, _blocked_until);
+    }
+
+    const double missing{reserve(priority) + 1.0 - tokens(now)};
+    if (missing <= 0.0)
+    {
+        return std::max(now, _blocked_until);
+    }
+
+    const auto wait{std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>{missing / _tokens_per_second})};
+    return std::max(now + wait, _blocked_until);
+}
+
+void rate_limiter::update(const rate_limit_feedback& feedback, const clock::time_point now)
+{
+    if (feedback.retry_after)
+    {
+        LOG_WARN("server asked to retry after {} s", feedback.retry_after->count());
+        _blocked_until = std::max(_blocked_until, now + *feedback.retry_after);
+    }
+
+    if (feedback.remaining)
+    {
+        // the server also counts requests this client does not know about, e.g. from other processes on the account
+        if (is_enabled())
+        {
+            refill(now);
+            _tokens = std::min(_tokens, static_cast<double>(*feedback.remaining));
+        }
+
+        if (*feedback.remaining == 0 && feedback.reset)
+        {
+            const auto until_reset{std::chrono::duration_cast<clock::duration>(
+                *feedback.reset - std::chrono::system_clock::now())};
+            _blocked_until = std::max(_blocked_until, now + until_reset);
+        }
+    }
+}
+
+double rate_limiter::tokens(const clock::time_point now) const
+{
+    const std::chrono::duration<double> elapsed{std::max(now, _last_refill) - _last_refill};
+    return std::min(_capacity, _tokens + elapsed.count() * _tokens_per_second);
+}
+
+bool rate_limiter::is_enabled() const
+{
+    return _options.requests_per_period > 0;
+}
+
+double rate_limiter::reserve(const request_priority priority) const
+{
+    return priority == request_priority::high ? 0.0 : static_cast<double>(_options.high_priority_reserve);
+}
+
+void rate_limiter::refill(const clock::time_point now)
+{
+    _tokens      = tokens(now);
+    _last_refill = std::max(now, _last_refill);
+}
+
+} // namespace async_rest_client
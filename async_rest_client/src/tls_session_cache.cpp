@@ -0,0 +1,99 @@
+#include "async_rest_client/tls_session_cache.hpp"
+
+#include "my_logger.hpp"
+
+namespace async_rest_client
+{
+
+namespace
+{
+
+int cache_index()
+{
+    static const int index{SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr)};
+    return index;
+}
+
+int origin_index()
+{
+    static const int index{SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr)};
+    return index;
+}
+
+} // anonymous namespace
+
+tls_session_cache::tls_session_cache(ssl::context& ssl_ctx)
+{
+    SSL_CTX* ctx{ssl_ctx.native_handle()};
+    SSL_CTX_set_ex_data(ctx, cache_index(), this);
+
+    // sessions are only kept here, per origin; OpenSSL's internal store is keyed for servers
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, &tls_session_cache::on_new_session);
+}
+
+tls_session_cache::~tls_session_cache()
+{
+    for (const auto& [origin, session] : _sessions)
+        SSL_SESSION_free(session);
+}
+
+void tls_session_cache::prepare(SSL* ssl, const std::string& origin)
+{
+    SSL_set_ex_data(ssl, origin_index(), const_cast<std::string*>(&origin));
+
+    if (const auto it{_sessions.find(origin)}; it != _sessions.end() && SSL_SESSION_is_resumable(it->second))
+    {
+        LOG_TRACE("offering cached TLS session for {}", origin);
+        SSL_set_session(ssl, it->second);
+    }
+}
+
+void tls_session_cache::record_handshake(SSL* ssl)
+{
+    if (SSL_session_reused(ssl))
+    {
+        ++_resumed_handshakes;
+    }
+    else
+    {
+        ++_full_handshakes;
+    }
+}
+
+std::size_t tls_session_cache::resumed_handshakes() const
+{
+    return _resumed_handshakes;
+}
+
+std::size_t tls_session_cache::full_handshakes() const
+{
+    return _full_handshakes;
+}
+
+int tls_session_cache::on_new_session(SSL* ssl, SSL_SESSION* session)
+{
+    auto*       cache{static_cast<tls_session_cache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), cache_index()))};
+    const auto* origin{static_cast<const std::string*>(SSL_get_ex_data(ssl, origin_index()))};
+    if (!cache || !origin)
+    {
+        return 0;
+    }
+
+    cache->store(*origin, session);
+    // 1 tells OpenSSL the cache took over the reference to session
+    return 1;
+}
+
+void tls_session_cache::store(const std::string& origin, SSL_SESSION* session)
+{
+    auto& cached{_sessions[origin]};
+    if (cached)
+    {
+        SSL_SESSION_free(cached);
+    }
+    cached = session;
+    LOG_TRACE("cached TLS session for {}", origin);
+}
+
+} // namespace async_rest_client
@@ -1,11 +1,13 @@
 #include "async_rest_client/utils.hpp"
 
+#include <boost/beast/version.hpp>
+#include <charconv>
+
 namespace async_rest_client
 {
 
-boost::url make_http_https_url(const std::string_view& url_sv)
+void normalize_http_https_url(boost::urls::url_base& url)
 {
-    boost::url url{url_sv};
     if (url.scheme() != "https" && url.scheme() != "http")
         throw boost::system::system_error{
             boost::system::errc::make_error_code(boost::system::errc::protocol_not_supported),
@@ -13,7 +15,82 @@ boost::url make_http_https_url(const std::string_view& url_sv)
 
     if (!url.has_port())
         url.set_port(url.scheme() == "https" ? "443" : "80");
+}
 
+boost::url make_http_https_url(const std::string_view& url_sv)
+{
+    boost::url url{url_sv};
+    normalize_http_https_url(url);
     return url;
 }
+
+std::string format_header_block(const http::fields& headers)
+{
+    std::string block{};
+    for (const auto& field : headers)
+    {
+        block.append(field.name_string().data(), field.name_string().size());
+        block += ": ";
+        block.append(field.value().data(), field.value().size());
+        block += "\r\n";
+    }
+    return block;
+}
+
+void serialize_request(
+    std::string&                out,
+    const http::verb            verb,
+    const boost::urls::url_view endpoint,
+    const http::fields&         headers,
+    const std::string_view      header_block,
+    const std::string_view      body)
+{
+    // beast and url return their own string_view types
+    const auto append{[&out](const auto& text) { out.append(text.data(), text.size()); }};
+
+    out.clear();
+    append(http::to_string(verb));
+    out += ' ';
+    if (const auto target{endpoint.encoded_target()}; target.empty())
+        out += '/';
+    else
+        append(target);
+    out += " HTTP/1.1\r\n";
+
+    if (headers.find(http::field::host) == headers.end())
+    {
+        out += "Host: ";
+        append(endpoint.encoded_host());
+        out += "\r\n";
+    }
+    if (headers.find(http::field::user_agent) == headers.end())
+        out += "User-Agent: " BOOST_BEAST_VERSION_STRING "\r\n";
+
+    for (const auto& field : headers)
+    {
+        if (field.name() == http::field::connection || field.name() == http::field::content_length)
+            continue;
+
+        append(field.name_string());
+        out += ": ";
+        append(field.value());
+        out += "\r\n";
+    }
+    out.append(header_block);
+    out += "Connection: keep-alive\r\n";
+
+    // same rule as http::message::prepare_payload()
+    if (!body.empty() || verb == http::verb::post || verb == http::verb::put || verb == http::verb::options)
+    {
+        char       length[24];
+        const auto end{std::to_chars(length, length + sizeof(length), body.size()).ptr};
+        out += "Content-Length: ";
+        out.append(length, end);
+        out += "\r\n";
+    }
+
+    out += "\r\n";
+    out.append(body);
+}
+
 } // namespace async_rest_client
@@ -0,0 +1,188 @@
+#include "async_rest_client/async_rest_client.hpp"
+#include "async_rest_client/typed_task.hpp"
+#include "async_rest_client/utils.hpp"
+#include "loopback_http_server.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// counts heap allocations per thread, so a loopback server's thread does not count; tests only look at the difference
+// over a stretch of their own code
+
+namespace
+{
+
+thread_local std::size_t allocations{0};
+
+} // anonymous namespace
+
+void* operator new(const std::size_t size)
+{
+    ++allocations;
+    if (void* block{std::malloc(size == 0 ? 1 : size)})
+    {
+        return block;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+namespace async_rest_client
+{
+
+namespace http = boost::beast::http;
+
+class AsyncRestClientAllocationTest : public ::testing::Test
+{
+protected:
+    using order_task = typed_task<http::string_body, http::string_body>;
+
+    /**
+     * What async_rest_client::request() does before it waits: creates the task, which serializes the request.
+     */
+    std::size_t submit_order()
+    {
+        std::unique_ptr<base_task> task{std::make_unique<order_task>(
+            _ioc.get_executor(),
+            http::verb::post,
+            "https://paper-api.alpaca.markets/v2/orders",
+            _headers,
+            _header_block,
+            _body,
+            std::chrono::steady_clock::now() + std::chrono::seconds{10})};
+        return task->endpoint().size();
+    }
+
+    net::io_context    _ioc{};
+    const http::fields _headers{};
+    const std::string  _header_block{"APCA-API-KEY-ID: PKTEST00000000000000\r\n"
+                                     "APCA-API-SECRET-KEY: 0000000000000000000000000000000000000000\r\n"
+                                     "Content-Type: application/json\r\n"};
+    const std::string  _body{R"({"symbol":"AAPL","notional":"250.00","side":"buy","type":"market",)"
+                             R"("time_in_force":"day","client_order_id":"macd-entry-000001"})"};
+};
+
+TEST_F(AsyncRestClientAllocationTest, SubmittingOrderDoesNotAllocateAfterWarmup)
+{
+    // the first tasks fill the task block cache and grow the pooled wire buffer
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_GT(submit_order(), 0u);
+    }
+
+    const std::size_t before{allocations};
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_GT(submit_order(), 0u);
+    }
+    EXPECT_EQ(allocations - before, 0u);
+}
+
+TEST_F(AsyncRestClientAllocationTest, ConcurrentTasksEachGetTheirOwnMemory)
+{
+    std::vector<std::unique_ptr<base_task>> tasks{};
+    tasks.reserve(8);
+    for (int i = 0; i < 8; ++i)
+    {
+        tasks.push_back(std::make_unique<order_task>(
+            _ioc.get_executor(),
+            http::verb::post,
+            "https://paper-api.alpaca.markets/v2/orders/" + std::to_string(i),
+            _headers,
+            _header_block,
+            _body,
+            std::chrono::steady_clock::time_point::max()));
+    }
+
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(tasks[i]->endpoint().path(), "/v2/orders/" + std::to_string(i));
+    }
+}
+
+TEST_F(AsyncRestClientAllocationTest, RequestDoesNotCopyBodyOrHeaders)
+{
+    using test::loopback_http_server;
+
+    loopback_http_server server{
+        1,
+        [](std::size_t, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            // until the client closes the connection
+            for (;;)
+            {
+                co_await client.read();
+                co_await client.respond(http::status::ok, "{}");
+            }
+        }};
+
+    // reading the response allocates (its header fields, coroutine frames beyond asio's cache), so the request side
+    // is measured by sending the same requests with and without a large body and extra headers: copying either
+    // would cost allocations per request that only the large ones pay
+    http::fields large_headers{};
+    for (int i = 0; i < 8; ++i)
+    {
+        large_headers.set("X-Trace-" + std::to_string(i), "0123456789abcdef0123456789abcdef");
+    }
+    const std::string large_body(4096, 'x');
+
+    // a multiple of the queue's deque block size, so both runs grow and shrink it equally often
+    constexpr int REQUESTS{128};
+
+    const auto client{async_rest_client::create(_ioc, {.max_connections_per_origin = 1})};
+    const auto url{server.url("/v2/orders")};
+
+    std::size_t small_allocations{0};
+    std::size_t large_allocations{0};
+
+    auto future = net::co_spawn(
+        _ioc,
+        [&]() -> net::awaitable<void>
+        {
+            const auto send = [&](const http::fields& headers, const std::string& body) -> net::awaitable<std::size_t>
+            {
+                const std::size_t before{allocations};
+                for (int i = 0; i < REQUESTS; ++i)
+                {
+                    auto [ec, response] =
+                        co_await client->request<http::verb::post>(url, headers, body, {.header_block = _header_block});
+                    EXPECT_FALSE(ec) << ec.message();
+                }
+                co_return allocations - before;
+            };
+
+            // connects and grows the wire buffer, the connection's read buffer and asio's caches
+            co_await send(large_headers, large_body);
+            co_await send(_headers, _body);
+
+            small_allocations = co_await send(_headers, _body);
+            large_allocations = co_await send(large_headers, large_body);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+
+    EXPECT_GT(small_allocations, 0u) << "the response side is expected to allocate";
+    EXPECT_LT(large_allocations, small_allocations + REQUESTS) << "request() copies the body or the headers";
+}
+
+} // namespace async_rest_client
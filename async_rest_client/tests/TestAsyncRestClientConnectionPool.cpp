@@ -0,0 +1,111 @@
+#include "async_rest_client/async_rest_client.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_future.hpp>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace net    = boost::asio;
+namespace http   = boost::beast::http;
+using RestClient = async_rest_client::async_rest_client;
+using async_rest_client::request_priority;
+
+class AsyncRestClientConnectionPoolTest : public ::testing::Test
+{
+protected:
+    void TearDown() override { _client.reset(); }
+
+    std::future<void> submit_get(std::string name, const request_priority priority)
+    {
+        return net::co_spawn(
+            _ioc,
+            [this, name, priority]() -> net::awaitable<void>
+            {
+                auto [ec, response] = co_await _client->request<http::verb::get>(
+                    "https://httpbin.org/get?request=" + name, {}, {}, {.priority = priority});
+                EXPECT_FALSE(ec) << name << " failed: " << ec.message();
+                EXPECT_EQ(response.result(), http::status::ok);
+                _completed.push_back(name);
+            },
+            net::use_future);
+    }
+
+    boost::asio::io_context     _ioc{};
+    std::shared_ptr<RestClient> _client;
+    std::vector<std::string>    _completed{};
+};
+
+TEST_F(AsyncRestClientConnectionPoolTest, HighPriorityRequestJumpsQueue)
+{
+    _client = RestClient::create(_ioc, {.max_connections_per_origin = 1});
+
+    // the first request takes the only connection; the rest queue behind it
+    auto poll1{submit_get("poll1", request_priority::low)};
+    auto poll2{submit_get("poll2", request_priority::low)};
+    auto poll3{submit_get("poll3", request_priority::low)};
+    auto order{submit_get("order", request_priority::high)};
+
+    _ioc.run();
+    EXPECT_NO_THROW(poll1.get());
+    EXPECT_NO_THROW(poll2.get());
+    EXPECT_NO_THROW(poll3.get());
+    EXPECT_NO_THROW(order.get());
+
+    EXPECT_EQ(_completed, (std::vector<std::string>{"poll1", "order", "poll2", "poll3"}));
+}
+
+TEST_F(AsyncRestClientConnectionPoolTest, ConcurrentRequestsUseSeparateConnections)
+{
+    _client = RestClient::create(_ioc, {.max_connections_per_origin = 4});
+
+    std::vector<std::future<void>> futures{};
+    for (int i = 0; i < 4; ++i)
+    {
+        futures.push_back(net::co_spawn(
+            _ioc,
+            [this]() -> net::awaitable<void>
+            {
+                auto [ec, response] = co_await _client->request<http::verb::get>("https://httpbin.org/delay/2");
+                EXPECT_FALSE(ec) << "GET failed: " << ec.message();
+                EXPECT_EQ(response.result(), http::status::ok);
+            },
+            net::use_future));
+    }
+
+    const auto start{std::chrono::steady_clock::now()};
+    _ioc.run();
+    const auto elapsed{std::chrono::steady_clock::now() - start};
+
+    for (auto& future : futures)
+    {
+        EXPECT_NO_THROW(future.get());
+    }
+    // one connection would take at least 4 x 2 s
+    EXPECT_LT(elapsed, std::chrono::seconds{6});
+}
+
+TEST_F(AsyncRestClientConnectionPoolTest, ConnectionsAreReusedAcrossOrigins)
+{
+    _client = RestClient::create(_ioc);
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this]() -> net::awaitable<void>
+        {
+            for (const std::string url : {"https://httpbin.org/get", "https://postman-echo.com/get",
+                                          "https://httpbin.org/get", "https://postman-echo.com/get"})
+            {
+                auto [ec, response] = co_await _client->request<http::verb::get>(url);
+                EXPECT_FALSE(ec) << url << " failed: " << ec.message();
+                EXPECT_EQ(response.result(), http::status::ok);
+            }
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
@@ -0,0 +1,247 @@
+#include "async_rest_client/async_rest_client.hpp"
+#include "loopback_http_server.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_future.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace net    = boost::asio;
+namespace http   = boost::beast::http;
+using RestClient = async_rest_client::async_rest_client;
+using async_rest_client::test::loopback_http_server;
+using namespace std::chrono_literals;
+
+class AsyncRestClientDeadlinesTest : public ::testing::Test
+{
+protected:
+    void TearDown() override { _client.reset(); }
+
+    /**
+     * Answers the first request on the connection with a 429 carrying throttle_headers and the second with a 200,
+     * recording when each arrived.
+     */
+    static loopback_http_server::script throttle_once(
+        std::vector<std::chrono::steady_clock::time_point>& arrivals, const http::fields& throttle_headers)
+    {
+        return [&arrivals, &throttle_headers](std::size_t, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            co_await client.read();
+            arrivals.push_back(std::chrono::steady_clock::now());
+            co_await client.respond(http::status::too_many_requests, "slow down", throttle_headers);
+
+            co_await client.read();
+            arrivals.push_back(std::chrono::steady_clock::now());
+            co_await client.respond(http::status::ok, "ok");
+        };
+    }
+
+    /**
+     * Reads a request and never answers it; returns (by throwing) only once the client closes the connection.
+     */
+    static net::awaitable<void> hang(loopback_http_server::peer& client)
+    {
+        co_await client.read();
+        co_await client.read();
+    }
+
+    boost::asio::io_context     _ioc{};
+    std::shared_ptr<RestClient> _client;
+};
+
+TEST_F(AsyncRestClientDeadlinesTest, HungResponseTimesOut)
+{
+    loopback_http_server server{
+        1, [](std::size_t, loopback_http_server::peer& client) -> net::awaitable<void> { co_await hang(client); }};
+
+    _client = RestClient::create(_ioc);
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this, &server]() -> net::awaitable<void>
+        {
+            const auto start{std::chrono::steady_clock::now()};
+            auto [ec, response] =
+                co_await _client->request<http::verb::get>(server.url("/hung"), {}, {}, {.timeout = 1s});
+            const auto elapsed{std::chrono::steady_clock::now() - start};
+
+            EXPECT_EQ(ec, net::error::timed_out) << ec.message();
+            EXPECT_LT(elapsed, 2s);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+
+    // the timed-out connection was closed rather than kept for reuse
+    EXPECT_TRUE(server.wait_for(1s));
+}
+
+TEST_F(AsyncRestClientDeadlinesTest, TimedOutRequestReleasesQueue)
+{
+    loopback_http_server server{
+        2,
+        [](const std::size_t connection, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            if (connection == 0)
+            {
+                co_await hang(client);
+                co_return;
+            }
+            co_await client.read();
+            co_await client.respond(http::status::ok, "ok");
+        }};
+
+    _client = RestClient::create(_ioc, {.max_connections_per_origin = 1});
+
+    const auto start{std::chrono::steady_clock::now()};
+
+    auto hung = net::co_spawn(
+        _ioc,
+        [this, &server]() -> net::awaitable<void>
+        {
+            auto [ec, response] =
+                co_await _client->request<http::verb::get>(server.url("/hung"), {}, {}, {.timeout = 1s});
+            EXPECT_EQ(ec, net::error::timed_out) << ec.message();
+        },
+        net::use_future);
+
+    auto queued = net::co_spawn(
+        _ioc,
+        [this, &server, start]() -> net::awaitable<void>
+        {
+            auto [ec, response] = co_await _client->request<http::verb::get>(server.url("/queued"));
+            EXPECT_FALSE(ec) << "GET failed: " << ec.message();
+            EXPECT_EQ(response.result(), http::status::ok);
+
+            // waited for the hung request's deadline, not for the client's default timeout
+            EXPECT_LT(std::chrono::steady_clock::now() - start, 3s);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(hung.get());
+    EXPECT_NO_THROW(queued.get());
+    EXPECT_TRUE(server.wait_for(1s));
+}
+
+TEST_F(AsyncRestClientDeadlinesTest, CancellingAwaitingCoroutineAbandonsRequest)
+{
+    loopback_http_server server{
+        1, [](std::size_t, loopback_http_server::peer& client) -> net::awaitable<void> { co_await hang(client); }};
+
+    _client = RestClient::create(_ioc);
+
+    net::cancellation_signal signal{};
+    net::steady_timer        timer{_ioc};
+    timer.expires_after(500ms);
+    timer.async_wait([&signal](auto) { signal.emit(net::cancellation_type::terminal); });
+
+    const auto start{std::chrono::steady_clock::now()};
+    auto       future = net::co_spawn(
+        _ioc,
+        [this, &server, start]() -> net::awaitable<void>
+        {
+            // the abandoned request keeps its connection until this deadline, which bounds how long _ioc runs
+            auto [ec, response] =
+                co_await _client->request<http::verb::get>(server.url("/hung"), {}, {}, {.timeout = 3s});
+            EXPECT_EQ(ec, net::error::operation_aborted) << ec.message();
+            EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+        },
+        net::bind_cancellation_slot(signal.slot(), net::use_future));
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
+
+TEST_F(AsyncRestClientDeadlinesTest, OnlyIdempotentRequestsAreRetried)
+{
+    // nothing listens on port 1, so every attempt fails to connect
+    _client = RestClient::create(_ioc, {.retry = {.max_attempts = 3, .initial_backoff = 200ms}});
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this]() -> net::awaitable<void>
+        {
+            auto start{std::chrono::steady_clock::now()};
+            auto [get_ec, get_response] = co_await _client->request<http::verb::get>("http://127.0.0.1:1/get");
+            EXPECT_TRUE(get_ec);
+            // two retries, 200 ms and 400 ms apart
+            EXPECT_GE(std::chrono::steady_clock::now() - start, 600ms);
+
+            start                         = std::chrono::steady_clock::now();
+            auto [post_ec, post_response] = co_await _client->request<http::verb::post>("http://127.0.0.1:1/post");
+            EXPECT_TRUE(post_ec);
+            EXPECT_LT(std::chrono::steady_clock::now() - start, 200ms);
+
+            start = std::chrono::steady_clock::now();
+            auto [safe_ec, safe_response] = co_await _client->request<http::verb::post>(
+                "http://127.0.0.1:1/post", {}, {}, {.is_retry_safe = true});
+            EXPECT_TRUE(safe_ec);
+            EXPECT_GE(std::chrono::steady_clock::now() - start, 600ms);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
+
+TEST_F(AsyncRestClientDeadlinesTest, ThrottledRequestWithoutRetryAfterBacksOff)
+{
+    std::vector<std::chrono::steady_clock::time_point> arrivals{};
+    const http::fields                                 no_retry_after{};
+    loopback_http_server                               server{1, throttle_once(arrivals, no_retry_after)};
+
+    _client = RestClient::create(_ioc, {.retry = {.max_attempts = 2, .initial_backoff = 300ms}});
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this, &server]() -> net::awaitable<void>
+        {
+            auto [ec, response] = co_await _client->request<http::verb::get>(server.url("/throttled"));
+            EXPECT_FALSE(ec) << ec.message();
+            EXPECT_EQ(response.result(), http::status::ok);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+
+    ASSERT_TRUE(server.wait_for(1s));
+    ASSERT_EQ(arrivals.size(), 2u);
+    // nothing tells the rate limiter when to resume, so the retry waits out the backoff
+    EXPECT_GE(arrivals[1] - arrivals[0], 300ms);
+}
+
+TEST_F(AsyncRestClientDeadlinesTest, ThrottledRequestWaitsOutRetryAfterInsteadOfBackoff)
+{
+    std::vector<std::chrono::steady_clock::time_point> arrivals{};
+    http::fields                                       retry_after{};
+    retry_after.set(http::field::retry_after, "1");
+    loopback_http_server server{1, throttle_once(arrivals, retry_after)};
+
+    _client = RestClient::create(_ioc, {.retry = {.max_attempts = 2, .initial_backoff = 5s}});
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this, &server]() -> net::awaitable<void>
+        {
+            auto [ec, response] = co_await _client->request<http::verb::get>(server.url("/throttled"));
+            EXPECT_FALSE(ec) << ec.message();
+            EXPECT_EQ(response.result(), http::status::ok);
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+
+    ASSERT_TRUE(server.wait_for(1s));
+    ASSERT_EQ(arrivals.size(), 2u);
+    EXPECT_GE(arrivals[1] - arrivals[0], 1s);
+    EXPECT_LT(arrivals[1] - arrivals[0], 3s);
+}
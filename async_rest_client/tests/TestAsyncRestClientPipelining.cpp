@@ -0,0 +1,245 @@
+#include "async_rest_client/async_rest_client.hpp"
+#include "loopback_http_server.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_future.hpp>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace net    = boost::asio;
+namespace http   = boost::beast::http;
+using RestClient = async_rest_client::async_rest_client;
+using async_rest_client::test::loopback_http_server;
+using namespace std::chrono_literals;
+
+class AsyncRestClientPipeliningTest : public ::testing::Test
+{
+protected:
+    struct outcome
+    {
+        std::string               name{};
+        boost::system::error_code ec{};
+        std::string               body{};
+    };
+
+    void SetUp() override
+    {
+        // a client that stops pipelining would leave the server waiting for the rest of a batch until this passes
+        _client = RestClient::create(
+            _ioc, {.max_connections_per_origin = 1, .pipeline_depth = 4, .request_timeout = 3s});
+    }
+
+    void TearDown() override { _client.reset(); }
+
+    /**
+     * Sends a request to /name; POST sends name as its body. The server answers with the request's target.
+     */
+    template<http::verb Verb>
+    std::future<void> submit(const loopback_http_server& server, std::string name)
+    {
+        return net::co_spawn(
+            _ioc,
+            [this, &server, name]() -> net::awaitable<void>
+            {
+                const std::string url{server.url("/" + name)};
+                if constexpr (Verb == http::verb::post)
+                {
+                    auto [ec, response] = co_await _client->request<Verb>(url, {}, name);
+                    _outcomes.push_back({name, ec, response.body()});
+                }
+                else
+                {
+                    auto [ec, response] = co_await _client->request<Verb>(url);
+                    _outcomes.push_back({name, ec, response.body()});
+                }
+            },
+            net::use_future);
+    }
+
+    /**
+     * Reads the next request on connection and records its target; runs on the server's thread.
+     */
+    net::awaitable<std::string> receive(const std::size_t connection, loopback_http_server::peer& client)
+    {
+        const auto request{co_await client.read()};
+        if (_arrivals.size() <= connection)
+        {
+            _arrivals.resize(connection + 1);
+        }
+        _arrivals[connection].emplace_back(request.target());
+        co_return std::string{request.target()};
+    }
+
+    /**
+     * Reads the next request on connection and answers it with its target.
+     */
+    net::awaitable<void> echo(const std::size_t connection, loopback_http_server::peer& client)
+    {
+        auto target{co_await receive(connection, client)};
+        co_await client.respond(http::status::ok, std::move(target));
+    }
+
+    void run(std::vector<std::future<void>>& futures)
+    {
+        _ioc.run();
+        for (auto& future : futures)
+        {
+            EXPECT_NO_THROW(future.get());
+        }
+    }
+
+    boost::asio::io_context     _ioc{};
+    std::shared_ptr<RestClient> _client;
+    std::vector<outcome>        _outcomes{};
+
+    // targets each server connection received, in arrival order
+    std::vector<std::vector<std::string>> _arrivals{};
+};
+
+TEST_F(AsyncRestClientPipeliningTest, BatchIsWrittenBeforeFirstResponseIsRead)
+{
+    loopback_http_server server{
+        1,
+        [this](const std::size_t connection, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            // the first request goes out alone, as nothing else is queued yet
+            co_await echo(connection, client);
+
+            // the other four are queued behind it and pipelined; none is answered before all of them arrived
+            std::vector<std::string> batch{};
+            for (int i = 0; i < 4; ++i)
+            {
+                batch.push_back(co_await receive(connection, client));
+            }
+            for (auto& target : batch)
+            {
+                co_await client.respond(http::status::ok, std::move(target));
+            }
+        }};
+
+    std::vector<std::future<void>> futures{};
+    std::vector<std::string>       names{};
+    for (int i = 0; i < 5; ++i)
+    {
+        names.push_back("cancel" + std::to_string(i));
+        futures.push_back(submit<http::verb::delete_>(server, names.back()));
+    }
+    run(futures);
+
+    ASSERT_TRUE(server.wait_for(1s));
+    ASSERT_EQ(_arrivals.size(), 1u);
+    ASSERT_EQ(_arrivals[0].size(), 5u);
+    ASSERT_EQ(_outcomes.size(), 5u);
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        EXPECT_EQ(_arrivals[0][i], "/" + names[i]);
+
+        // responses are matched to requests first in, first out, and completed in that order
+        EXPECT_EQ(_outcomes[i].name, names[i]);
+        EXPECT_FALSE(_outcomes[i].ec) << names[i] << " failed: " << _outcomes[i].ec.message();
+        EXPECT_EQ(_outcomes[i].body, "/" + names[i]);
+    }
+}
+
+TEST_F(AsyncRestClientPipeliningTest, NonIdempotentRequestEndsBatch)
+{
+    bool is_quiet_after_post{false};
+
+    loopback_http_server server{
+        1,
+        [this, &is_quiet_after_post](
+            const std::size_t connection, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            co_await echo(connection, client);
+
+            // second and order are pipelined; third must not be, as order could not be resent if the server closed
+            auto second{co_await receive(connection, client)};
+            auto order{co_await receive(connection, client)};
+            is_quiet_after_post = co_await client.stays_quiet(200ms);
+            co_await client.respond(http::status::ok, std::move(second));
+            co_await client.respond(http::status::ok, std::move(order));
+
+            co_await echo(connection, client);
+        }};
+
+    std::vector<std::future<void>> futures{};
+    futures.push_back(submit<http::verb::get>(server, "first"));
+    futures.push_back(submit<http::verb::get>(server, "second"));
+    futures.push_back(submit<http::verb::post>(server, "order"));
+    futures.push_back(submit<http::verb::get>(server, "third"));
+    run(futures);
+
+    ASSERT_TRUE(server.wait_for(1s));
+    EXPECT_TRUE(is_quiet_after_post) << "a request was pipelined behind the POST";
+    EXPECT_EQ(_arrivals, (std::vector<std::vector<std::string>>{{"/first", "/second", "/order", "/third"}}));
+
+    ASSERT_EQ(_outcomes.size(), 4u);
+    for (const auto& [name, ec, body] : _outcomes)
+    {
+        EXPECT_FALSE(ec) << name << " failed: " << ec.message();
+        EXPECT_EQ(body, "/" + name);
+    }
+}
+
+TEST_F(AsyncRestClientPipeliningTest, ClosingAfterPartialAnswerResendsOnlyIdempotentRequests)
+{
+    bool is_serial_after_close{false};
+
+    loopback_http_server server{
+        2,
+        [this, &is_serial_after_close](
+            const std::size_t connection, loopback_http_server::peer& client) -> net::awaitable<void>
+        {
+            if (connection == 0)
+            {
+                co_await echo(connection, client);
+
+                // answers the first request of the batch [a, b, order], then closes like a server that does not
+                // pipeline; every request is read first, so the close is not a reset that could lose the answer
+                auto a{co_await receive(connection, client)};
+                co_await receive(connection, client);
+                co_await receive(connection, client);
+                co_await client.respond(http::status::ok, std::move(a));
+                co_return;
+            }
+
+            // b is resent, c was queued behind the batch; the origin no longer gets them pipelined
+            auto b{co_await receive(connection, client)};
+            is_serial_after_close = co_await client.stays_quiet(200ms);
+            co_await client.respond(http::status::ok, std::move(b));
+            co_await echo(connection, client);
+        }};
+
+    std::vector<std::future<void>> futures{};
+    futures.push_back(submit<http::verb::get>(server, "first"));
+    futures.push_back(submit<http::verb::get>(server, "a"));
+    futures.push_back(submit<http::verb::get>(server, "b"));
+    futures.push_back(submit<http::verb::post>(server, "order"));
+    futures.push_back(submit<http::verb::get>(server, "c"));
+    run(futures);
+
+    ASSERT_TRUE(server.wait_for(1s));
+    EXPECT_TRUE(is_serial_after_close) << "the origin is still pipelined after it closed a pipelined connection";
+    EXPECT_EQ(_arrivals, (std::vector<std::vector<std::string>>{{"/first", "/a", "/b", "/order"}, {"/b", "/c"}}))
+        << "only the idempotent requests that got no answer may be resent";
+
+    // order fails as soon as the connection closes; the others complete once they were resent
+    ASSERT_EQ(_outcomes.size(), 5u);
+    std::vector<std::string> completed{};
+    for (const auto& [name, ec, body] : _outcomes)
+    {
+        completed.push_back(name);
+        if (name == "order")
+        {
+            EXPECT_TRUE(ec) << "the POST got no response and must not be resent";
+            continue;
+        }
+        EXPECT_FALSE(ec) << name << " failed: " << ec.message();
+        EXPECT_EQ(body, "/" + name);
+    }
+    EXPECT_EQ(completed, (std::vector<std::string>{"first", "a", "order", "b", "c"}));
+}
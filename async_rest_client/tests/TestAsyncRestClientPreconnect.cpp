@@ -0,0 +1,84 @@
+#include "async_rest_client/async_rest_client.hpp"
+#include "my_logger.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_future.hpp>
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace net    = boost::asio;
+namespace http   = boost::beast::http;
+using RestClient = async_rest_client::async_rest_client;
+
+// preconnect() keeps a keepalive timer running, so each test destroys the client to let the io_context finish
+class AsyncRestClientPreconnectTest : public ::testing::Test
+{
+protected:
+    void TearDown() override { _client.reset(); }
+
+    boost::asio::io_context     _ioc{};
+    std::shared_ptr<RestClient> _client;
+};
+
+TEST_F(AsyncRestClientPreconnectTest, SecondConnectionResumesTlsSession)
+{
+    _client = RestClient::create(_ioc);
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this]() -> net::awaitable<void>
+        {
+            const auto ec = co_await _client->preconnect("https://httpbin.org", 2);
+            EXPECT_FALSE(ec) << "preconnect failed: " << ec.message();
+
+            const auto& sessions{_client->tls_sessions()};
+            EXPECT_EQ(sessions.full_handshakes(), 1u);
+            EXPECT_EQ(sessions.resumed_handshakes(), 1u);
+
+            // served by a warm connection: no further handshake
+            auto [request_ec, response] = co_await _client->request<http::verb::get>("https://httpbin.org/get");
+            EXPECT_FALSE(request_ec) << "GET failed: " << request_ec.message();
+            EXPECT_EQ(response.result(), http::status::ok);
+            EXPECT_EQ(sessions.full_handshakes() + sessions.resumed_handshakes(), 2u);
+
+            _client.reset();
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
+
+TEST_F(AsyncRestClientPreconnectTest, ExpiredConnectionsAreReplacedInBackground)
+{
+    _client = RestClient::create(
+        _ioc, {.idle_timeout = std::chrono::seconds{1}, .keepalive_interval = std::chrono::seconds{1}});
+
+    auto future = net::co_spawn(
+        _ioc,
+        [this]() -> net::awaitable<void>
+        {
+            const auto ec = co_await _client->preconnect("https://httpbin.org");
+            EXPECT_FALSE(ec) << "preconnect failed: " << ec.message();
+
+            net::steady_timer timer{_ioc};
+            timer.expires_after(std::chrono::milliseconds{2500});
+            co_await timer.async_wait(net::use_awaitable);
+
+            // the first connection expired and was replaced by one resuming its TLS session
+            const auto& sessions{_client->tls_sessions()};
+            EXPECT_EQ(sessions.full_handshakes(), 1u);
+            EXPECT_GE(sessions.resumed_handshakes(), 1u);
+
+            auto [request_ec, response] = co_await _client->request<http::verb::get>("https://httpbin.org/get");
+            EXPECT_FALSE(request_ec) << "GET failed: " << request_ec.message();
+            EXPECT_EQ(response.result(), http::status::ok);
+
+            _client.reset();
+        },
+        net::use_future);
+
+    _ioc.run();
+    EXPECT_NO_THROW(future.get());
+}
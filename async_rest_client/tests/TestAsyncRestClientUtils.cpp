@@ -1,6 +1,7 @@
 #include "async_rest_client/utils.hpp"
 #include "my_logger.hpp"
 
+#include <boost/beast/version.hpp>
 #include <gtest/gtest.h>
 #include <stdexcept>
 
@@ -111,4 +112,46 @@ TEST_F(AsyncRestClientUtilsTest, MakeHttpHttpsUrl_HttpsUrlWithPath)
     EXPECT_EQ(result.path(), "/api/v1");
 }
 
+TEST_F(AsyncRestClientUtilsTest, SerializeRequest_PostWithHeaderBlock)
+{
+    http::fields headers{};
+    headers.set(http::field::content_type, "application/json");
+    headers.set(http::field::connection, "close");
+
+    std::string out{"stale content"};
+    serialize_request(
+        out,
+        http::verb::post,
+        make_http_https_url("https://paper-api.alpaca.markets/v2/orders"),
+        headers,
+        "APCA-API-KEY-ID: key\r\n",
+        R"({"qty":1})");
+
+    EXPECT_EQ(
+        out,
+        "POST /v2/orders HTTP/1.1\r\n"
+        "Host: paper-api.alpaca.markets\r\n"
+        "User-Agent: " BOOST_BEAST_VERSION_STRING "\r\n"
+        "Content-Type: application/json\r\n"
+        "APCA-API-KEY-ID: key\r\n"
+        "Connection: keep-alive\r\n"
+        "Content-Length: 9\r\n"
+        "\r\n"
+        R"({"qty":1})");
+}
+
+TEST_F(AsyncRestClientUtilsTest, SerializeRequest_GetWithoutPath)
+{
+    std::string out{};
+    serialize_request(out, http::verb::get, make_http_https_url("http://example.com"), {}, {}, {});
+
+    EXPECT_EQ(
+        out,
+        "GET / HTTP/1.1\r\n"
+        "Host: example.com\r\n"
+        "User-Agent: " BOOST_BEAST_VERSION_STRING "\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n");
+}
+
 } // namespace async_rest_client
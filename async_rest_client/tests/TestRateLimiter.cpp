@@ -0,0 +1,105 @@
+#include "async_rest_client/rate_limiter.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+
+using async_rest_client::rate_limiter;
+using async_rest_client::request_priority;
+using namespace std::chrono_literals;
+namespace http = boost::beast::http;
+
+class RateLimiterTest : public ::testing::Test
+{
+protected:
+    const rate_limiter::clock::time_point _start{rate_limiter::clock::now()};
+};
+
+TEST_F(RateLimiterTest, DisabledLimiterNeverDelays)
+{
+    rate_limiter limiter{{}, _start};
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(limiter.try_acquire(request_priority::low, _start));
+    }
+}
+
+TEST_F(RateLimiterTest, BudgetRefillsOverPeriod)
+{
+    rate_limiter limiter{{.requests_per_period = 60, .period = 60s}, _start};
+    for (int i = 0; i < 60; ++i)
+    {
+        EXPECT_TRUE(limiter.try_acquire(request_priority::normal, _start));
+    }
+    EXPECT_FALSE(limiter.try_acquire(request_priority::high, _start));
+
+    // one token per second
+    EXPECT_EQ(limiter.next_available(request_priority::normal, _start), _start + 1s);
+    EXPECT_FALSE(limiter.try_acquire(request_priority::normal, _start + 500ms));
+    EXPECT_TRUE(limiter.try_acquire(request_priority::normal, _start + 1s));
+}
+
+TEST_F(RateLimiterTest, ReserveIsKeptForHighPriority)
+{
+    rate_limiter limiter{{.requests_per_period = 10, .period = 10s, .high_priority_reserve = 3}, _start};
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_TRUE(limiter.try_acquire(request_priority::low, _start));
+    }
+    EXPECT_FALSE(limiter.try_acquire(request_priority::low, _start));
+    EXPECT_FALSE(limiter.try_acquire(request_priority::normal, _start));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(limiter.try_acquire(request_priority::high, _start));
+    }
+    EXPECT_FALSE(limiter.try_acquire(request_priority::high, _start));
+
+    // low priority waits until the reserve is refilled and one token more is available
+    EXPECT_EQ(limiter.next_available(request_priority::high, _start), _start + 1s);
+    EXPECT_EQ(limiter.next_available(request_priority::low, _start), _start + 4s);
+}
+
+TEST_F(RateLimiterTest, RetryAfterBlocksEveryPriority)
+{
+    rate_limiter limiter{{}, _start};
+    limiter.update({.retry_after = 2s}, _start);
+
+    EXPECT_FALSE(limiter.try_acquire(request_priority::high, _start + 1s));
+    EXPECT_EQ(limiter.next_available(request_priority::high, _start), _start + 2s);
+    EXPECT_TRUE(limiter.try_acquire(request_priority::low, _start + 2s));
+}
+
+TEST_F(RateLimiterTest, ServerRemainingLowersTokens)
+{
+    rate_limiter limiter{{.requests_per_period = 100, .period = 60s, .high_priority_reserve = 10}, _start};
+    limiter.update({.remaining = 10}, _start);
+
+    EXPECT_DOUBLE_EQ(limiter.tokens(_start), 10.0);
+    EXPECT_FALSE(limiter.try_acquire(request_priority::low, _start));
+    EXPECT_TRUE(limiter.try_acquire(request_priority::high, _start));
+
+    // a higher count than the client's own never raises the budget
+    limiter.update({.remaining = 50}, _start);
+    EXPECT_DOUBLE_EQ(limiter.tokens(_start), 9.0);
+}
+
+TEST_F(RateLimiterTest, ParsesRateLimitHeaders)
+{
+    http::fields headers{};
+    headers.set("X-RateLimit-Limit", "200");
+    headers.set("X-RateLimit-Remaining", "17");
+    headers.set("X-RateLimit-Reset", "1700000000");
+    headers.set(http::field::retry_after, "3");
+
+    const auto ok{async_rest_client::parse_rate_limit_feedback(http::status::ok, headers)};
+    EXPECT_EQ(ok.remaining, 17u);
+    EXPECT_EQ(ok.reset, std::chrono::system_clock::time_point{1700000000s});
+    // Retry-After only means "throttled" on 429 and 503
+    EXPECT_FALSE(ok.retry_after);
+
+    const auto throttled{async_rest_client::parse_rate_limit_feedback(http::status::too_many_requests, headers)};
+    EXPECT_EQ(throttled.retry_after, 3s);
+
+    headers.set(http::field::retry_after, "Wed, 21 Oct 2015 07:28:00 GMT");
+    EXPECT_FALSE(async_rest_client::parse_rate_limit_feedback(http::status::too_many_requests, headers).retry_after);
+}
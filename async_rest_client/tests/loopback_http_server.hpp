@@ -0,0 +1,148 @@
+#pragma once
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace async_rest_client::test
+{
+
+namespace net   = boost::asio;
+namespace beast = boost::beast;
+namespace http  = beast::http;
+
+/**
+ * Plain HTTP/1.1 server on a loopback port for tests that need to control the peer: it accepts a fixed number of
+ * connections one after another and runs a script coroutine on each. Returning from the script (or throwing) closes
+ * the connection, the way a server that drops a keep-alive connection does; a script should read every request the
+ * client sent before it returns, or the close turns into a reset that can discard responses already written.
+ *
+ * The server runs on its own thread; scripts touch test state from that thread, so read it only after wait_for().
+ */
+class loopback_http_server
+{
+public:
+    using request = http::request<http::string_body>;
+
+    /**
+     * Server side of one accepted connection.
+     */
+    class peer
+    {
+    public:
+        explicit peer(net::ip::tcp::socket socket)
+            : _stream{std::move(socket)}
+        {
+        }
+
+        /**
+         * Reads the next request; requests the client pipelined are read from the buffer without waiting.
+         */
+        net::awaitable<request> read()
+        {
+            request req{};
+            co_await http::async_read(_stream, _buffer, req, net::use_awaitable);
+            co_return req;
+        }
+
+        /**
+         * Writes a keep-alive response.
+         */
+        net::awaitable<void> respond(const http::status status, std::string body, const http::fields& headers = {})
+        {
+            http::response<http::string_body> res{status, 11};
+            for (const auto& field : headers)
+            {
+                res.set(field.name_string(), field.value());
+            }
+            res.keep_alive(true);
+            res.body() = std::move(body);
+            res.prepare_payload();
+            co_await http::async_write(_stream, res, net::use_awaitable);
+        }
+
+        /**
+         * @return true if the client sent nothing more within period
+         */
+        net::awaitable<bool> stays_quiet(const std::chrono::milliseconds period)
+        {
+            net::steady_timer timer{co_await net::this_coro::executor, period};
+            co_await timer.async_wait(net::use_awaitable);
+            co_return _buffer.size() == 0 && _stream.socket().available() == 0;
+        }
+
+    private:
+        beast::tcp_stream  _stream;
+        beast::flat_buffer _buffer{};
+    };
+
+    using script = std::function<net::awaitable<void>(std::size_t connection, peer& client)>;
+
+    loopback_http_server(const std::size_t connections, script on_connection)
+        : _script{std::move(on_connection)}
+    {
+        net::co_spawn(_ioc, serve(connections), [this](const std::exception_ptr&) { _done.set_value(); });
+        _thread = std::thread{[this] { _ioc.run(); }};
+    }
+
+    ~loopback_http_server()
+    {
+        _ioc.stop();
+        _thread.join();
+    }
+
+    loopback_http_server(const loopback_http_server&)            = delete;
+    loopback_http_server& operator=(const loopback_http_server&) = delete;
+
+    [[nodiscard]]
+    std::string url(const std::string_view target) const
+    {
+        return "http://127.0.0.1:" + std::to_string(_acceptor.local_endpoint().port()) + std::string{target};
+    }
+
+    /**
+     * @return true once every connection has been served; false if that did not happen within timeout
+     */
+    [[nodiscard]]
+    bool wait_for(const std::chrono::milliseconds timeout)
+    {
+        return _done_future.wait_for(timeout) == std::future_status::ready;
+    }
+
+private:
+    net::awaitable<void> serve(const std::size_t connections)
+    {
+        for (std::size_t connection = 0; connection < connections; ++connection)
+        {
+            peer client{co_await _acceptor.async_accept(net::use_awaitable)};
+            try
+            {
+                co_await _script(connection, client);
+            }
+            catch (const boost::system::system_error&)
+            {
+                // the client went away; the script is done with this connection either way
+            }
+        }
+    }
+
+    net::io_context        _ioc{};
+    net::ip::tcp::acceptor _acceptor{_ioc, {net::ip::address_v4::loopback(), 0}};
+    script                 _script;
+    std::promise<void>     _done{};
+    std::future<void>      _done_future{_done.get_future()};
+    std::thread            _thread{};
+};
+
+} // namespace async_rest_client::test
@@ -0,0 +1,103 @@
+#include "AlpacaMessageParser.hpp"
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+#include "Utils.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * Parse throughput of a minute-boundary bar burst: AlpacaMessageParser against the nlohmann DOM path the feed used
+ * before. Prints messages/second for each; pass the number of bars per frame as the first argument.
+ */
+
+namespace
+{
+
+std::string makeBarFrame(const std::size_t bars)
+{
+    std::string frame{"["};
+    for (std::size_t i = 0; i < bars; ++i)
+    {
+        if (i > 0)
+        {
+            frame += ',';
+        }
+        const std::string price{std::to_string(100 + i % 400) + "." + std::to_string(10 + i % 89)};
+        frame += R"({"T":"b","S":"SYM)" + std::to_string(i) + R"(","o":)" + price + R"(,"h":)" + price + R"(,"l":)"
+               + price + R"(,"c":)" + price + R"(,"v":)" + std::to_string(1000 + i)
+               + R"(,"t":"2025-05-19T13:30:00Z","n":42,"vw":)" + price + "}";
+    }
+    frame += ']';
+    return frame;
+}
+
+// the feed's previous frame handler: DOM parse, then copy the fields out of every bar message
+std::size_t parseWithNlohmann(const std::string& frame, double& checksum)
+{
+    std::size_t bars{0};
+    for (const auto& message : nlohmann::json::parse(frame))
+    {
+        if (const std::string type = message["T"]; type != "b")
+        {
+            continue;
+        }
+
+        const Bar1min bar{
+            SymbolTable::intern(message["S"].get_ref<const nlohmann::json::string_t&>()),
+            message["o"].get<double>(),
+            message["h"].get<double>(),
+            message["l"].get<double>(),
+            message["c"].get<double>(),
+            message["v"].get<std::uint64_t>(),
+            parseRFC3339UTCTimestamp(message["t"].get<std::string>())};
+        checksum += bar.close();
+        ++bars;
+    }
+    return bars;
+}
+
+template<typename ParseFrame>
+void report(const char* name, const std::size_t messages_per_frame, ParseFrame&& parse_frame)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr auto min_duration{std::chrono::seconds{1}};
+    std::size_t    messages{0};
+    const auto     start{clock::now()};
+    while (clock::now() - start < min_duration)
+    {
+        messages += parse_frame();
+    }
+    const std::chrono::duration<double> elapsed{clock::now() - start};
+
+    if (messages % messages_per_frame != 0)
+    {
+        std::cerr << name << ": dropped messages\n";
+    }
+    std::cout << name << ": " << static_cast<double>(messages) / elapsed.count() << " messages/s\n";
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const std::size_t bars_per_frame{argc > 1 ? std::stoul(argv[1]) : 2000};
+    const std::string frame{makeBarFrame(bars_per_frame)};
+    std::cout << "frame: " << bars_per_frame << " bars, " << frame.size() << " bytes\n";
+
+    double checksum{0.0};
+
+    report("nlohmann::json", bars_per_frame, [&] { return parseWithNlohmann(frame, checksum); });
+
+    const AlpacaMessageParser parser{{.on_bar = [&checksum](const Bar1min& bar) { checksum += bar.close(); }}};
+    report("AlpacaMessageParser", bars_per_frame, [&] { return parser.parse(frame); });
+
+    // keeps the parsed values observable so the loops are not optimized away
+    std::cout << "checksum: " << checksum << '\n';
+    return 0;
+}
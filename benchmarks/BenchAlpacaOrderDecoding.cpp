@@ -0,0 +1,173 @@
+#include "alpaca_trade_client/orders.hpp"
+
+#include <boost/json.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Decode throughput of a get_all_orders() response: the single-pass order decoder over an arena-allocated document
+ * against the contains()/at() lookups json_utils.cpp used before. Prints orders/second for each; pass the number of
+ * orders in the response as the first argument.
+ */
+
+namespace json = boost::json;
+
+namespace
+{
+
+std::string makeOrdersBody(const std::size_t orders)
+{
+    std::string body{"["};
+    for (std::size_t i = 0; i < orders; ++i)
+    {
+        if (i > 0)
+        {
+            body += ',';
+        }
+        const std::string n{std::to_string(i)};
+        // every fifth order is a bracket with its take-profit leg nested the way Alpaca returns it
+        const std::string legs{
+            i % 5 == 0 ? R"([{"id":"leg-)" + n + R"(","client_order_id":"leg-coid-)" + n
+                             + R"(","created_at":"2025-06-19T14:30:00.000Z","asset_id":"asset-)" + n
+                             + R"(","symbol":"SYM)" + n + R"(","asset_class":"us_equity","filled_qty":"0",)"
+                             + R"("order_class":"bracket","order_type":"limit","side":"sell","time_in_force":"gtc",)"
+                             + R"("limit_price":"210.5","status":"new","extended_hours":false,"legs":null}])"
+                       : std::string{"null"}};
+        body += R"({"id":"order-)" + n + R"(","client_order_id":"coid-)" + n
+              + R"(","created_at":"2025-06-19T14:30:00.000Z","updated_at":"2025-06-19T14:30:01.000Z",)"
+              + R"("submitted_at":"2025-06-19T14:30:00.100Z","filled_at":"2025-06-19T14:30:00.200Z",)"
+              + R"("expired_at":null,"canceled_at":null,"failed_at":null,"replaced_at":null,"replaced_by":null,)"
+              + R"("replaces":null,"asset_id":"asset-)" + n + R"(","symbol":"SYM)" + n
+              + R"(","asset_class":"us_equity","notional":null,"qty":"10","filled_qty":"10",)"
+              + R"("filled_avg_price":"201.37","order_class":")" + (i % 5 == 0 ? "bracket" : "simple")
+              + R"(","order_type":"market","type":"market","side":"buy","time_in_force":"day","limit_price":null,)"
+              + R"("stop_price":null,"status":"filled","extended_hours":false,"legs":)" + legs
+              + R"(,"trail_percent":null,"trail_price":null,"hwm":null,"subtag":null,"source":null,)"
+              + R"("position_intent":"buy_to_open"})";
+    }
+    body += ']';
+    return body;
+}
+
+// the previous decoder: every optional field is probed with contains() and looked up again with at()
+order decodeWithLookups(const json::value& jv)
+{
+    const auto& obj = jv.as_object();
+    order       o;
+
+    o.id                 = json::value_to<std::string>(obj.at("id"));
+    o.client_order_id    = json::value_to<std::string>(obj.at("client_order_id"));
+    o.created_at         = json::value_to<std::string>(obj.at("created_at"));
+    o.asset_id           = json::value_to<std::string>(obj.at("asset_id"));
+    o.symbol             = json::value_to<std::string>(obj.at("symbol"));
+    o.asset_class_type   = json::value_to<asset_class>(obj.at("asset_class"));
+    o.filled_qty         = json::value_to<std::string>(obj.at("filled_qty"));
+    o.order_class_type   = json::value_to<order_class>(obj.at("order_class"));
+    o.type               = json::value_to<order_type>(obj.at("order_type"));
+    o.side               = json::value_to<order_side>(obj.at("side"));
+    o.time_in_force_type = json::value_to<time_in_force>(obj.at("time_in_force"));
+    o.status             = json::value_to<order_status>(obj.at("status"));
+    o.extended_hours     = json::value_to<bool>(obj.at("extended_hours"));
+
+    for (auto [key, field] : {std::pair{"updated_at", &order::updated_at},
+                              std::pair{"submitted_at", &order::submitted_at},
+                              std::pair{"filled_at", &order::filled_at},
+                              std::pair{"expired_at", &order::expired_at},
+                              std::pair{"canceled_at", &order::canceled_at},
+                              std::pair{"failed_at", &order::failed_at},
+                              std::pair{"replaced_at", &order::replaced_at},
+                              std::pair{"replaced_by", &order::replaced_by},
+                              std::pair{"replaces", &order::replaces},
+                              std::pair{"notional", &order::notional},
+                              std::pair{"qty", &order::qty},
+                              std::pair{"filled_avg_price", &order::filled_avg_price},
+                              std::pair{"limit_price", &order::limit_price},
+                              std::pair{"stop_price", &order::stop_price},
+                              std::pair{"trail_percent", &order::trail_percent},
+                              std::pair{"trail_price", &order::trail_price},
+                              std::pair{"hwm", &order::hwm}})
+    {
+        if (obj.contains(key) && !obj.at(key).is_null())
+        {
+            o.*field = json::value_to<std::string>(obj.at(key));
+        }
+    }
+
+    if (obj.contains("position_intent") && !obj.at("position_intent").is_null())
+    {
+        o.position_intent_type = json::value_to<position_intent>(obj.at("position_intent"));
+    }
+    if (obj.contains("legs") && !obj.at("legs").is_null())
+    {
+        std::vector<order> legs;
+        for (const auto& leg : obj.at("legs").as_array())
+        {
+            legs.push_back(decodeWithLookups(leg));
+        }
+        o.legs = std::move(legs);
+    }
+
+    return o;
+}
+
+std::size_t decodeWithLookups(const std::string& body, std::size_t& checksum)
+{
+    std::vector<order> orders;
+    for (const auto& jv : json::parse(body).as_array())
+    {
+        orders.push_back(decodeWithLookups(jv));
+    }
+    checksum += orders.back().symbol.size();
+    return orders.size();
+}
+
+// what alpaca_trade_client does per response
+std::size_t decodeSinglePass(const std::string& body, std::size_t& checksum)
+{
+    json::monotonic_resource arena{body.size()};
+    const auto               orders{json::value_to<std::vector<order>>(json::parse(body, &arena))};
+    checksum += orders.back().symbol.size();
+    return orders.size();
+}
+
+template<typename Decode>
+void report(const char* name, const std::size_t orders_per_body, Decode&& decode)
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr auto min_duration{std::chrono::seconds{1}};
+    std::size_t    orders{0};
+    const auto     start{clock::now()};
+    while (clock::now() - start < min_duration)
+    {
+        orders += decode();
+    }
+    const std::chrono::duration<double> elapsed{clock::now() - start};
+
+    if (orders % orders_per_body != 0)
+    {
+        std::cerr << name << ": dropped orders\n";
+    }
+    std::cout << name << ": " << static_cast<double>(orders) / elapsed.count() << " orders/s\n";
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const std::size_t orders_per_body{argc > 1 ? std::stoul(argv[1]) : 500};
+    const std::string body{makeOrdersBody(orders_per_body)};
+    std::cout << "body: " << orders_per_body << " orders, " << body.size() << " bytes\n";
+
+    std::size_t checksum{0};
+
+    report("contains/at lookups", orders_per_body, [&] { return decodeWithLookups(body, checksum); });
+    report("single-pass decoder", orders_per_body, [&] { return decodeSinglePass(body, checksum); });
+
+    // keeps the decoded orders observable so the loops are not optimized away
+    std::cout << "checksum: " << checksum << '\n';
+    return 0;
+}
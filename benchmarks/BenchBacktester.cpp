@@ -0,0 +1,31 @@
+#include "Backtester.hpp"
+#include "Bar.hpp"
+#include "CSVBarLoader.hpp"
+#include "SyntheticSessions.hpp"
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * Replay speed of the in-process Backtester. Pass a single-symbol bar CSV as the first argument, or nothing to replay
+ * a synthetic year of regular-hours 1-minute bars (252 sessions of 390 bars).
+ */
+
+int main(const int argc, char** argv)
+{
+    using namespace std::chrono;
+
+    const auto bars{
+        argc > 1 ? CSVBarLoader{}.load(argv[1]).to_bars()
+                 : makeSyntheticSessions("BENCH", 252, sys_days{2024y / January / 2} + 14h + 30min, 5, 0.0)};
+
+    Backtester<5, minutes> backtester{BacktestConfig{.starting_cash = 10'000.0}};
+    const auto             report{backtester.run(bars)};
+
+    std::cout << "replayed " << report.bars << " bars in " << report.seconds * 1e3 << " ms ("
+              << report.bars_per_second() << " bars/s)\n"
+              << "trades " << report.trades << " (" << report.winning_trades << " winning, "
+              << report.stopped_out_trades << " stopped out), return " << report.total_return() * 100.0
+              << "%, max drawdown " << report.max_drawdown * 100.0 << "%\n";
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "Bar.hpp"
+#include "CSVBarLoader.hpp"
+#include "Utils.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Load throughput for a bar CSV: CSVBarLoader against reading line by line with std::getline and
+ * createBarFromCSVLine. Pass the CSV path as the first argument and optionally the thread count as the second.
+ */
+
+namespace
+{
+
+std::vector<Bar1min> loadLineByLine(const std::string& csvPath)
+{
+    std::ifstream        file{csvPath};
+    std::string          line{};
+    std::vector<Bar1min> bars{};
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+        if (!line.empty())
+        {
+            bars.push_back(createBarFromCSVLine(line));
+        }
+    }
+    return bars;
+}
+
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <bars.csv> [threads]\n";
+        return 1;
+    }
+    const std::string csv_path{argv[1]};
+    const std::size_t threads{argc > 2 ? std::stoul(argv[2]) : 0};
+
+    const auto                          start{std::chrono::steady_clock::now()};
+    const auto                          baseline{loadLineByLine(csv_path)};
+    const std::chrono::duration<double> baseline_elapsed{std::chrono::steady_clock::now() - start};
+    std::cout << "getline + createBarFromCSVLine: "
+              << static_cast<double>(baseline.size()) / baseline_elapsed.count() << " rows/s\n";
+
+    CSVBarLoader loader{threads};
+    const auto   bars{loader.load(csv_path)};
+    const auto&  stats{loader.last_stats()};
+    std::cout << "CSVBarLoader: " << stats.rows_per_second() << " rows/s (" << stats.rows << " rows, "
+              << static_cast<double>(stats.bytes) / stats.seconds / 1e6 << " MB/s)\n";
+
+    return bars.size() == baseline.size() ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * Trade ("T": "t") from the Alpaca market data stream, timestamped to the nanosecond.
+ */
+struct AlpacaTrade
+{
+    SymbolId                                        symbol{};
+    double                                          price{};
+    std::uint64_t                                   size{};
+    std::chrono::sys_time<std::chrono::nanoseconds> timestamp{};
+};
+
+/**
+ * Quote ("T": "q") from the Alpaca market data stream.
+ */
+struct AlpacaQuote
+{
+    SymbolId                                        symbol{};
+    double                                          bid_price{};
+    std::uint64_t                                   bid_size{};
+    double                                          ask_price{};
+    std::uint64_t                                   ask_size{};
+    std::chrono::sys_time<std::chrono::nanoseconds> timestamp{};
+};
+
+/**
+ * Control message: "success" (msg "connected"/"authenticated"), "error" (code + msg) or "subscription". msg is a view
+ * into the frame and only valid during the callback.
+ */
+struct AlpacaControlMessage
+{
+    enum class Type
+    {
+        Success,
+        Error,
+        Subscription,
+    };
+
+    Type             type{};
+    std::string_view msg{};
+    int              code{};
+};
+
+/**
+ * Single-pass parser for Alpaca market data frames (a JSON array of messages).
+ *
+ * The frame is scanned once: the fields of each message object are recorded as views into the frame and the message
+ * is dispatched on its "T" field when the object closes, so no DOM is built and nothing is copied except the values
+ * handed to the callbacks. Minute bars ("b") are produced as Bar1min directly. Message types without a handler, and
+ * messages missing a required field, are skipped.
+ */
+class AlpacaMessageParser
+{
+public:
+    struct Handlers
+    {
+        std::function<void(const Bar1min&)>              on_bar{};
+        std::function<void(const AlpacaTrade&)>          on_trade{};
+        std::function<void(const AlpacaQuote&)>          on_quote{};
+        std::function<void(const AlpacaControlMessage&)> on_control{};
+    };
+
+    explicit AlpacaMessageParser(Handlers handlers);
+
+    /**
+     * @return number of messages dispatched to a handler
+     * @throws std::runtime_error if the frame is not a well-formed JSON array of objects
+     */
+    std::size_t parse(std::string_view frame) const;
+
+private:
+    Handlers _handlers;
+};
@@ -1,12 +1,12 @@
 #pragma once
 
+#include "AlpacaMessageParser.hpp"
 #include "Bar.hpp"
 #include "WebSocketSession.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/signals2.hpp>
 #include <memory>
-#include <nlohmann/json.hpp>
 #include <string>
 
 namespace asio = boost::asio;
@@ -46,16 +46,19 @@ public:
 private:
     void on_websocket_frame(std::string_view frame);
 
+    void emit_bar(const Bar1min& bar);
+
     void send_auth_message();
 
     void send_subscription_message();
 
-    void parse_bar_message(const nlohmann::json& message);
+    void on_control_message(const AlpacaControlMessage& message);
 
     asio::io_context&                 _ioc;
     config                            _config{};
     ssl::context                      _ssl_context;
     std::shared_ptr<WebSocketSession> _ws_session{};
+    AlpacaMessageParser               _parser;
 
     bar_signal_t             _bar_signal{};
     std::vector<std::string> _subscribed_symbols{};
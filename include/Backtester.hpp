@@ -0,0 +1,190 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "BarAggregator.hpp"
+#include "IndicatorEngine.hpp"
+#include "IndicatorSnapshot.hpp"
+#include "MACDStrategy.hpp"
+#include "SimulatedBroker.hpp"
+
+#include <boost/signals2.hpp>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+struct BacktestConfig
+{
+    double               starting_cash{100.0};
+    FillModel            fill_model{};
+    MACDStrategy::Params strategy{};
+};
+
+struct BacktestReport
+{
+    std::size_t bars{};
+    std::size_t aggregated_bars{};
+    std::size_t trades{};
+    std::size_t winning_trades{};
+    std::size_t stopped_out_trades{};
+    double      starting_cash{};
+    double      final_equity{};
+    double      max_drawdown{};
+    double      seconds{};
+
+    [[nodiscard]]
+    double total_return() const
+    {
+        return final_equity / starting_cash - 1.0;
+    }
+
+    [[nodiscard]]
+    double bars_per_second() const
+    {
+        return seconds > 0.0 ? static_cast<double>(bars) / seconds : 0.0;
+    }
+};
+
+/**
+ * Replays historical 1-minute bars of one symbol through the live pipeline, BarAggregator -> OHLCVIndicatorEngine ->
+ * MACDStrategy, with a SimulatedBroker standing in for the trading client.
+ *
+ * Each bar first goes to the broker, which fills orders decided on earlier bars, and then to the aggregator. A gap in
+ * the bars (overnight, halts) drops the aggregator's partial window, the same way StateCheckpointer does after missed
+ * bars; indicators carry across gaps as they would live.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class Backtester
+{
+public:
+    using AggregatedBar = Bar<Count, TimeUnit>;
+
+    explicit Backtester(const BacktestConfig& config = {});
+
+    /**
+     * Replays bars, which must be of one symbol and in time order. Successive calls continue the same session, so a
+     * long history can be fed in pieces (e.g. one BarArchive block decode at a time).
+     *
+     * @return report covering every bar replayed so far
+     * @throws std::runtime_error if bars are out of order
+     */
+    BacktestReport run(std::span<const Bar1min> bars);
+
+    [[nodiscard]]
+    BacktestReport report() const;
+
+    [[nodiscard]]
+    const SimulatedBroker& broker() const;
+
+private:
+    void on_aggregated_bar(const AggregatedBar& bar);
+
+    void on_snapshot(const IndicatorSnapshot& snapshot);
+
+    SimulatedBroker                       _broker;
+    BarAggregator<Count, TimeUnit>        _aggregator{};
+    OHLCVIndicatorEngine<Count, TimeUnit> _engine;
+    MACDStrategy                          _strategy;
+    boost::signals2::scoped_connection    _aggregator_connection{};
+    boost::signals2::scoped_connection    _engine_connection{};
+    std::optional<Bar1min>                _last_bar{};
+    double                                _last_aggregated_close{};
+    std::size_t                           _bars{};
+    std::size_t                           _aggregated_bars{};
+    std::chrono::duration<double>         _elapsed{};
+};
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+Backtester<Count, TimeUnit>::Backtester(const BacktestConfig& config)
+    : _broker{config.starting_cash, config.fill_model},
+      _engine{MACDStrategy::indicator_configs(config.strategy)},
+      _strategy{_engine.snapshot(), config.strategy}
+{
+    _aggregator_connection = _aggregator.subscribe([this](const AggregatedBar& bar) { on_aggregated_bar(bar); });
+    _engine_connection     = _engine.subscribe([this](const IndicatorSnapshot& snapshot) { on_snapshot(snapshot); });
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+BacktestReport Backtester<Count, TimeUnit>::run(const std::span<const Bar1min> bars)
+{
+    const auto start{std::chrono::steady_clock::now()};
+    for (const auto& bar : bars)
+    {
+        if (_last_bar.has_value())
+        {
+            if (bar.timestamp() <= _last_bar->timestamp() || bar.symbol() != _last_bar->symbol())
+            {
+                throw std::runtime_error{"Backtester: bars must be of one symbol and in time order"};
+            }
+            if (!isConsecutive(*_last_bar, bar))
+            {
+                _aggregator.reset();
+            }
+        }
+
+        _broker.on_bar(bar);
+        _aggregator.on_bar(bar);
+        _last_bar = bar;
+    }
+    _bars    += bars.size();
+    _elapsed += std::chrono::steady_clock::now() - start;
+    return report();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+BacktestReport Backtester<Count, TimeUnit>::report() const
+{
+    BacktestReport report{
+        .bars            = _bars,
+        .aggregated_bars = _aggregated_bars,
+        .trades          = _broker.trades().size(),
+        .starting_cash   = _broker.starting_cash(),
+        .final_equity    = _broker.equity(),
+        .max_drawdown    = _broker.max_drawdown(),
+        .seconds         = _elapsed.count()};
+    for (const auto& trade : _broker.trades())
+    {
+        report.winning_trades     += trade.pnl > 0.0 ? 1 : 0;
+        report.stopped_out_trades += trade.stopped_out ? 1 : 0;
+    }
+    return report;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+const SimulatedBroker& Backtester<Count, TimeUnit>::broker() const
+{
+    return _broker;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void Backtester<Count, TimeUnit>::on_aggregated_bar(const AggregatedBar& bar)
+{
+    ++_aggregated_bars;
+    _last_aggregated_close = bar.close();
+    _engine.on_bar(bar);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void Backtester<Count, TimeUnit>::on_snapshot(const IndicatorSnapshot& snapshot)
+{
+    const auto decision{_strategy.on_snapshot(snapshot, _last_aggregated_close, _broker.is_long())};
+    switch (decision.action)
+    {
+        case MACDStrategy::Action::Buy:
+            _broker.submit_buy(decision.stop_distance);
+            break;
+        case MACDStrategy::Action::Sell:
+            _broker.submit_sell();
+            break;
+        case MACDStrategy::Action::None:
+            break;
+    }
+}
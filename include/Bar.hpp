@@ -1,8 +1,12 @@
 #pragma once
 
+#include "SymbolTable.hpp"
+
 #include <chrono>
 #include <concepts>
-#include <string>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
 
 struct OHLCV
 {
@@ -31,32 +35,54 @@ public:
 
     static constexpr TimeUnit duration() { return TimeUnit{Count}; }
 
-    Bar(std::string symbol, const OHLCV& ohlcv, const Timestamp ts)
-        : _symbol{std::move(symbol)},
+    Bar(const SymbolId symbol, const OHLCV& ohlcv, const Timestamp ts)
+        : _symbol{symbol},
           _ohlcv{ohlcv},
           _timestamp{ts}
     {
     }
 
-    Bar(std::string     symbol,
+    Bar(const SymbolId  symbol,
         const double    open,
         const double    high,
         const double    low,
         const double    close,
         const uint64_t  volume,
         const Timestamp ts)
-        : _symbol{std::move(symbol)},
+        : _symbol{symbol},
           _ohlcv{open, high, low, close, volume},
           _timestamp{ts}
     {
     }
 
+    Bar(const std::string_view symbol, const OHLCV& ohlcv, const Timestamp ts)
+        : Bar{SymbolTable::intern(symbol), ohlcv, ts}
+    {
+    }
+
+    Bar(const std::string_view symbol,
+        const double           open,
+        const double           high,
+        const double           low,
+        const double           close,
+        const uint64_t         volume,
+        const Timestamp        ts)
+        : Bar{SymbolTable::intern(symbol), open, high, low, close, volume, ts}
+    {
+    }
+
     [[nodiscard]]
-    const std::string& symbol() const
+    SymbolId symbol() const
     {
         return _symbol;
     }
 
+    [[nodiscard]]
+    std::string_view symbol_name() const
+    {
+        return SymbolTable::name(_symbol);
+    }
+
     [[nodiscard]]
     const OHLCV& ohlcv() const
     {
@@ -107,9 +133,9 @@ public:
     }
 
 private:
-    std::string _symbol{};
-    OHLCV       _ohlcv{};
-    Timestamp   _timestamp{};
+    SymbolId  _symbol{};
+    OHLCV     _ohlcv{};
+    Timestamp _timestamp{};
 };
 
 template<std::size_t Count1, ChronoDuration TimeUnit1, std::size_t Count2, ChronoDuration TimeUnit2>
@@ -132,3 +158,5 @@ bool isConsecutive(const Bar<Count1, TimeUnit1>& left, const Bar<Count2, TimeUni
 using Bar1min = Bar<1, std::chrono::minutes>;
 using Bar5min = Bar<5, std::chrono::minutes>;
 using Bar1h   = Bar<1, std::chrono::hours>;
+
+static_assert(std::is_trivially_copyable_v<Bar1min>, "bars must stay cheap to copy through signals and buffers");
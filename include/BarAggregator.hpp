@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Bar.hpp"
+#include "StateSerialization.hpp"
 
 #include <boost/signals2.hpp>
+#include <optional>
 
 template<std::size_t Count, ChronoDuration TimeUnit>
     requires(Count > 0)
@@ -18,6 +20,23 @@ public:
 
     boost::signals2::connection subscribe(const aggregated_bar_signal_t::slot_type& handler);
 
+    /**
+     * Drops the partial window and the last seen bar, so the next input bar may have any timestamp.
+     */
+    void reset();
+
+    /**
+     * Writes the partial window and the last seen bar, for StateCheckpointer.
+     */
+    void save_state(StateWriter& writer) const;
+
+    /**
+     * Restores state written by save_state(); the next input bar must follow the saved last bar.
+     *
+     * @throws std::runtime_error if the state is corrupt
+     */
+    void load_state(StateReader& reader);
+
 private:
     void emit_aggregated_bar();
 
@@ -111,3 +130,50 @@ inline void BarAggregator<Count, TimeUnit>::emit_aggregated_bar()
         _aggregated_bar_signal(_current_aggregated_bar.value());
     }
 }
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline void BarAggregator<Count, TimeUnit>::reset()
+{
+    _current_aggregated_bar.reset();
+    _bars_in_current_window = 0;
+    _last_input_bar.reset();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline void BarAggregator<Count, TimeUnit>::save_state(StateWriter& writer) const
+{
+    writer.write(_bars_in_current_window);
+    writer.write(_current_aggregated_bar.has_value());
+    if (_current_aggregated_bar.has_value())
+    {
+        writer.write_bar(_current_aggregated_bar.value());
+    }
+    writer.write(_last_input_bar.has_value());
+    if (_last_input_bar.has_value())
+    {
+        writer.write_bar(_last_input_bar.value());
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline void BarAggregator<Count, TimeUnit>::load_state(StateReader& reader)
+{
+    const auto                   bars_in_current_window{reader.read<int>()};
+    std::optional<AggregatedBar> current_aggregated_bar{};
+    if (reader.read<bool>())
+    {
+        current_aggregated_bar = reader.read_bar<AggregatedBar>();
+    }
+    std::optional<Bar1min> last_input_bar{};
+    if (reader.read<bool>())
+    {
+        last_input_bar = reader.read_bar<Bar1min>();
+    }
+
+    _bars_in_current_window = bars_in_current_window;
+    _current_aggregated_bar = std::move(current_aggregated_bar);
+    _last_input_bar         = std::move(last_input_bar);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "BarColumns.hpp"
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Columnar binary archive of 1-minute bars, one block per symbol.
+ *
+ * A block stores open/high/low/close as float64 columns, volume as a uint64 column and timestamps as uint32 minute
+ * deltas from the block's first timestamp. Files are written in native byte order by writeBarArchive() (see
+ * tools/csv_to_bar_archive for converting the CSV layout) and read through a read-only mapping: price and volume
+ * columns are spans straight into the file, only timestamps are decoded.
+ */
+class BarArchive
+{
+public:
+    struct Block
+    {
+        std::string_view               symbol{};
+        Bar1min::Timestamp             first_timestamp{};
+        std::span<const double>        open{};
+        std::span<const double>        high{};
+        std::span<const double>        low{};
+        std::span<const double>        close{};
+        std::span<const std::uint64_t> volume{};
+        /** minutes since first_timestamp, one per bar */
+        std::span<const std::uint32_t> minute_offsets{};
+
+        [[nodiscard]]
+        std::size_t size() const
+        {
+            return open.size();
+        }
+
+        [[nodiscard]]
+        Bar1min::Timestamp timestamp(std::size_t row) const;
+    };
+
+    /**
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid archive
+     */
+    explicit BarArchive(const std::string& path);
+
+    [[nodiscard]]
+    std::span<const Block> blocks() const;
+
+    /**
+     * @return the block for symbol, or nullptr if the archive has none
+     */
+    [[nodiscard]]
+    const Block* find(std::string_view symbol) const;
+
+    /**
+     * Materializes a block as bars, reusing out's capacity; the result can be passed to anything taking
+     * std::span<const Bar1min> (e.g. WarmupBackfill::replay()).
+     */
+    static void decode(const Block& block, std::vector<Bar1min>& out);
+
+    /**
+     * @return every bar of the archive, block by block
+     */
+    [[nodiscard]]
+    BarColumns load() const;
+
+    [[nodiscard]]
+    std::size_t bar_count() const;
+
+private:
+    MappedFile         _file;
+    std::vector<Block> _blocks{};
+};
+
+/**
+ * Writes bars to path as a BarArchive, grouping rows by symbol (in order of first appearance) and keeping each
+ * symbol's row order.
+ *
+ * @throws std::invalid_argument if a symbol's timestamps are not strictly increasing
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeBarArchive(const std::string& path, const BarColumns& bars);
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Growable columnar table of 1-minute bars for any mix of symbols; row i of every column is one bar, in load order.
+ *
+ * This is the bulk-history counterpart of BarStore (which keeps a fixed window per symbol): loaders size the table
+ * once and fill rows in place, possibly from several threads writing disjoint rows, and backtests stream the columns.
+ */
+class BarColumns
+{
+public:
+    [[nodiscard]]
+    std::size_t size() const;
+
+    [[nodiscard]]
+    bool empty() const;
+
+    void resize(std::size_t rows);
+
+    void reserve(std::size_t rows);
+
+    void push_back(const Bar1min& bar);
+
+    /**
+     * Overwrites one row; rows are independent, so distinct rows may be set concurrently.
+     */
+    void set(std::size_t row, const Bar1min& bar);
+
+    [[nodiscard]]
+    Bar1min bar(std::size_t row) const;
+
+    [[nodiscard]]
+    std::vector<Bar1min> to_bars() const;
+
+    [[nodiscard]]
+    std::span<const SymbolId> symbols() const;
+
+    [[nodiscard]]
+    std::span<const Bar1min::Timestamp> timestamps() const;
+
+    [[nodiscard]]
+    std::span<const double> opens() const;
+
+    [[nodiscard]]
+    std::span<const double> highs() const;
+
+    [[nodiscard]]
+    std::span<const double> lows() const;
+
+    [[nodiscard]]
+    std::span<const double> closes() const;
+
+    [[nodiscard]]
+    std::span<const std::uint64_t> volumes() const;
+
+private:
+    std::vector<SymbolId>           _symbol{};
+    std::vector<Bar1min::Timestamp> _timestamp{};
+    std::vector<double>             _open{};
+    std::vector<double>             _high{};
+    std::vector<double>             _low{};
+    std::vector<double>             _close{};
+    std::vector<std::uint64_t>      _volume{};
+};
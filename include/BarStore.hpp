@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Fixed-capacity bar history for one symbol, stored column by column.
+ *
+ * Each column is a mirrored ring buffer: every value is written at slot i and slot i + capacity, so the most recent n
+ * values (n <= capacity) are always one contiguous span, oldest first. Rolling-window code can hand those spans
+ * straight to vectorized kernels without unwrapping the ring.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class BarSeries
+{
+public:
+    using BarType   = Bar<Count, TimeUnit>;
+    using Timestamp = typename BarType::Timestamp;
+
+    BarSeries(SymbolId symbol, std::size_t capacity);
+
+    void push(const BarType& bar);
+
+    [[nodiscard]]
+    SymbolId symbol() const;
+
+    [[nodiscard]]
+    std::size_t size() const;
+
+    [[nodiscard]]
+    std::size_t capacity() const;
+
+    [[nodiscard]]
+    bool empty() const;
+
+    /**
+     * @param age 0 for the most recent bar, 1 for the one before it, ...
+     */
+    [[nodiscard]]
+    BarType bar(std::size_t age = 0) const;
+
+    //
+    // Column windows: the last n values, oldest first
+
+    [[nodiscard]]
+    std::span<const double> opens(std::size_t n) const;
+
+    [[nodiscard]]
+    std::span<const double> highs(std::size_t n) const;
+
+    [[nodiscard]]
+    std::span<const double> lows(std::size_t n) const;
+
+    [[nodiscard]]
+    std::span<const double> closes(std::size_t n) const;
+
+    [[nodiscard]]
+    std::span<const uint64_t> volumes(std::size_t n) const;
+
+    [[nodiscard]]
+    std::span<const Timestamp> timestamps(std::size_t n) const;
+
+private:
+    template<typename T>
+    [[nodiscard]]
+    std::span<const T> window(const std::vector<T>& column, std::size_t n) const;
+
+    SymbolId    _symbol{};
+    std::size_t _capacity{};
+    std::size_t _size{};
+    std::size_t _head{};
+
+    std::vector<double>    _open{};
+    std::vector<double>    _high{};
+    std::vector<double>    _low{};
+    std::vector<double>    _close{};
+    std::vector<uint64_t>  _volume{};
+    std::vector<Timestamp> _timestamp{};
+};
+
+/**
+ * Per-symbol BarSeries table addressed by SymbolId. Subscribe it to an aggregator (or feed) to keep the last
+ * capacity_per_symbol bars of every symbol in columnar form.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class BarStore
+{
+public:
+    using BarType    = Bar<Count, TimeUnit>;
+    using SeriesType = BarSeries<Count, TimeUnit>;
+
+    explicit BarStore(std::size_t capacity_per_symbol);
+
+    void on_bar(const BarType& bar);
+
+    [[nodiscard]]
+    bool contains(SymbolId symbol) const;
+
+    [[nodiscard]]
+    const SeriesType& series(SymbolId symbol) const;
+
+    [[nodiscard]]
+    std::size_t capacity_per_symbol() const;
+
+private:
+    std::size_t                            _capacity_per_symbol{};
+    std::vector<std::optional<SeriesType>> _series{};
+};
+
+//
+// BarSeries implementation
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+BarSeries<Count, TimeUnit>::BarSeries(const SymbolId symbol, const std::size_t capacity)
+    : _symbol{symbol},
+      _capacity{capacity},
+      _open(2 * capacity),
+      _high(2 * capacity),
+      _low(2 * capacity),
+      _close(2 * capacity),
+      _volume(2 * capacity),
+      _timestamp(2 * capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument{"BarSeries capacity must be greater than zero"};
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void BarSeries<Count, TimeUnit>::push(const BarType& bar)
+{
+    const std::size_t mirror{_head + _capacity};
+
+    _open[_head] = _open[mirror] = bar.open();
+    _high[_head] = _high[mirror] = bar.high();
+    _low[_head] = _low[mirror] = bar.low();
+    _close[_head] = _close[mirror] = bar.close();
+    _volume[_head] = _volume[mirror] = bar.volume();
+    _timestamp[_head] = _timestamp[mirror] = bar.timestamp();
+
+    _head = _head + 1 == _capacity ? 0 : _head + 1;
+    if (_size < _capacity)
+    {
+        ++_size;
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+SymbolId BarSeries<Count, TimeUnit>::symbol() const
+{
+    return _symbol;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::size_t BarSeries<Count, TimeUnit>::size() const
+{
+    return _size;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::size_t BarSeries<Count, TimeUnit>::capacity() const
+{
+    return _capacity;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+bool BarSeries<Count, TimeUnit>::empty() const
+{
+    return _size == 0;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename BarSeries<Count, TimeUnit>::BarType BarSeries<Count, TimeUnit>::bar(const std::size_t age) const
+{
+    if (age >= _size)
+    {
+        throw std::out_of_range{"BarSeries::bar(): age exceeds stored history"};
+    }
+
+    const std::size_t i{_head + _capacity - 1 - age};
+    return BarType{_symbol, _open[i], _high[i], _low[i], _close[i], _volume[i], _timestamp[i]};
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const double> BarSeries<Count, TimeUnit>::opens(const std::size_t n) const
+{
+    return window(_open, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const double> BarSeries<Count, TimeUnit>::highs(const std::size_t n) const
+{
+    return window(_high, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const double> BarSeries<Count, TimeUnit>::lows(const std::size_t n) const
+{
+    return window(_low, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const double> BarSeries<Count, TimeUnit>::closes(const std::size_t n) const
+{
+    return window(_close, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const uint64_t> BarSeries<Count, TimeUnit>::volumes(const std::size_t n) const
+{
+    return window(_volume, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::span<const typename BarSeries<Count, TimeUnit>::Timestamp>
+    BarSeries<Count, TimeUnit>::timestamps(const std::size_t n) const
+{
+    return window(_timestamp, n);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+template<typename T>
+std::span<const T> BarSeries<Count, TimeUnit>::window(const std::vector<T>& column, const std::size_t n) const
+{
+    if (n > _size)
+    {
+        throw std::out_of_range{"BarSeries window exceeds stored history"};
+    }
+
+    return std::span<const T>{column}.subspan(_head + _capacity - n, n);
+}
+
+//
+// BarStore implementation
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+BarStore<Count, TimeUnit>::BarStore(const std::size_t capacity_per_symbol)
+    : _capacity_per_symbol{capacity_per_symbol}
+{
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void BarStore<Count, TimeUnit>::on_bar(const BarType& bar)
+{
+    const std::size_t slot{bar.symbol().value};
+    if (slot >= _series.size())
+    {
+        _series.resize(slot + 1);
+    }
+
+    auto& series{_series[slot]};
+    if (!series.has_value())
+    {
+        series.emplace(bar.symbol(), _capacity_per_symbol);
+    }
+    series->push(bar);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+bool BarStore<Count, TimeUnit>::contains(const SymbolId symbol) const
+{
+    return symbol.value < _series.size() && _series[symbol.value].has_value();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+const typename BarStore<Count, TimeUnit>::SeriesType& BarStore<Count, TimeUnit>::series(const SymbolId symbol) const
+{
+    if (!contains(symbol))
+    {
+        throw std::out_of_range{"BarStore has no history for " + std::string{SymbolTable::name(symbol)}};
+    }
+    return _series[symbol.value].value();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::size_t BarStore<Count, TimeUnit>::capacity_per_symbol() const
+{
+    return _capacity_per_symbol;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BarColumns.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * Bulk loader for the bar CSV layout written by test-utils/historical_bars_to_csv.py
+ * (symbol,timestamp,open,high,low,close,volume[,...] with a header line).
+ *
+ * The file is memory-mapped and split into one chunk per thread at line boundaries. A first parallel pass counts the
+ * rows of every chunk, which fixes each chunk's row offset in the output; the second pass parses the chunks in
+ * parallel with std::from_chars and writes every row straight into its slot of a presized BarColumns. Rows keep file
+ * order.
+ */
+class CSVBarLoader
+{
+public:
+    struct Stats
+    {
+        std::size_t rows{0};
+        std::size_t bytes{0};
+        double      seconds{0.0};
+
+        [[nodiscard]]
+        double rows_per_second() const
+        {
+            return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @param threads worker count; 0 uses std::thread::hardware_concurrency()
+     */
+    explicit CSVBarLoader(std::size_t threads = 0);
+
+    /**
+     * @throws std::runtime_error if the file cannot be read
+     * @throws std::invalid_argument on a malformed row (the message names the line)
+     */
+    [[nodiscard]]
+    BarColumns load(const std::string& csvPath);
+
+    /**
+     * Same as load(), over CSV text already in memory.
+     */
+    [[nodiscard]]
+    BarColumns parse(std::string_view csv);
+
+    /**
+     * @return rows, bytes and wall time of the most recent load()/parse()
+     */
+    [[nodiscard]]
+    const Stats& last_stats() const;
+
+private:
+    std::size_t _threads;
+    Stats       _last_stats{};
+};
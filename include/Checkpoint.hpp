@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Bar.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+/**
+ * One saved state of the trading pipeline: the serialized aggregator/indicator state after the 1-minute bar stamped
+ * last_bar_timestamp was processed.
+ */
+struct Checkpoint
+{
+    Bar1min::Timestamp     last_bar_timestamp{};
+    std::vector<std::byte> payload{};
+};
+
+/**
+ * Writes the checkpoint to path.tmp and renames it over path, so a crash mid-write never leaves a torn checkpoint.
+ * The file carries a magic, a format version and a checksum of the payload.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void saveCheckpoint(const std::filesystem::path& path, const Checkpoint& checkpoint);
+
+/**
+ * @return the checkpoint at path, or std::nullopt if there is none
+ * @throws std::runtime_error if the file exists but is not a valid checkpoint (wrong magic/version, truncated,
+ * checksum mismatch)
+ */
+std::optional<Checkpoint> loadCheckpoint(const std::filesystem::path& path);
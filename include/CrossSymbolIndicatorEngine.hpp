@@ -0,0 +1,309 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "IndicatorConfig.hpp"
+#include "IndicatorSnapshot.hpp"
+#include "SymbolTable.hpp"
+#include "indicators/SymbolLanes.hpp"
+#include "indicators/ohlcv/ATR.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
+
+#include <algorithm>
+#include <boost/signals2.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * Indicator engine for a whole symbol universe.
+ *
+ * Instead of one IndicatorEngine per symbol, every configured EMA/ATR/MACD keeps the state of all symbols in aligned
+ * lane arrays indexed by SymbolId. Bars are staged per timestamp; when the batch is flushed (explicitly, or
+ * implicitly by the first bar of the next timestamp) each indicator advances every symbol in one SIMD pass, without
+ * virtual calls or map lookups. Symbols without a bar in the batch keep their state.
+ *
+ * Subscribers are notified once per flushed batch with the batch timestamp and the symbols it updated; values are
+ * read back per symbol into an IndicatorSnapshot with the same layout IndicatorEngine would publish.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class CrossSymbolIndicatorEngine
+{
+public:
+    using BarType   = Bar<Count, TimeUnit>;
+    using Timestamp = typename BarType::Timestamp;
+    using Snapshot  = IndicatorSnapshot;
+    using Handle    = IndicatorSnapshot::Handle;
+    using batch_signal_t =
+        boost::signals2::signal<void(Timestamp timestamp, std::span<const SymbolId> updated_symbols)>;
+
+    /**
+     * @throws std::runtime_error if a config names an indicator without a lane implementation
+     */
+    explicit CrossSymbolIndicatorEngine(const std::vector<IndicatorConfig>& configs, std::size_t expected_symbols = 0);
+
+    void on_bar(const BarType& bar);
+
+    /**
+     * Advances every indicator with the staged batch and notifies subscribers. No-op when nothing is staged.
+     */
+    void flush();
+
+    [[nodiscard]]
+    bool is_ready(SymbolId symbol) const;
+
+    /**
+     * @throws std::out_of_range if no configured indicator publishes that field
+     */
+    [[nodiscard]]
+    Handle handle(std::string_view indicator, std::string_view field) const;
+
+    /**
+     * @return a snapshot with this engine's layout; reuse it with read(symbol, snapshot) to avoid allocating
+     */
+    [[nodiscard]]
+    Snapshot make_snapshot() const;
+
+    /**
+     * Fills snapshot (created by make_snapshot()) with the symbol's current values.
+     *
+     * @throws std::runtime_error if the symbol's indicators are not ready
+     */
+    void read(SymbolId symbol, Snapshot& snapshot) const;
+
+    [[nodiscard]]
+    Snapshot read(SymbolId symbol) const;
+
+    boost::signals2::connection subscribe(const typename batch_signal_t::slot_type& handler)
+    {
+        return _batch_signal.connect(handler);
+    }
+
+private:
+    using Lanes = std::variant<lanes::EMALanes, lanes::ATRLanes, lanes::MACDLanes>;
+
+    static Lanes make_lanes(const IndicatorConfig& config);
+
+    void resize(std::size_t lane_count);
+
+    std::vector<Lanes>                               _indicators{};
+    std::vector<std::size_t>                         _offsets{};
+    std::shared_ptr<const IndicatorSnapshot::Layout> _layout{};
+
+    lanes::Column            _high{};
+    lanes::Column            _low{};
+    lanes::Column            _close{};
+    lanes::Column            _present{};
+    std::vector<SymbolId>    _staged{};
+    std::optional<Timestamp> _staged_timestamp{};
+
+    batch_signal_t _batch_signal{};
+};
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+CrossSymbolIndicatorEngine<Count, TimeUnit>::CrossSymbolIndicatorEngine(
+    const std::vector<IndicatorConfig>& configs, const std::size_t expected_symbols)
+{
+    auto layout{std::make_shared<IndicatorSnapshot::Layout>()};
+    for (const auto& config : configs)
+    {
+        _indicators.push_back(make_lanes(config));
+        _offsets.push_back(layout->add(
+            config.name, std::visit([](const auto& group) { return group.fields(); }, _indicators.back())));
+    }
+    _layout = std::move(layout);
+    resize(expected_symbols);
+    _staged.reserve(expected_symbols);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void CrossSymbolIndicatorEngine<Count, TimeUnit>::on_bar(const BarType& bar)
+{
+    if (_staged_timestamp.has_value() && *_staged_timestamp != bar.timestamp())
+    {
+        flush();
+    }
+
+    const std::size_t lane{bar.symbol().value};
+    if (lane >= _present.size())
+    {
+        resize(lane + 1);
+    }
+
+    if (_present[lane] == 0.0)
+    {
+        _staged.push_back(bar.symbol());
+    }
+
+    _high[lane]       = bar.high();
+    _low[lane]        = bar.low();
+    _close[lane]      = bar.close();
+    _present[lane]    = 1.0;
+    _staged_timestamp = bar.timestamp();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void CrossSymbolIndicatorEngine<Count, TimeUnit>::flush()
+{
+    if (_staged.empty())
+    {
+        return;
+    }
+
+    const lanes::LaneInputs inputs{.high = _high, .low = _low, .close = _close, .present = _present};
+    for (auto& indicator : _indicators)
+    {
+        std::visit(
+            [&inputs](auto& group)
+            {
+                if constexpr (std::is_same_v<std::decay_t<decltype(group)>, lanes::EMALanes>)
+                {
+                    group.update(inputs.close, inputs.present);
+                }
+                else
+                {
+                    group.update(inputs);
+                }
+            },
+            indicator);
+    }
+
+    const Timestamp timestamp{*_staged_timestamp};
+    _batch_signal(timestamp, _staged);
+
+    for (const SymbolId symbol : _staged)
+    {
+        _present[symbol.value] = 0.0;
+    }
+    _staged.clear();
+    _staged_timestamp.reset();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+bool CrossSymbolIndicatorEngine<Count, TimeUnit>::is_ready(const SymbolId symbol) const
+{
+    if (symbol.value >= _present.size())
+    {
+        return false;
+    }
+
+    return std::ranges::all_of(
+        _indicators,
+        [symbol](const Lanes& indicator)
+        { return std::visit([symbol](const auto& group) { return group.is_ready(symbol.value); }, indicator); });
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename CrossSymbolIndicatorEngine<Count, TimeUnit>::Handle
+    CrossSymbolIndicatorEngine<Count, TimeUnit>::handle(
+        const std::string_view indicator, const std::string_view field) const
+{
+    const auto handle{_layout->find(indicator, field)};
+    if (!handle.has_value())
+    {
+        throw std::out_of_range{"no indicator field " + std::string{indicator} + "." + std::string{field}};
+    }
+    return *handle;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename CrossSymbolIndicatorEngine<Count, TimeUnit>::Snapshot
+    CrossSymbolIndicatorEngine<Count, TimeUnit>::make_snapshot() const
+{
+    return Snapshot{_layout};
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void CrossSymbolIndicatorEngine<Count, TimeUnit>::read(const SymbolId symbol, Snapshot& snapshot) const
+{
+    if (!is_ready(symbol))
+    {
+        throw std::runtime_error{"indicators are not ready for " + std::string{SymbolTable::name(symbol)}};
+    }
+
+    const std::span<double> values{snapshot.values()};
+    for (std::size_t i = 0; i < _indicators.size(); ++i)
+    {
+        std::visit(
+            [&](const auto& group) { group.read(symbol.value, values.subspan(_offsets[i], group.fields().size())); },
+            _indicators[i]);
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename CrossSymbolIndicatorEngine<Count, TimeUnit>::Snapshot
+    CrossSymbolIndicatorEngine<Count, TimeUnit>::read(const SymbolId symbol) const
+{
+    Snapshot snapshot{make_snapshot()};
+    read(symbol, snapshot);
+    return snapshot;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename CrossSymbolIndicatorEngine<Count, TimeUnit>::Lanes
+    CrossSymbolIndicatorEngine<Count, TimeUnit>::make_lanes(const IndicatorConfig& config)
+{
+    const auto param{[&config](const std::string& key)
+                     {
+                         const auto it{config.params.find(key)};
+                         if (it == config.params.end())
+                         {
+                             throw std::runtime_error{
+                                 std::string{config.name} + " config requires a " + key + " key"};
+                         }
+                         return static_cast<std::size_t>(it->second);
+                     }};
+
+    if (config.name == EMA::name)
+    {
+        return lanes::EMALanes{param("period")};
+    }
+    if (config.name == ATR::name)
+    {
+        return lanes::ATRLanes{param("period")};
+    }
+    if (config.name == MACD::name)
+    {
+        return lanes::MACDLanes{param("fast_period"), param("slow_period"), param("signal_period")};
+    }
+    throw std::runtime_error{"Indicator not supported by CrossSymbolIndicatorEngine: " + std::string{config.name}};
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void CrossSymbolIndicatorEngine<Count, TimeUnit>::resize(const std::size_t lane_count)
+{
+    const std::size_t padded{lanes::padded(lane_count)};
+    if (padded <= _present.size())
+    {
+        return;
+    }
+
+    _high.resize(padded, 0.0);
+    _low.resize(padded, 0.0);
+    _close.resize(padded, 0.0);
+    _present.resize(padded, 0.0);
+    for (auto& indicator : _indicators)
+    {
+        std::visit([lane_count](auto& group) { group.resize(lane_count); }, indicator);
+    }
+}
+
+// Convenient type alias matching DefaultIndicatorEngine
+using DefaultCrossSymbolIndicatorEngine = CrossSymbolIndicatorEngine<5, std::chrono::minutes>;
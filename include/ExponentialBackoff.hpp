@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+/**
+ * Jittered exponential backoff for reconnects and retries.
+ *
+ * The n-th delay (0-based) is drawn uniformly from [cap / 2, cap] with cap = min(max, initial * 2^n), so delays grow
+ * geometrically while clients that failed together spread out instead of reconnecting in lockstep.
+ */
+class ExponentialBackoff
+{
+public:
+    using duration = std::chrono::milliseconds;
+
+    ExponentialBackoff(duration initial, duration max, std::uint64_t seed = std::random_device{}());
+
+    /**
+     * @return delay before the next attempt; each call counts as one attempt
+     */
+    [[nodiscard]]
+    duration next_delay();
+
+    /**
+     * Starts over at the initial delay, e.g. after a successful connect.
+     */
+    void reset();
+
+    [[nodiscard]]
+    std::size_t attempts() const;
+
+private:
+    duration        _initial;
+    duration        _max;
+    std::size_t     _attempts{0};
+    std::mt19937_64 _rng;
+};
+
+inline ExponentialBackoff::ExponentialBackoff(const duration initial, const duration max, const std::uint64_t seed)
+    : _initial{initial},
+      _max{max},
+      _rng{seed}
+{
+    if (_initial <= duration::zero() || _max < _initial)
+    {
+        throw std::invalid_argument{"ExponentialBackoff: need 0 < initial <= max"};
+    }
+}
+
+inline ExponentialBackoff::duration ExponentialBackoff::next_delay()
+{
+    // doubling stops at _max, so the shift never overflows however many attempts fail
+    duration cap{_initial};
+    for (std::size_t i = 0; i < _attempts && cap < _max; ++i)
+    {
+        cap *= 2;
+    }
+    cap = std::min(cap, _max);
+    ++_attempts;
+
+    std::uniform_int_distribution<duration::rep> jitter{cap.count() / 2, cap.count()};
+    return duration{jitter(_rng)};
+}
+
+inline void ExponentialBackoff::reset()
+{
+    _attempts = 0;
+}
+
+inline std::size_t ExponentialBackoff::attempts() const
+{
+    return _attempts;
+}
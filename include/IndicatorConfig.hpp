@@ -1,11 +1,52 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 struct IndicatorConfig
 {
     std::string_view                     name;
     std::unordered_map<std::string, int> params{};
+
+    /**
+     * Name the engine publishes this indicator under; defaults to name. Needed when two configs of the same kind
+     * (e.g. EMA-12 and EMA-200) are published side by side.
+     */
+    std::string_view label{};
+
+    [[nodiscard]]
+    std::string_view published_name() const
+    {
+        return label.empty() ? name : label;
+    }
 };
+
+/**
+ * Canonical identity of an indicator computation: kind plus sorted params, e.g. "MACD(fast_period=12,...)". Two
+ * configs with the same key compute the same values and can share one node.
+ */
+[[nodiscard]]
+inline std::string indicator_key(const IndicatorConfig& config)
+{
+    std::vector<std::pair<std::string_view, int>> params(config.params.begin(), config.params.end());
+    std::ranges::sort(params);
+
+    std::string key{config.name};
+    key += '(';
+    for (std::size_t i = 0; i < params.size(); ++i)
+    {
+        if (i > 0)
+        {
+            key += ',';
+        }
+        key += params[i].first;
+        key += '=';
+        key += std::to_string(params[i].second);
+    }
+    key += ')';
+    return key;
+}
@@ -2,21 +2,47 @@
 #include "Bar.hpp"
 #include "IndicatorConfig.hpp"
 #include "IndicatorRegistry.hpp"
+#include "IndicatorSnapshot.hpp"
+#include "StateSerialization.hpp"
 #include "indicators/ohlcv/OHLCVIndicator.hpp"
 
+#include <algorithm>
 #include <boost/signals2.hpp>
-#include <ranges>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
+/**
+ * Evaluates a set of indicators on every bar and publishes their values as one IndicatorSnapshot.
+ *
+ * The configs are expanded into a dependency graph: each indicator may declare sub-computations (MACD its fast and
+ * slow EMA, ATR the true range) via dependencies(). Nodes are deduplicated by indicator_key(), so an EMA-12 config
+ * next to a MACD(12, 26, 9) is computed once, and evaluated once per bar in topological order. Only the configured
+ * indicators are published; dependency-only nodes are internal.
+ */
 template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
 class IndicatorEngine
 {
 public:
     using BarType            = Bar<Count, TimeUnit>;
     using RegistryType       = IndicatorRegistry<IndicatorInterface>;
-    using Snapshots          = std::unordered_map<std::string, typename IndicatorInterface::Snapshot>;
-    using IndicatorContainer = std::unordered_map<std::string, std::unique_ptr<IndicatorInterface>>;
-    using indicator_signal_t = boost::signals2::signal<void(const Snapshots&)>;
+    using Snapshot           = IndicatorSnapshot;
+    using Handle             = IndicatorSnapshot::Handle;
+    using IndicatorContainer = std::vector<std::unique_ptr<IndicatorInterface>>;
+    using indicator_signal_t = boost::signals2::signal<void(const Snapshot&)>;
 
+    /**
+     * Builds the graph and fixes the snapshot layout: one slot per field of each configured indicator, in config
+     * order. Configs with identical keys are computed and published once; a differing label is an alias for the
+     * same values.
+     *
+     * @throws std::invalid_argument if two different configs share a published name (set IndicatorConfig::label)
+     * @throws std::runtime_error on unknown indicators or a dependency cycle
+     */
     explicit IndicatorEngine(const std::vector<IndicatorConfig>& configs);
 
     void on_bar(const BarType& bar);
@@ -24,50 +50,163 @@ public:
     [[nodiscard]]
     bool is_ready() const;
 
+    /**
+     * Resolve once, then index snapshots with the handle on every update.
+     *
+     * @throws std::out_of_range if no configured indicator publishes that field
+     */
+    [[nodiscard]]
+    Handle handle(std::string_view indicator, std::string_view field) const;
+
+    /**
+     * Same as handle(name, field), looked up by the config the indicator was created from.
+     *
+     * @throws std::out_of_range if no configured indicator matches config or it has no such field
+     */
+    [[nodiscard]]
+    Handle handle(const IndicatorConfig& config, std::string_view field) const;
+
+    /**
+     * @return latest values; only meaningful once is_ready()
+     */
+    [[nodiscard]]
+    const Snapshot& snapshot() const;
+
+    /**
+     * @return number of distinct computations evaluated per bar, including dependency-only nodes
+     */
+    [[nodiscard]]
+    std::size_t node_count() const;
+
+    /**
+     * Writes the state of every node, tagged with its indicator_key(), for StateCheckpointer.
+     */
+    void save_state(StateWriter& writer) const;
+
+    /**
+     * Restores state written by save_state() of an engine with the same configs. Nothing is loaded unless every
+     * node key matches, so a checkpoint from a different indicator set leaves the engine untouched. Does not emit.
+     *
+     * @throws std::runtime_error if the saved graph differs from this one or the state is corrupt
+     */
+    void load_state(StateReader& reader);
+
     boost::signals2::connection subscribe(const typename indicator_signal_t::slot_type& handler)
     {
         return _indicator_signal.connect(handler);
     }
 
 private:
+    struct Published
+    {
+        std::size_t node{};
+        std::size_t offset{};
+        std::string key{};
+        std::string name{};
+    };
+
+    std::size_t add_node(const IndicatorConfig& config, std::vector<std::string>& path);
+
     void update_snapshots();
 
-    IndicatorContainer _indicators{};
-    Snapshots          _snapshots{};
-    indicator_signal_t _indicator_signal{};
+    IndicatorContainer       _nodes{};
+    std::vector<std::string> _node_keys{};
+    std::vector<Published>   _published{};
+    Snapshot                 _snapshot{};
+    indicator_signal_t       _indicator_signal{};
 };
 
 template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
 IndicatorEngine<Count, TimeUnit, IndicatorInterface>::IndicatorEngine(const std::vector<IndicatorConfig>& configs)
 {
+    auto                     layout{std::make_shared<IndicatorSnapshot::Layout>()};
+    std::vector<std::string> path{};
     for (const auto& config : configs)
     {
-        auto [name_sv, indicator]{RegistryType::create(config)};
-        const std::string name{name_sv};
-        _indicators[name] = std::move(indicator);
-        _snapshots[name]  = std::move(typename IndicatorInterface::Snapshot{});
+        const std::size_t node{add_node(config, path)};
+        std::string       key{_node_keys[node]};
+        const auto        published{
+            std::ranges::find_if(_published, [&key](const Published& p) { return p.key == key; })};
+        if (published != _published.end())
+        {
+            // the same computation configured under another label is published at the same offset
+            const std::string_view name{config.published_name()};
+            if (!layout->contains(name))
+            {
+                layout->add_alias(name, published->name);
+            }
+            else if (const auto field{_nodes[node]->fields().front()};
+                     layout->find(name, field) != layout->find(published->name, field))
+            {
+                throw std::invalid_argument{"indicator name published twice: " + std::string{name}};
+            }
+            continue;
+        }
+
+        const std::size_t offset{layout->add(config.published_name(), _nodes[node]->fields())};
+        _published.push_back(Published{
+            .node = node, .offset = offset, .key = std::move(key), .name = std::string{config.published_name()}});
     }
+    _snapshot = Snapshot{std::move(layout)};
 }
 
 template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
 void IndicatorEngine<Count, TimeUnit, IndicatorInterface>::on_bar(const BarType& bar)
 {
-    for (const auto& indicator_ptr : _indicators | std::views::values)
+    // _nodes is in topological order: dependencies are written before their consumers
+    for (const auto& indicator_ptr : _nodes)
         indicator_ptr->write(bar.ohlcv());
 
     if (is_ready())
     {
         update_snapshots();
-        _indicator_signal(_snapshots);
+        _indicator_signal(_snapshot);
     }
 }
 
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+std::size_t IndicatorEngine<Count, TimeUnit, IndicatorInterface>::add_node(
+    const IndicatorConfig& config, std::vector<std::string>& path)
+{
+    std::string key{indicator_key(config)};
+    if (const auto it{std::ranges::find(_node_keys, key)}; it != _node_keys.end())
+    {
+        return static_cast<std::size_t>(it - _node_keys.begin());
+    }
+    if (std::ranges::find(path, key) != path.end())
+    {
+        throw std::runtime_error{"Indicator dependency cycle at " + key};
+    }
+
+    auto [name, indicator]{RegistryType::create(config)};
+
+    // dependencies are added first, so appending this node keeps _nodes topologically sorted
+    path.push_back(key);
+    std::vector<const IndicatorInterface*> dependencies{};
+    for (const auto& dependency : indicator->dependencies())
+    {
+        dependencies.push_back(_nodes[add_node(dependency, path)].get());
+    }
+    path.pop_back();
+
+    if (!dependencies.empty())
+    {
+        indicator->bind_dependencies(dependencies);
+    }
+
+    _nodes.push_back(std::move(indicator));
+    _node_keys.push_back(std::move(key));
+    return _nodes.size() - 1;
+}
+
 template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
 void IndicatorEngine<Count, TimeUnit, IndicatorInterface>::update_snapshots()
 {
-    for (const auto& [name, indicator_ptr] : _indicators)
+    const std::span<double> values{_snapshot.values()};
+    for (const auto& published : _published)
     {
-        _snapshots[name] = std::move(indicator_ptr->read());
+        const auto& indicator{*_nodes[published.node]};
+        indicator.read(values.subspan(published.offset, indicator.fields().size()));
     }
 }
 
@@ -75,7 +214,98 @@ template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface
 bool IndicatorEngine<Count, TimeUnit, IndicatorInterface>::is_ready() const
 {
     return std::ranges::all_of(
-        _indicators.begin(), _indicators.end(), [](const auto& p) { return p.second->is_ready(); });
+        _published, [this](const Published& published) { return _nodes[published.node]->is_ready(); });
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+typename IndicatorEngine<Count, TimeUnit, IndicatorInterface>::Handle
+    IndicatorEngine<Count, TimeUnit, IndicatorInterface>::handle(
+        const std::string_view indicator, const std::string_view field) const
+{
+    return _snapshot.handle(indicator, field);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+typename IndicatorEngine<Count, TimeUnit, IndicatorInterface>::Handle
+    IndicatorEngine<Count, TimeUnit, IndicatorInterface>::handle(
+        const IndicatorConfig& config, const std::string_view field) const
+{
+    const std::string key{indicator_key(config)};
+    const auto        published{
+        std::ranges::find_if(_published, [&key](const Published& p) { return p.key == key; })};
+    if (published == _published.end())
+    {
+        throw std::out_of_range{"no configured indicator " + key};
+    }
+
+    const auto fields{_nodes[published->node]->fields()};
+    const auto it{std::ranges::find(fields, field)};
+    if (it == fields.end())
+    {
+        throw std::out_of_range{key + " has no field " + std::string{field}};
+    }
+    return Handle{static_cast<std::uint32_t>(published->offset + static_cast<std::size_t>(it - fields.begin()))};
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+const typename IndicatorEngine<Count, TimeUnit, IndicatorInterface>::Snapshot&
+    IndicatorEngine<Count, TimeUnit, IndicatorInterface>::snapshot() const
+{
+    return _snapshot;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+std::size_t IndicatorEngine<Count, TimeUnit, IndicatorInterface>::node_count() const
+{
+    return _nodes.size();
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+void IndicatorEngine<Count, TimeUnit, IndicatorInterface>::save_state(StateWriter& writer) const
+{
+    writer.write<std::uint64_t>(_nodes.size());
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+        StateWriter node_writer{};
+        _nodes[i]->save_state(node_writer);
+        writer.write_string(_node_keys[i]);
+        writer.write_bytes(node_writer.buffer());
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename IndicatorInterface>
+void IndicatorEngine<Count, TimeUnit, IndicatorInterface>::load_state(StateReader& reader)
+{
+    if (reader.read<std::uint64_t>() != _nodes.size())
+    {
+        throw std::runtime_error{"IndicatorEngine::load_state(): saved state has a different number of indicators"};
+    }
+
+    std::vector<std::span<const std::byte>> blobs{};
+    blobs.reserve(_nodes.size());
+    for (const auto& key : _node_keys)
+    {
+        if (reader.read_string() != key)
+        {
+            throw std::runtime_error{"IndicatorEngine::load_state(): saved state does not contain " + key};
+        }
+        blobs.push_back(reader.read_bytes());
+    }
+
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+        StateReader node_reader{blobs[i]};
+        _nodes[i]->load_state(node_reader);
+        if (!node_reader.at_end())
+        {
+            throw std::runtime_error{"IndicatorEngine::load_state(): trailing state for " + _node_keys[i]};
+        }
+    }
+
+    if (is_ready())
+    {
+        update_snapshots();
+    }
 }
 
 // Convenient type aliases for OHLCV indicators
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Fixed-layout view of every indicator value an engine publishes.
+ *
+ * The layout (which indicator/field lives at which index) is built once when the engine is constructed; each update
+ * only overwrites a contiguous array of doubles. Hot-path consumers resolve a Handle once and index with it, which
+ * involves no hashing, string comparison or allocation. Copies share the layout.
+ */
+class IndicatorSnapshot
+{
+public:
+    struct Handle
+    {
+        std::uint32_t index{};
+
+        auto operator<=>(const Handle&) const = default;
+    };
+
+    class Layout
+    {
+    public:
+        /**
+         * Appends the fields of one indicator.
+         *
+         * @return index of the indicator's first field
+         * @throws std::invalid_argument if the indicator name is already part of the layout
+         */
+        std::size_t add(std::string_view indicator, std::span<const std::string_view> fields);
+
+        /**
+         * Makes the fields of an indicator already in the layout resolvable under a second name as well.
+         *
+         * @throws std::invalid_argument if alias is already part of the layout
+         * @throws std::out_of_range if indicator is not part of the layout
+         */
+        void add_alias(std::string_view alias, std::string_view indicator);
+
+        [[nodiscard]]
+        std::optional<Handle> find(std::string_view indicator, std::string_view field) const;
+
+        [[nodiscard]]
+        bool contains(std::string_view indicator) const;
+
+        /**
+         * @return number of values (fields across all indicators)
+         */
+        [[nodiscard]]
+        std::size_t size() const;
+
+        [[nodiscard]]
+        std::size_t indicator_count() const;
+
+    private:
+        struct Entry
+        {
+            std::string indicator;
+            std::string field;
+        };
+
+        struct Alias
+        {
+            std::string alias;
+            std::string indicator;
+        };
+
+        [[nodiscard]]
+        std::string_view resolve(std::string_view indicator) const;
+
+        std::vector<Entry> _entries{};
+        std::vector<Alias> _aliases{};
+        std::size_t        _indicator_count{};
+    };
+
+    IndicatorSnapshot() = default;
+
+    explicit IndicatorSnapshot(std::shared_ptr<const Layout> layout);
+
+    [[nodiscard]]
+    double operator[](const Handle handle) const
+    {
+        return _values[handle.index];
+    }
+
+    /**
+     * @throws std::out_of_range if the layout has no such indicator field
+     */
+    [[nodiscard]]
+    Handle handle(std::string_view indicator, std::string_view field) const;
+
+    /**
+     * Name-based lookup for tests and diagnostics; use a Handle on the hot path.
+     *
+     * @throws std::out_of_range if the layout has no such indicator field
+     */
+    [[nodiscard]]
+    double at(std::string_view indicator, std::string_view field) const;
+
+    [[nodiscard]]
+    bool contains(std::string_view indicator) const;
+
+    [[nodiscard]]
+    bool contains(std::string_view indicator, std::string_view field) const;
+
+    [[nodiscard]]
+    std::size_t indicator_count() const;
+
+    [[nodiscard]]
+    std::span<const double> values() const;
+
+    [[nodiscard]]
+    std::span<double> values();
+
+    [[nodiscard]]
+    const Layout& layout() const;
+
+private:
+    std::shared_ptr<const Layout> _layout{std::make_shared<const Layout>()};
+    std::vector<double>           _values{};
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "IndicatorConfig.hpp"
+#include "IndicatorSnapshot.hpp"
+
+#include <optional>
+#include <vector>
+
+struct MACDStrategyParams
+{
+    int    ema_period{200};
+    int    fast_period{12};
+    int    slow_period{26};
+    int    signal_period{9};
+    int    atr_period{14};
+    double atr_threshold{0.01};
+    double stop_atr_multiple{1.5};
+};
+
+/**
+ * The MACD crossover strategy from the README, evaluated on every indicator snapshot.
+ *
+ * Entry (all must hold): close > EMA, the MACD line crosses above the signal line, the MACD line is below zero and
+ * ATR / close is below atr_threshold. Exit: close < EMA or the MACD line crosses below the signal line. A buy comes
+ * with the distance of its stop loss below the entry price, stop_atr_multiple * ATR.
+ *
+ * The strategy only decides; placing orders is up to the caller (Backtester, or a live trade engine).
+ */
+class MACDStrategy
+{
+public:
+    using Params = MACDStrategyParams;
+
+    enum class Action
+    {
+        None,
+        Buy,
+        Sell,
+    };
+
+    struct Decision
+    {
+        Action action{Action::None};
+        /** only set for Buy: how far below the fill price the stop loss goes */
+        double stop_distance{};
+    };
+
+    /**
+     * @return indicators the engine feeding this strategy must be constructed with
+     */
+    [[nodiscard]]
+    static std::vector<IndicatorConfig> indicator_configs(const Params& params);
+
+    /**
+     * Resolves the snapshot handles once.
+     *
+     * @throws std::out_of_range if snapshot does not publish the indicators from indicator_configs()
+     */
+    explicit MACDStrategy(const IndicatorSnapshot& snapshot, Params params = {});
+
+    /**
+     * @param close close of the bar the snapshot was computed from
+     * @param is_long whether a position is currently held; decides between checking entry and exit conditions
+     */
+    [[nodiscard]]
+    Decision on_snapshot(const IndicatorSnapshot& snapshot, double close, bool is_long);
+
+    [[nodiscard]]
+    const Params& params() const;
+
+private:
+    Params                    _params;
+    IndicatorSnapshot::Handle _ema;
+    IndicatorSnapshot::Handle _macd;
+    IndicatorSnapshot::Handle _signal;
+    IndicatorSnapshot::Handle _atr;
+    std::optional<bool>       _macd_above_signal{};
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * Read-only memory mapping of a whole file (POSIX mmap). The mapping lives as long as the object; an empty file maps
+ * to an empty span.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]]
+    std::span<const std::byte> bytes() const;
+
+    [[nodiscard]]
+    std::string_view text() const;
+
+    [[nodiscard]]
+    std::size_t size() const;
+
+private:
+    void unmap();
+
+    void*       _data{nullptr};
+    std::size_t _size{0};
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Bar.hpp"
+
+#include <algorithm>
+#include <boost/signals2.hpp>
+#include <vector>
+
+/**
+ * Aggregates interleaved 1-minute bars for many symbols at once.
+ *
+ * Every symbol owns the window slot at its SymbolId, so a minute-boundary burst covering the whole universe is a
+ * sequence of indexed slot updates with no hashing and no per-bar allocation. A gap in a symbol's stream drops that
+ * symbol's partial window and starts a new one at the incoming bar instead of throwing, so one illiquid symbol cannot
+ * stall the others.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class MultiSymbolBarAggregator
+{
+    using AggregatedBar           = Bar<Count, TimeUnit>;
+    using aggregated_bar_signal_t = boost::signals2::signal<void(const AggregatedBar&)>;
+
+public:
+    explicit MultiSymbolBarAggregator(std::size_t expected_symbols = 0);
+
+    void on_bar(const Bar1min& input_bar);
+
+    boost::signals2::connection subscribe(const aggregated_bar_signal_t::slot_type& handler);
+
+    [[nodiscard]]
+    std::size_t symbol_count() const;
+
+private:
+    struct Window
+    {
+        OHLCV                             ohlcv{};
+        typename AggregatedBar::Timestamp start{};
+        Bar1min::Timestamp                last_input{};
+        int                               bars_in_window{};
+        bool                              has_last_input{false};
+    };
+
+    Window& window_for(SymbolId symbol);
+
+    std::vector<Window> _windows{};
+
+    aggregated_bar_signal_t _aggregated_bar_signal;
+};
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline MultiSymbolBarAggregator<Count, TimeUnit>::MultiSymbolBarAggregator(const std::size_t expected_symbols)
+    : _windows{},
+      _aggregated_bar_signal{}
+{
+    _windows.reserve(expected_symbols);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline void MultiSymbolBarAggregator<Count, TimeUnit>::on_bar(const Bar1min& input_bar)
+{
+    constexpr auto target_duration = AggregatedBar::duration();
+    constexpr auto input_duration  = Bar1min::duration();
+    static_assert(
+        target_duration.count() % input_duration.count() == 0,
+        "target_duration must be evenly divisible by "
+        "input_duration");
+    constexpr int bars_needed = target_duration / input_duration;
+
+    Window& window{window_for(input_bar.symbol())};
+
+    if (window.has_last_input && window.last_input + input_duration != input_bar.timestamp())
+    {
+        window.bars_in_window = 0;
+    }
+
+    if (window.bars_in_window == 0)
+    {
+        window.ohlcv          = input_bar.ohlcv();
+        window.start          = std::chrono::time_point_cast<TimeUnit>(input_bar.timestamp());
+        window.bars_in_window = 1;
+    }
+    else
+    {
+        window.ohlcv.high  = std::max(window.ohlcv.high, input_bar.high());
+        window.ohlcv.low   = std::min(window.ohlcv.low, input_bar.low());
+        window.ohlcv.close = input_bar.close();
+        window.ohlcv.volume += input_bar.volume();
+        ++window.bars_in_window;
+    }
+
+    window.last_input     = input_bar.timestamp();
+    window.has_last_input = true;
+
+    if (window.bars_in_window == bars_needed)
+    {
+        window.bars_in_window = 0;
+        _aggregated_bar_signal(AggregatedBar{input_bar.symbol(), window.ohlcv, window.start});
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline boost::signals2::connection
+    MultiSymbolBarAggregator<Count, TimeUnit>::subscribe(const aggregated_bar_signal_t::slot_type& handler)
+{
+    return _aggregated_bar_signal.connect(handler);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline std::size_t MultiSymbolBarAggregator<Count, TimeUnit>::symbol_count() const
+{
+    return static_cast<std::size_t>(std::ranges::count_if(_windows, [](const Window& w) { return w.has_last_input; }));
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+inline typename MultiSymbolBarAggregator<Count, TimeUnit>::Window&
+    MultiSymbolBarAggregator<Count, TimeUnit>::window_for(const SymbolId symbol)
+{
+    if (symbol.value >= _windows.size())
+    {
+        _windows.resize(static_cast<std::size_t>(symbol.value) + 1);
+    }
+    return _windows[symbol.value];
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Backtester.hpp"
+#include "Bar.hpp"
+#include "MACDStrategy.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+/**
+ * One point of a parameter sweep: strategy parameters plus the timeframe bars are aggregated to before the
+ * indicators see them.
+ */
+struct SweepParams
+{
+    MACDStrategyParams strategy{};
+    int                aggregation_minutes{5};
+};
+
+struct SweepResult
+{
+    SweepParams    params{};
+    BacktestReport report{};
+};
+
+/**
+ * Candidate values per parameter. expand() enumerates the full grid, sample() draws random points from it for a
+ * random search when the grid is too large.
+ */
+struct ParameterGrid
+{
+    std::vector<int>    ema_periods{200};
+    std::vector<int>    fast_periods{12};
+    std::vector<int>    slow_periods{26};
+    std::vector<int>    signal_periods{9};
+    std::vector<int>    atr_periods{14};
+    std::vector<double> atr_thresholds{0.01};
+    std::vector<double> stop_atr_multiples{1.5};
+    std::vector<int>    aggregation_minutes{5};
+
+    /**
+     * @return every combination, skipping those whose fast MACD period is not below the slow one
+     * @throws std::invalid_argument if any parameter has no candidates or no combination has fast < slow
+     */
+    [[nodiscard]]
+    std::vector<SweepParams> expand() const;
+
+    /**
+     * @return count combinations drawn uniformly (with replacement) from the grid, fast period kept below slow
+     * @throws std::invalid_argument if any parameter has no candidates or no combination has fast < slow
+     */
+    [[nodiscard]]
+    std::vector<SweepParams> sample(std::size_t count, std::uint64_t seed) const;
+};
+
+/**
+ * Runs one backtest per SweepParams across a WorkStealingPool. Every backtest replays the same bars, which are shared
+ * read-only between the workers; each worker owns its whole pipeline, so the backtests share no mutable state.
+ */
+class ParameterSweep
+{
+public:
+    /**
+     * Timeframes a SweepParams may aggregate to; each maps to a Backtester instantiation.
+     */
+    static constexpr std::array<int, 5> SUPPORTED_AGGREGATION_MINUTES{1, 5, 15, 30, 60};
+
+    /**
+     * @param bars one symbol, in time order; must outlive the sweep
+     * @param base starting cash and fill model for every backtest; its strategy params are ignored
+     * @param threads worker count; 0 uses every core
+     */
+    ParameterSweep(std::span<const Bar1min> bars, const BacktestConfig& base, std::size_t threads = 0);
+
+    /**
+     * @return one result per candidate, ranked by total return, ties broken by lower max drawdown
+     * @throws std::invalid_argument if a candidate has an unsupported aggregation timeframe
+     */
+    [[nodiscard]]
+    std::vector<SweepResult> run(std::span<const SweepParams> candidates) const;
+
+    /**
+     * Single backtest of params over bars, as run on each worker.
+     */
+    [[nodiscard]]
+    static BacktestReport
+        backtest(std::span<const Bar1min> bars, const BacktestConfig& base, const SweepParams& params);
+
+private:
+    std::span<const Bar1min> _bars;
+    BacktestConfig           _base;
+    std::size_t              _threads;
+};
+
+/**
+ * Writes results as a CSV table, one row per result in the given order, limited to the first limit rows.
+ */
+void writeSweepResults(std::ostream& out, std::span<const SweepResult> results, std::size_t limit);
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+/**
+ * Thin wrapper over the widest double-precision vector the target supports (AVX-512, AVX2, NEON, or a scalar
+ * fallback). Kernels are written once against simd::f64 and process simd::f64::width lanes per iteration; the
+ * instruction set is picked at compile time, see MACD_TRADING_BOT_NATIVE_ARCH in src/CMakeLists.txt.
+ */
+namespace simd
+{
+
+#if defined(__AVX512F__)
+
+struct mask
+{
+    __mmask8 m;
+
+    friend mask operator&(const mask a, const mask b) { return {static_cast<__mmask8>(a.m & b.m)}; }
+};
+
+struct f64
+{
+    static constexpr std::size_t width{8};
+
+    __m512d v;
+
+    static f64 load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static f64 broadcast(const double x) { return {_mm512_set1_pd(x)}; }
+    void       store(double* p) const { _mm512_storeu_pd(p, v); }
+
+    friend f64 operator+(const f64 a, const f64 b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend f64 operator-(const f64 a, const f64 b) { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend f64 operator*(const f64 a, const f64 b) { return {_mm512_mul_pd(a.v, b.v)}; }
+    friend f64 operator/(const f64 a, const f64 b) { return {_mm512_div_pd(a.v, b.v)}; }
+    friend mask operator<(const f64 a, const f64 b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)}; }
+    friend mask operator<=(const f64 a, const f64 b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ)}; }
+};
+
+inline f64 max(const f64 a, const f64 b)
+{
+    return {_mm512_max_pd(a.v, b.v)};
+}
+
+inline f64 min(const f64 a, const f64 b)
+{
+    return {_mm512_min_pd(a.v, b.v)};
+}
+
+inline f64 abs(const f64 a)
+{
+    return {_mm512_abs_pd(a.v)};
+}
+
+inline f64 select(const mask m, const f64 if_true, const f64 if_false)
+{
+    return {_mm512_mask_blend_pd(m.m, if_false.v, if_true.v)};
+}
+
+inline double reduce_add(const f64 a)
+{
+    return _mm512_reduce_add_pd(a.v);
+}
+
+#elif defined(__AVX2__)
+
+struct mask
+{
+    __m256d m;
+
+    friend mask operator&(const mask a, const mask b) { return {_mm256_and_pd(a.m, b.m)}; }
+};
+
+struct f64
+{
+    static constexpr std::size_t width{4};
+
+    __m256d v;
+
+    static f64 load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static f64 broadcast(const double x) { return {_mm256_set1_pd(x)}; }
+    void       store(double* p) const { _mm256_storeu_pd(p, v); }
+
+    friend f64 operator+(const f64 a, const f64 b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend f64 operator-(const f64 a, const f64 b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend f64 operator*(const f64 a, const f64 b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend f64 operator/(const f64 a, const f64 b) { return {_mm256_div_pd(a.v, b.v)}; }
+    friend mask operator<(const f64 a, const f64 b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+    friend mask operator<=(const f64 a, const f64 b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)}; }
+};
+
+inline f64 max(const f64 a, const f64 b)
+{
+    return {_mm256_max_pd(a.v, b.v)};
+}
+
+inline f64 min(const f64 a, const f64 b)
+{
+    return {_mm256_min_pd(a.v, b.v)};
+}
+
+inline f64 abs(const f64 a)
+{
+    return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+}
+
+inline f64 select(const mask m, const f64 if_true, const f64 if_false)
+{
+    return {_mm256_blendv_pd(if_false.v, if_true.v, m.m)};
+}
+
+inline double reduce_add(const f64 a)
+{
+    const __m128d lo{_mm256_castpd256_pd128(a.v)};
+    const __m128d hi{_mm256_extractf128_pd(a.v, 1)};
+    const __m128d pair{_mm_add_pd(lo, hi)};
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+struct mask
+{
+    uint64x2_t m;
+
+    friend mask operator&(const mask a, const mask b) { return {vandq_u64(a.m, b.m)}; }
+};
+
+struct f64
+{
+    static constexpr std::size_t width{2};
+
+    float64x2_t v;
+
+    static f64 load(const double* p) { return {vld1q_f64(p)}; }
+    static f64 broadcast(const double x) { return {vdupq_n_f64(x)}; }
+    void       store(double* p) const { vst1q_f64(p, v); }
+
+    friend f64 operator+(const f64 a, const f64 b) { return {vaddq_f64(a.v, b.v)}; }
+    friend f64 operator-(const f64 a, const f64 b) { return {vsubq_f64(a.v, b.v)}; }
+    friend f64 operator*(const f64 a, const f64 b) { return {vmulq_f64(a.v, b.v)}; }
+    friend f64 operator/(const f64 a, const f64 b) { return {vdivq_f64(a.v, b.v)}; }
+    friend mask operator<(const f64 a, const f64 b) { return {vcltq_f64(a.v, b.v)}; }
+    friend mask operator<=(const f64 a, const f64 b) { return {vcleq_f64(a.v, b.v)}; }
+};
+
+inline f64 max(const f64 a, const f64 b)
+{
+    return {vmaxq_f64(a.v, b.v)};
+}
+
+inline f64 min(const f64 a, const f64 b)
+{
+    return {vminq_f64(a.v, b.v)};
+}
+
+inline f64 abs(const f64 a)
+{
+    return {vabsq_f64(a.v)};
+}
+
+inline f64 select(const mask m, const f64 if_true, const f64 if_false)
+{
+    return {vbslq_f64(m.m, if_true.v, if_false.v)};
+}
+
+inline double reduce_add(const f64 a)
+{
+    return vaddvq_f64(a.v);
+}
+
+#else
+
+struct mask
+{
+    bool m;
+
+    friend mask operator&(const mask a, const mask b) { return {a.m && b.m}; }
+};
+
+struct f64
+{
+    static constexpr std::size_t width{1};
+
+    double v;
+
+    static f64 load(const double* p) { return {*p}; }
+    static f64 broadcast(const double x) { return {x}; }
+    void       store(double* p) const { *p = v; }
+
+    friend f64  operator+(const f64 a, const f64 b) { return {a.v + b.v}; }
+    friend f64  operator-(const f64 a, const f64 b) { return {a.v - b.v}; }
+    friend f64  operator*(const f64 a, const f64 b) { return {a.v * b.v}; }
+    friend f64  operator/(const f64 a, const f64 b) { return {a.v / b.v}; }
+    friend mask operator<(const f64 a, const f64 b) { return {a.v < b.v}; }
+    friend mask operator<=(const f64 a, const f64 b) { return {a.v <= b.v}; }
+};
+
+inline f64 max(const f64 a, const f64 b)
+{
+    return {a.v > b.v ? a.v : b.v};
+}
+
+inline f64 min(const f64 a, const f64 b)
+{
+    return {a.v < b.v ? a.v : b.v};
+}
+
+inline f64 abs(const f64 a)
+{
+    return {std::fabs(a.v)};
+}
+
+inline f64 select(const mask m, const f64 if_true, const f64 if_false)
+{
+    return m.m ? if_true : if_false;
+}
+
+inline double reduce_add(const f64 a)
+{
+    return a.v;
+}
+
+#endif
+
+} // namespace simd
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Bar.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Execution costs applied by SimulatedBroker: slippage moves each fill price against the account, commission is
+ * charged per share on both sides.
+ */
+struct FillModel
+{
+    double slippage_bps{0.0};
+    double commission_per_share{0.0};
+};
+
+/**
+ * Long-only, single-symbol account for backtesting: fills market orders and stop losses against 1-minute bars and
+ * tracks cash, position, equity and drawdown.
+ *
+ * Market orders are filled at the open of the next bar passed to on_bar(), so a decision made on a bar's close never
+ * trades at that close. A buy invests all cash (fractional quantities, like Alpaca notional orders) and places a stop
+ * stop_distance below the fill price; the stop triggers when a bar's low reaches it and fills at the stop, or at the
+ * open if the bar gapped below it. Slippage moves every fill against the account.
+ */
+class SimulatedBroker
+{
+public:
+    struct Trade
+    {
+        Bar1min::Timestamp entry_time{};
+        Bar1min::Timestamp exit_time{};
+        double             quantity{};
+        double             entry_price{};
+        double             exit_price{};
+        /** net of slippage and commissions */
+        double pnl{};
+        bool   stopped_out{};
+    };
+
+    /**
+     * @throws std::invalid_argument if starting_cash is not positive or the fill model is negative
+     */
+    explicit SimulatedBroker(double starting_cash, FillModel fill_model = {});
+
+    /**
+     * Fills the pending market order at the bar's open, checks the stop, then marks the position to the close.
+     */
+    void on_bar(const Bar1min& bar);
+
+    /**
+     * Queues a market buy of all cash for the next bar; ignored while long or while an order is pending.
+     */
+    void submit_buy(double stop_distance);
+
+    /**
+     * Queues a market sell of the whole position for the next bar; ignored while flat or while an order is pending.
+     */
+    void submit_sell();
+
+    [[nodiscard]]
+    bool is_long() const;
+
+    [[nodiscard]]
+    bool has_pending_order() const;
+
+    [[nodiscard]]
+    double starting_cash() const;
+
+    [[nodiscard]]
+    double cash() const;
+
+    /**
+     * @return cash plus the position marked at the last close
+     */
+    [[nodiscard]]
+    double equity() const;
+
+    /**
+     * @return largest peak-to-trough decline of equity as a fraction of the peak, 0 if equity never fell
+     */
+    [[nodiscard]]
+    double max_drawdown() const;
+
+    /**
+     * @return round trips closed so far, in order
+     */
+    [[nodiscard]]
+    const std::vector<Trade>& trades() const;
+
+private:
+    enum class PendingOrder
+    {
+        None,
+        Buy,
+        Sell,
+    };
+
+    void buy(double price, Bar1min::Timestamp timestamp);
+
+    void sell(double price, Bar1min::Timestamp timestamp, bool stopped_out);
+
+    double             _starting_cash;
+    FillModel          _fill_model;
+    double             _cash;
+    double             _quantity{};
+    double             _entry_price{};
+    double             _entry_cost{};
+    Bar1min::Timestamp _entry_time{};
+    double             _stop_price{};
+    PendingOrder       _pending{PendingOrder::None};
+    double             _pending_stop_distance{};
+    double             _last_close{};
+    double             _peak_equity;
+    double             _max_drawdown{};
+    std::vector<Trade> _trades{};
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "BarAggregator.hpp"
+#include "Checkpoint.hpp"
+#include "IndicatorEngine.hpp"
+#include "StateSerialization.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Periodically checkpoints a BarAggregator and the OHLCVIndicatorEngine fed by it, and restores both at startup, so
+ * a restart does not have to wait for slow indicators (EMA-200 on 5-minute bars needs 1,000 minutes) to warm up
+ * again.
+ *
+ * Call on_bar() with every 1-minute bar after the aggregator has processed it; every save_every_bars bars the state
+ * is written with saveCheckpoint().
+ */
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+class StateCheckpointer
+{
+public:
+    using AggregatorType = BarAggregator<Count, TimeUnit>;
+    using EngineType     = OHLCVIndicatorEngine<Count, TimeUnit>;
+
+    enum class RestoreResult
+    {
+        NoCheckpoint,
+        /** aggregator and indicators restored; feed continues with the bar after the checkpoint */
+        Restored,
+        /** bars were missed since the checkpoint: indicators restored, aggregator partial window dropped */
+        RestoredIndicatorsOnly,
+        /** checkpoint is not older than the next bar, nothing was loaded */
+        Rejected,
+    };
+
+    StateCheckpointer(
+        std::filesystem::path path, AggregatorType& aggregator, EngineType& engine, std::size_t save_every_bars);
+
+    void on_bar(const Bar1min& bar);
+
+    /**
+     * Checkpoints now; does nothing before the first bar.
+     */
+    void save();
+
+    /**
+     * Loads the checkpoint, validated against the timestamp of the first bar the feed will deliver next. A checkpoint
+     * at or after next_bar_timestamp comes from a future the feed is about to replay and is rejected; one whose
+     * last bar is directly before next_bar_timestamp restores everything; an older one restores only the indicators,
+     * since a partial aggregation window cannot be completed across missing bars.
+     *
+     * @throws std::runtime_error if the checkpoint is corrupt or was written for a different indicator set
+     */
+    RestoreResult restore(Bar1min::Timestamp next_bar_timestamp);
+
+    /**
+     * @return timestamp of the last bar covered by the most recent save or restore
+     */
+    [[nodiscard]]
+    std::optional<Bar1min::Timestamp> last_bar_timestamp() const;
+
+private:
+    std::filesystem::path             _path;
+    AggregatorType&                   _aggregator;
+    EngineType&                       _engine;
+    std::size_t                       _save_every_bars;
+    std::size_t                       _bars_since_save{0};
+    std::optional<Bar1min::Timestamp> _last_bar_timestamp{};
+    std::optional<Bar1min::Timestamp> _last_saved_timestamp{};
+};
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+StateCheckpointer<Count, TimeUnit>::StateCheckpointer(
+    std::filesystem::path path, AggregatorType& aggregator, EngineType& engine, const std::size_t save_every_bars)
+    : _path{std::move(path)},
+      _aggregator{aggregator},
+      _engine{engine},
+      _save_every_bars{save_every_bars}
+{
+    if (_save_every_bars == 0)
+    {
+        throw std::invalid_argument{"StateCheckpointer: save_every_bars must be positive"};
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void StateCheckpointer<Count, TimeUnit>::on_bar(const Bar1min& bar)
+{
+    _last_bar_timestamp = bar.timestamp();
+    if (++_bars_since_save >= _save_every_bars)
+    {
+        save();
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void StateCheckpointer<Count, TimeUnit>::save()
+{
+    if (!_last_bar_timestamp.has_value())
+    {
+        return;
+    }
+
+    StateWriter aggregator_writer{};
+    _aggregator.save_state(aggregator_writer);
+    StateWriter engine_writer{};
+    _engine.save_state(engine_writer);
+
+    StateWriter writer{};
+    writer.write_bytes(aggregator_writer.buffer());
+    writer.write_bytes(engine_writer.buffer());
+
+    saveCheckpoint(_path, Checkpoint{.last_bar_timestamp = *_last_bar_timestamp, .payload = writer.buffer()});
+    _last_saved_timestamp = _last_bar_timestamp;
+    _bars_since_save      = 0;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+typename StateCheckpointer<Count, TimeUnit>::RestoreResult
+    StateCheckpointer<Count, TimeUnit>::restore(const Bar1min::Timestamp next_bar_timestamp)
+{
+    const auto checkpoint{loadCheckpoint(_path)};
+    if (!checkpoint.has_value())
+    {
+        return RestoreResult::NoCheckpoint;
+    }
+    if (checkpoint->last_bar_timestamp >= next_bar_timestamp)
+    {
+        return RestoreResult::Rejected;
+    }
+
+    StateReader reader{checkpoint->payload};
+    StateReader aggregator_reader{reader.read_bytes()};
+    StateReader engine_reader{reader.read_bytes()};
+    if (!reader.at_end())
+    {
+        throw std::runtime_error{"StateCheckpointer::restore(): trailing data in checkpoint " + _path.string()};
+    }
+
+    _engine.load_state(engine_reader);
+
+    RestoreResult result{RestoreResult::RestoredIndicatorsOnly};
+    if (next_bar_timestamp - checkpoint->last_bar_timestamp == Bar1min::duration())
+    {
+        _aggregator.load_state(aggregator_reader);
+        result = RestoreResult::Restored;
+    }
+    else
+    {
+        _aggregator.reset();
+    }
+
+    _last_bar_timestamp   = checkpoint->last_bar_timestamp;
+    _last_saved_timestamp = checkpoint->last_bar_timestamp;
+    _bars_since_save      = 0;
+    return result;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+std::optional<Bar1min::Timestamp> StateCheckpointer<Count, TimeUnit>::last_bar_timestamp() const
+{
+    return _last_saved_timestamp;
+}
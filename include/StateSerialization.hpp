@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Append-only binary buffer for checkpointing component state (indicators, aggregators).
+ *
+ * Values are written in native byte order with no padding; checkpoints are meant to be reloaded by the same build on
+ * the same machine. Symbols are written by name because SymbolIds are only stable within one process.
+ */
+class StateWriter
+{
+public:
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void write(const T& value);
+
+    /**
+     * Length-prefixed bytes.
+     */
+    void write_bytes(std::span<const std::byte> bytes);
+
+    /**
+     * Length-prefixed text.
+     */
+    void write_string(std::string_view text);
+
+    template<std::size_t Count, ChronoDuration TimeUnit>
+        requires(Count > 0)
+    void write_bar(const Bar<Count, TimeUnit>& bar);
+
+    [[nodiscard]]
+    const std::vector<std::byte>& buffer() const
+    {
+        return _buffer;
+    }
+
+private:
+    std::vector<std::byte> _buffer{};
+};
+
+/**
+ * Reads back what StateWriter wrote, in the same order.
+ *
+ * Every read throws std::runtime_error when the buffer is too short, so truncated or corrupt state is reported
+ * instead of being loaded.
+ */
+class StateReader
+{
+public:
+    explicit StateReader(std::span<const std::byte> buffer) : _buffer{buffer} {}
+
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]]
+    T read();
+
+    /**
+     * @return view into the underlying buffer of bytes written by StateWriter::write_bytes()
+     */
+    [[nodiscard]]
+    std::span<const std::byte> read_bytes();
+
+    [[nodiscard]]
+    std::string read_string();
+
+    template<typename BarType>
+    [[nodiscard]]
+    BarType read_bar();
+
+    [[nodiscard]]
+    bool at_end() const
+    {
+        return _offset == _buffer.size();
+    }
+
+private:
+    [[nodiscard]]
+    std::span<const std::byte> take(std::size_t n);
+
+    std::span<const std::byte> _buffer{};
+    std::size_t                _offset{};
+};
+
+//
+// StateWriter implementation
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+void StateWriter::write(const T& value)
+{
+    const auto bytes{std::as_bytes(std::span{&value, 1})};
+    _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+}
+
+inline void StateWriter::write_bytes(const std::span<const std::byte> bytes)
+{
+    write<std::uint64_t>(bytes.size());
+    _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+}
+
+inline void StateWriter::write_string(const std::string_view text)
+{
+    write_bytes(std::as_bytes(std::span{text.data(), text.size()}));
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit>
+    requires(Count > 0)
+void StateWriter::write_bar(const Bar<Count, TimeUnit>& bar)
+{
+    write_string(bar.symbol_name());
+    write(bar.ohlcv());
+    write<std::int64_t>(bar.timestamp().time_since_epoch().count());
+}
+
+//
+// StateReader implementation
+
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+T StateReader::read()
+{
+    T value;
+    std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+    return value;
+}
+
+inline std::span<const std::byte> StateReader::read_bytes()
+{
+    return take(read<std::uint64_t>());
+}
+
+inline std::string StateReader::read_string()
+{
+    const auto bytes{read_bytes()};
+    return std::string{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+template<typename BarType>
+BarType StateReader::read_bar()
+{
+    const std::string symbol{read_string()};
+    const auto        ohlcv{read<OHLCV>()};
+    const auto        ticks{read<std::int64_t>()};
+    return BarType{symbol, ohlcv, typename BarType::Timestamp{typename BarType::Timestamp::duration{ticks}}};
+}
+
+inline std::span<const std::byte> StateReader::take(const std::size_t n)
+{
+    if (n > _buffer.size() - _offset)
+    {
+        throw std::runtime_error{"StateReader: unexpected end of state"};
+    }
+
+    const auto bytes{_buffer.subspan(_offset, n)};
+    _offset += n;
+    return bytes;
+}
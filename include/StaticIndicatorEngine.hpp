@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "IndicatorSnapshot.hpp"
+#include "indicators/ohlcv/StaticIndicators.hpp"
+
+#include <array>
+#include <boost/signals2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Indicator engine whose indicator set is fixed at compile time, e.g.
+ *
+ *     StaticIndicatorEngine<5, minutes, static_indicators::EMA<200>, static_indicators::MACD<12, 26, 9>,
+ *                           static_indicators::ATR<14>>
+ *
+ * Indicators live by value in a tuple and on_bar() is a fold over them, so the whole update inlines into one
+ * function with no registry lookups, std::function factories or virtual calls. Values are published in a flat array
+ * with the same order IndicatorEngine uses for the equivalent configs; handles are resolved at compile time.
+ *
+ * Use IndicatorEngine (runtime IndicatorConfig + IndicatorRegistry) when the indicator set is configurable.
+ */
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+class StaticIndicatorEngine
+{
+public:
+    using BarType = Bar<Count, TimeUnit>;
+    using Handle  = IndicatorSnapshot::Handle;
+
+    static constexpr std::size_t FIELD_COUNT{(Indicators::FIELDS.size() + ...)};
+
+    using Values             = std::array<double, FIELD_COUNT>;
+    using indicator_signal_t = boost::signals2::signal<void(const Values&)>;
+
+    void on_bar(const BarType& bar);
+
+    [[nodiscard]]
+    bool is_ready() const;
+
+    /**
+     * @return latest values; only meaningful once is_ready()
+     */
+    [[nodiscard]]
+    const Values& values() const;
+
+    template<typename Indicator>
+    [[nodiscard]]
+    const Indicator& get() const;
+
+    /**
+     * Compile-time handle into values(); ill-formed if Indicator is not part of the engine or has no such field.
+     */
+    template<typename Indicator>
+    [[nodiscard]]
+    static consteval Handle handle(std::string_view field);
+
+    boost::signals2::connection subscribe(const typename indicator_signal_t::slot_type& handler)
+    {
+        return _indicator_signal.connect(handler);
+    }
+
+private:
+    template<typename Indicator>
+    static consteval std::size_t offset();
+
+    void update_values();
+
+    std::tuple<Indicators...> _indicators{};
+    Values                    _values{};
+    indicator_signal_t        _indicator_signal{};
+};
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+void StaticIndicatorEngine<Count, TimeUnit, Indicators...>::on_bar(const BarType& bar)
+{
+    const OHLCV& ohlcv{bar.ohlcv()};
+    std::apply([&ohlcv](Indicators&... indicators) { (indicators.write(ohlcv), ...); }, _indicators);
+
+    if (is_ready())
+    {
+        update_values();
+        _indicator_signal(_values);
+    }
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+bool StaticIndicatorEngine<Count, TimeUnit, Indicators...>::is_ready() const
+{
+    return std::apply([](const Indicators&... indicators) { return (indicators.is_ready() && ...); }, _indicators);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+const typename StaticIndicatorEngine<Count, TimeUnit, Indicators...>::Values&
+    StaticIndicatorEngine<Count, TimeUnit, Indicators...>::values() const
+{
+    return _values;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+template<typename Indicator>
+const Indicator& StaticIndicatorEngine<Count, TimeUnit, Indicators...>::get() const
+{
+    return std::get<Indicator>(_indicators);
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+template<typename Indicator>
+consteval typename StaticIndicatorEngine<Count, TimeUnit, Indicators...>::Handle
+    StaticIndicatorEngine<Count, TimeUnit, Indicators...>::handle(const std::string_view field)
+{
+    for (std::size_t i = 0; i < Indicator::FIELDS.size(); ++i)
+    {
+        if (Indicator::FIELDS[i] == field)
+        {
+            return Handle{static_cast<std::uint32_t>(offset<Indicator>() + i)};
+        }
+    }
+    throw "StaticIndicatorEngine::handle(): unknown field";
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+template<typename Indicator>
+consteval std::size_t StaticIndicatorEngine<Count, TimeUnit, Indicators...>::offset()
+{
+    static_assert(
+        (static_cast<std::size_t>(std::is_same_v<Indicator, Indicators>) + ...) == 1,
+        "Indicator must appear exactly once in the engine");
+
+    std::size_t offset{0};
+    bool        found{false};
+    ((found = found || std::is_same_v<Indicator, Indicators>, offset += found ? 0 : Indicators::FIELDS.size()), ...);
+    return offset;
+}
+
+template<std::size_t Count, ChronoDuration TimeUnit, typename... Indicators>
+    requires(Count > 0 && sizeof...(Indicators) > 0)
+void StaticIndicatorEngine<Count, TimeUnit, Indicators...>::update_values()
+{
+    std::apply(
+        [this](const Indicators&... indicators)
+        {
+            (indicators.read(std::span<double, Indicators::FIELDS.size()>{
+                 _values.data() + offset<Indicators>(), Indicators::FIELDS.size()}),
+             ...);
+        },
+        _indicators);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Compact handle for an interned ticker symbol. Ids are dense and start at 0, so they double as indices into
+ * per-symbol tables.
+ */
+struct SymbolId
+{
+    std::uint32_t value{};
+
+    auto operator<=>(const SymbolId&) const = default;
+};
+
+template<>
+struct std::hash<SymbolId>
+{
+    std::size_t operator()(const SymbolId id) const noexcept { return std::hash<std::uint32_t>{}(id.value); }
+};
+
+/**
+ * Process-wide symbol interning table. Interning takes a lock and is meant for the edges of the system (feed
+ * parsing, file loading); everything downstream of a Bar works with SymbolId only.
+ */
+class SymbolTable
+{
+public:
+    static SymbolTable& instance();
+
+    [[nodiscard]]
+    static SymbolId intern(std::string_view symbol);
+
+    [[nodiscard]]
+    static std::optional<SymbolId> find(std::string_view symbol);
+
+    /**
+     * @return symbol text for id; the view stays valid for the lifetime of the process
+     */
+    [[nodiscard]]
+    static std::string_view name(SymbolId id);
+
+    [[nodiscard]]
+    static std::size_t size();
+
+private:
+    mutable std::shared_mutex                      _mutex{};
+    std::deque<std::string>                        _names{};
+    std::unordered_map<std::string_view, SymbolId> _ids{};
+};
+
+inline std::ostream& operator<<(std::ostream& os, const SymbolId id)
+{
+    return os << SymbolTable::name(id);
+}
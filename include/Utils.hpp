@@ -1,9 +1,35 @@
 #pragma once
 
 #include "Bar.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
 #include <vector>
 
-Bar1min::Timestamp parseRFC3339UTCTimestamp(const std::string& timestamp);
+/**
+ * Fixed-layout RFC3339 parser: YYYY-MM-DD(T|t| )hh:mm:ss[.fraction](Z|z|+hh:mm|-hh:mm), converted to UTC. Fractions
+ * beyond nanoseconds are truncated.
+ *
+ * @throws std::invalid_argument if the text does not follow that layout or names an invalid date/time
+ */
+std::chrono::sys_time<std::chrono::nanoseconds> parseRFC3339Timestamp(std::string_view timestamp);
+
+/**
+ * Rounds a timestamp down to a multiple of Duration, e.g. the minute of a trade.
+ */
+template<typename Duration>
+std::chrono::sys_time<Duration> truncateTimestamp(const std::chrono::sys_time<std::chrono::nanoseconds> timestamp)
+{
+    return std::chrono::floor<Duration>(timestamp);
+}
+
+/**
+ * parseRFC3339Timestamp() restricted to UTC input ('Z' or '+00:00'), truncated to the minute.
+ *
+ * @throws std::invalid_argument if the timestamp is malformed or not UTC
+ */
+Bar1min::Timestamp parseRFC3339UTCTimestamp(std::string_view timestamp);
 
 Bar1min createBarFromCSVLine(const std::string& line);
 
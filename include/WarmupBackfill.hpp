@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Startup stage that warms the bar consumers (BarAggregator, IndicatorEngine, ...) from a local archive of 1-minute
+ * bars before the live feed is connected, then hands over to the feed without delivering any bar twice:
+ *
+ *     WarmupBackfill backfill{
+ *         [&](const Bar1min& bar) { aggregator.on_bar(bar); }, [&](SymbolId) { aggregator.reset(); }};
+ *     backfill.replay_archive(archive_path);
+ *     feed.connect_bar_handler([&](const Bar1min& bar) { backfill.on_live_bar(bar); });
+ *     feed.start();
+ *
+ * Every bar, archived or live, passes the same per-symbol filter: it is forwarded only if it is newer than the last
+ * bar forwarded for its symbol. Archive slices may therefore overlap each other, the restored checkpoint (see
+ * resume_after()) and the first bars the feed sends after connecting.
+ *
+ * A forwarded bar that does not directly follow the previous one of its symbol (overnight, halts, an archive that
+ * ends before the feed starts) is preceded by a call to the gap handler, so consumers that require consecutive bars,
+ * like BarAggregator, can drop their partial window the way Backtester and StateCheckpointer do. Consumers that
+ * handle gaps themselves, like MultiSymbolBarAggregator, need no gap handler.
+ *
+ * The replay loop is an indexed timestamp compare plus one direct call per bar, with no signal dispatch or
+ * allocation, so warm-up runs at the speed of the consumers themselves.
+ */
+class WarmupBackfill
+{
+public:
+    using BarSink = std::function<void(const Bar1min&)>;
+    using GapSink = std::function<void(SymbolId)>;
+
+    explicit WarmupBackfill(BarSink sink, GapSink gap_sink = {});
+
+    /**
+     * Marks every bar of symbol up to and including timestamp as already processed, e.g. after
+     * StateCheckpointer::restore().
+     */
+    void resume_after(SymbolId symbol, Bar1min::Timestamp timestamp);
+
+    /**
+     * Forwards the bars that are newer than anything seen for their symbol. Bars must be in timestamp order per
+     * symbol; symbols may be interleaved.
+     *
+     * @return number of bars forwarded
+     */
+    std::size_t replay(std::span<const Bar1min> bars);
+
+    /**
+     * replay() of a CSV archive loaded with createBarsFromCSV().
+     */
+    std::size_t replay_csv(const std::string& csv_path);
+
+    /**
+     * replay() of every block of a BarArchive, symbol by symbol.
+     */
+    std::size_t replay_archive(const std::string& archive_path);
+
+    /**
+     * Entry point for the live feed once the archive has been replayed.
+     *
+     * @return true if the bar was forwarded, false if it was already covered by the archive
+     */
+    bool on_live_bar(const Bar1min& bar);
+
+    /**
+     * @return timestamp of the last bar forwarded (or resumed after) for symbol
+     */
+    [[nodiscard]]
+    std::optional<Bar1min::Timestamp> last_timestamp(SymbolId symbol) const;
+
+    [[nodiscard]]
+    std::size_t duplicates_dropped() const;
+
+    /**
+     * @return number of forwarded bars that did not follow the previous bar of their symbol
+     */
+    [[nodiscard]]
+    std::size_t gaps() const;
+
+private:
+    bool accept(const Bar1min& bar);
+
+    BarSink                         _sink;
+    GapSink                         _gap_sink;
+    std::vector<Bar1min::Timestamp> _last_timestamps{};
+    std::size_t                     _duplicates_dropped{0};
+    std::size_t                     _gaps{0};
+};
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "ExponentialBackoff.hpp"
+
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -32,8 +36,32 @@ struct WebSocketSessionConfig
 class WebSocketSession : public std::enable_shared_from_this<WebSocketSession>
 {
 public:
+    /**
+     * Receives each message as a view into the session's read buffer. The view is only valid until the handler
+     * returns (the buffer is reused for the next read); copy anything that has to outlive the call.
+     */
     using frame_handler = std::function<void(std::string_view)>;
 
+    /**
+     * Called on the session's executor when an established connection drops, before the reconnect is scheduled.
+     * Messages still queued at that point are discarded: the peer sees a brand-new connection, so protocol state
+     * (auth, subscriptions) has to be replayed. auth_msg and sub_msg from the config are re-sent automatically.
+     */
+    using disconnect_handler = std::function<void()>;
+
+    /**
+     * Read buffer capacity reserved up front, sized for a minute-boundary bar burst of the full universe. The buffer
+     * grows past it if needed and keeps its capacity across reads.
+     */
+    static constexpr std::size_t INITIAL_READ_BUFFER_CAPACITY{1024 * 1024};
+
+    /**
+     * Bounds of the jittered exponential backoff between reconnect attempts (see ExponentialBackoff); the backoff
+     * restarts at the initial delay after every successful handshake.
+     */
+    static constexpr std::chrono::milliseconds RECONNECT_INITIAL_DELAY{500};
+    static constexpr std::chrono::milliseconds RECONNECT_MAX_DELAY{30'000};
+
     static std::shared_ptr<WebSocketSession>
         create(net::io_context& ioc, const WebSocketSessionConfig& config, const frame_handler& on_frame);
 
@@ -45,6 +73,8 @@ public:
 
     void send(std::string_view text);
 
+    void set_disconnect_handler(disconnect_handler handler);
+
 private:
     void fail(const beast::error_code& ec, char const* what);
 
@@ -72,20 +102,36 @@ private:
 
     void reconnect();
 
+    void on_reconnect_timer(const beast::error_code& ec);
+
+    using ws_stream_t = websocket::stream<beast::ssl_stream<beast::tcp_stream>>;
+
+    /**
+     * Completion handlers hold the stream they were started on, so a replaced stream stays alive until its aborted
+     * operations have completed; is_current() tells those stale completions apart from the live connection's.
+     */
+    [[nodiscard]]
+    bool is_current(const std::shared_ptr<ws_stream_t>& ws) const;
+
+    net::io_context&       _ioc;
     WebSocketSessionConfig _config;
 
     //
-    // Boost::Beast state
-    tcp::resolver                                           _resolver;
-    websocket::stream<beast::ssl_stream<beast::tcp_stream>> _ws;
-    beast::flat_buffer                                      _buffer;
-    net::steady_timer                                       _ping_timer;
+    // Boost::Beast state; the stream is recreated for every connection attempt since TLS state cannot be reused
+    tcp::resolver                _resolver;
+    std::shared_ptr<ws_stream_t> _ws;
+    beast::flat_buffer           _buffer;
+    net::steady_timer            _ping_timer;
+    net::steady_timer            _reconnect_timer;
+    ExponentialBackoff           _backoff;
 
     std::string _host_port;
 
     frame_handler           _frame_handler;
+    disconnect_handler      _disconnect_handler;
     std::queue<std::string> _write_queue;
 
     bool _connected;
     bool _should_reconnect;
+    bool _reconnect_pending;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads with one task deque each.
+ *
+ * submit() deals tasks round-robin onto the deques. A worker runs tasks from the back of its own deque and, once that
+ * is empty, steals from the front of the others, so tasks of very different cost (a 1-hour backtest next to a
+ * 1-minute one) still keep every core busy until the last one finishes. Idle workers sleep rather than spin.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param threads worker count; 0 uses std::thread::hardware_concurrency()
+     */
+    explicit WorkStealingPool(std::size_t threads = 0);
+
+    /**
+     * Runs the tasks still queued, then joins the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&)            = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+
+    /**
+     * Blocks until every task submitted so far has run.
+     *
+     * @throws the first exception thrown by a task since the last wait(); the remaining tasks still run
+     */
+    void wait();
+
+    [[nodiscard]]
+    std::size_t thread_count() const;
+
+private:
+    struct Queue
+    {
+        std::mutex       mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    void worker_loop(std::size_t index);
+
+    /**
+     * Takes a task from the back of queue index, or steals from the front of another queue.
+     */
+    [[nodiscard]]
+    std::optional<Task> take(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> _queues{};
+    std::atomic<std::size_t>            _next_queue{0};
+
+    std::mutex              _mutex{};
+    std::condition_variable _work_available{};
+    std::condition_variable _all_done{};
+    std::size_t             _queued{0};
+    std::size_t             _unfinished{0};
+    bool                    _stopping{false};
+    std::exception_ptr      _error{};
+
+    std::vector<std::jthread> _workers{};
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <span>
+
+/**
+ * Column kernels shared by the batch entry points of the OHLCV indicators. Inputs and outputs are plain double
+ * columns (e.g. BarSeries windows); every kernel requires its spans to have matching lengths.
+ */
+namespace kernels
+{
+
+/**
+ * @return sum of values, accumulated across SIMD lanes
+ */
+double sum(std::span<const double> values);
+
+/**
+ * out[i] = a[i] - b[i]
+ */
+void subtract(std::span<const double> a, std::span<const double> b, std::span<double> out);
+
+/**
+ * out[i] = max(|high[i] - low[i]|, |high[i] - prev_close[i]|, |low[i] - prev_close[i]|)
+ */
+void true_range(
+    std::span<const double> highs,
+    std::span<const double> lows,
+    std::span<const double> prev_closes,
+    std::span<double>       out);
+
+} // namespace kernels
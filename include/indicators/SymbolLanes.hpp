@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * Structure-of-arrays indicator state for many symbols at once. Lane i holds the state of the symbol with
+ * SymbolId{i}; one update() call advances every lane with SIMD, and lanes whose present flag is 0 keep their state.
+ *
+ * Each lane follows exactly the same recurrence as the corresponding OHLCVIndicator (EMA, ATR, MACD), so a lane fed
+ * the same bars reads the same values as a dedicated indicator instance.
+ */
+namespace lanes
+{
+
+/**
+ * Lane counts are padded to this multiple so kernels never need a scalar tail (covers 512-bit vectors).
+ */
+inline constexpr std::size_t LANE_PADDING{8};
+
+template<typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    explicit AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(const std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+    friend bool operator==(const AlignedAllocator&, const AlignedAllocator&) = default;
+};
+
+using Column = std::vector<double, AlignedAllocator<double, 64>>;
+
+/**
+ * @return n rounded up to a multiple of LANE_PADDING
+ */
+[[nodiscard]]
+constexpr std::size_t padded(const std::size_t n)
+{
+    return (n + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING;
+}
+
+/**
+ * Inputs for one update: per-lane columns of lane_count() values, present[i] is 1.0 when lane i has a new bar and
+ * 0.0 otherwise.
+ */
+struct LaneInputs
+{
+    std::span<const double> high;
+    std::span<const double> low;
+    std::span<const double> close;
+    std::span<const double> present;
+};
+
+class EMALanes
+{
+public:
+    explicit EMALanes(std::size_t period);
+
+    /**
+     * Grows to lane_count lanes (padded); new lanes start empty.
+     */
+    void resize(std::size_t lane_count);
+
+    void update(std::span<const double> values, std::span<const double> present);
+
+    [[nodiscard]]
+    std::size_t lane_count() const;
+
+    [[nodiscard]]
+    bool is_ready(std::size_t lane) const;
+
+    /**
+     * Same fields and order as the matching OHLCVIndicator.
+     */
+    [[nodiscard]]
+    static std::span<const std::string_view> fields();
+
+    /**
+     * @throws std::runtime_error if the lane is not ready
+     */
+    void read(std::size_t lane, std::span<double> out) const;
+
+    [[nodiscard]]
+    std::span<const double> values() const;
+
+    [[nodiscard]]
+    std::span<const double> counts() const;
+
+    [[nodiscard]]
+    std::size_t period() const;
+
+private:
+    Column      _value{};
+    Column      _n{};
+    double      _alpha{};
+    std::size_t _period{};
+};
+
+class ATRLanes
+{
+public:
+    explicit ATRLanes(std::size_t period);
+
+    void resize(std::size_t lane_count);
+
+    void update(const LaneInputs& inputs);
+
+    [[nodiscard]]
+    std::size_t lane_count() const;
+
+    [[nodiscard]]
+    bool is_ready(std::size_t lane) const;
+
+    [[nodiscard]]
+    static std::span<const std::string_view> fields();
+
+    /**
+     * @throws std::runtime_error if the lane is not ready
+     */
+    void read(std::size_t lane, std::span<double> out) const;
+
+private:
+    Column      _value{};
+    Column      _n{};
+    Column      _prev_close{};
+    Column      _has_prev_close{};
+    std::size_t _period{};
+};
+
+class MACDLanes
+{
+public:
+    MACDLanes(std::size_t fast_period, std::size_t slow_period, std::size_t signal_period);
+
+    void resize(std::size_t lane_count);
+
+    void update(const LaneInputs& inputs);
+
+    [[nodiscard]]
+    std::size_t lane_count() const;
+
+    [[nodiscard]]
+    bool is_ready(std::size_t lane) const;
+
+    [[nodiscard]]
+    static std::span<const std::string_view> fields();
+
+    /**
+     * @throws std::runtime_error if the lane is not ready
+     */
+    void read(std::size_t lane, std::span<double> out) const;
+
+private:
+    EMALanes _fast_ema;
+    EMALanes _slow_ema;
+    EMALanes _signal_ema;
+    Column   _line{};
+    Column   _signal_present{};
+};
+
+} // namespace lanes
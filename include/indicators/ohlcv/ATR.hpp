@@ -2,8 +2,11 @@
 
 #include "IndicatorConfig.hpp"
 #include "OHLCVIndicator.hpp"
+#include "TrueRange.hpp"
 
+#include <array>
 #include <cstddef>
+#include <span>
 #include <string_view>
 
 class ATR final : public OHLCVIndicator
@@ -11,6 +14,8 @@ class ATR final : public OHLCVIndicator
 public:
     static constexpr std::string_view name{"ATR"};
 
+    static constexpr std::array<std::string_view, 1> FIELDS{"atr"};
+
     explicit ATR(std::size_t period = 14);
     explicit ATR(const IndicatorConfig& config);
 
@@ -21,18 +26,61 @@ public:
     bool is_ready() const override;
 
     [[nodiscard]]
-    Snapshot read() const override;
+    std::span<const std::string_view> fields() const override;
+
+    void read(std::span<double> out) const override;
 
     void write(const OHLCV& ohlcv) override;
 
+    void save_state(StateWriter& writer) const override;
+
+    void load_state(StateReader& reader) override;
+
+    /**
+     * ATR reads the per-bar true range from a shared TR node when run inside an IndicatorEngine.
+     */
+    [[nodiscard]]
+    std::vector<IndicatorConfig> dependencies() const override;
+
+    void bind_dependencies(std::span<const OHLCVIndicator* const> nodes) override;
+
     //
     // ATR methods
 
+    /**
+     * Batch update: true ranges are computed column-wise with SIMD, the SMA seed is one vectorized sum, then the
+     * Wilder recurrence runs over the rest. Only for standalone ATRs; throws std::logic_error once bound to a node.
+     */
+    void write(std::span<const double> highs, std::span<const double> lows, std::span<const double> closes);
+
+    /**
+     * Batch update that also records the ATR after each bar into out (NaN while not ready).
+     */
+    void write(
+        std::span<const double> highs,
+        std::span<const double> lows,
+        std::span<const double> closes,
+        std::span<double>       out);
+
+    /**
+     * @throws std::runtime_error if not ready
+     */
+    [[nodiscard]]
+    double value() const;
+
     [[nodiscard]]
     std::size_t period() const;
 
 private:
-    static double calc_tr(double high, double low, double prev_close);
+    void update(double tr);
+
+    void write_batch(
+        std::span<const double> highs,
+        std::span<const double> lows,
+        std::span<const double> closes,
+        double*                 out);
+
+    const TrueRange* _shared_tr{nullptr};
 
     double      _val{0.0};
     double      _prev_close{-1.0};
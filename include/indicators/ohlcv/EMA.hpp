@@ -3,7 +3,9 @@
 #include "IndicatorConfig.hpp"
 #include "OHLCVIndicator.hpp"
 
+#include <array>
 #include <cstddef>
+#include <span>
 #include <string_view>
 
 class EMA final : public OHLCVIndicator
@@ -13,6 +15,8 @@ public:
 
     static constexpr std::string_view name{"EMA"};
 
+    static constexpr std::array<std::string_view, 1> FIELDS{"ema"};
+
     explicit EMA(std::size_t period);
     explicit EMA(const IndicatorConfig& config);
 
@@ -23,19 +27,43 @@ public:
     bool is_ready() const override;
 
     [[nodiscard]]
-    Snapshot read() const override;
+    std::span<const std::string_view> fields() const override;
+
+    void read(std::span<double> out) const override;
 
     void write(const OHLCV& ohlcv) override;
 
+    void save_state(StateWriter& writer) const override;
+
+    void load_state(StateReader& reader) override;
+
     //
     // EMA methods
 
     void write(double close);
 
+    /**
+     * Batch warm-up: folds the remaining SMA seed window with one vectorized sum, then runs the recurrence.
+     */
+    void write(std::span<const double> closes);
+
+    /**
+     * Batch update that also records the EMA after each close into out (NaN while not ready).
+     */
+    void write(std::span<const double> closes, std::span<double> out);
+
+    /**
+     * @throws std::runtime_error if not ready
+     */
+    [[nodiscard]]
+    double value() const;
+
     [[nodiscard]]
     std::size_t period() const;
 
 private:
+    std::size_t seed(std::span<const double> closes);
+
     double      _value{0.0};
     std::size_t _n{0};
     double      _alpha{};
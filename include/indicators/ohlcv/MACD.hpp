@@ -4,6 +4,8 @@
 #include "IndicatorConfig.hpp"
 #include "OHLCVIndicator.hpp"
 
+#include <array>
+#include <span>
 #include <string_view>
 
 class MACD final : public OHLCVIndicator
@@ -11,6 +13,8 @@ class MACD final : public OHLCVIndicator
 public:
     static constexpr std::string_view name{"MACD"};
 
+    static constexpr std::array<std::string_view, 3> FIELDS{"macd", "signal", "histogram"};
+
     explicit MACD(std::size_t fast_period = 12, std::size_t slow_period = 26, std::size_t signal_period = 9);
 
     explicit MACD(const IndicatorConfig& config);
@@ -22,12 +26,72 @@ public:
     bool is_ready() const override;
 
     [[nodiscard]]
-    Snapshot read() const override;
+    std::span<const std::string_view> fields() const override;
+
+    void read(std::span<double> out) const override;
 
     void write(const OHLCV& ohlcv) override;
 
+    void save_state(StateWriter& writer) const override;
+
+    void load_state(StateReader& reader) override;
+
+    /**
+     * The fast and slow EMAs; inside an IndicatorEngine they are shared with any other consumer of the same EMA.
+     */
+    [[nodiscard]]
+    std::vector<IndicatorConfig> dependencies() const override;
+
+    void bind_dependencies(std::span<const OHLCVIndicator* const> nodes) override;
+
+    //
+    // MACD methods
+
+    /**
+     * Typed accessors; each throws std::runtime_error if the MACD is not ready.
+     */
+    [[nodiscard]]
+    double macd() const;
+
+    [[nodiscard]]
+    double signal() const;
+
+    [[nodiscard]]
+    double histogram() const;
+
+    /**
+     * Batch warm-up over a close column. Batch writes are only for standalone MACDs; they throw std::logic_error once
+     * the EMAs are bound to shared nodes.
+     */
+    void write(std::span<const double> closes);
+
+    /**
+     * Batch update that records the MACD line, signal line and histogram after each close (NaN while the
+     * corresponding line is not ready). The line difference and histogram are computed with SIMD kernels.
+     */
+    void write(
+        std::span<const double> closes,
+        std::span<double>       macd_out,
+        std::span<double>       signal_out,
+        std::span<double>       histogram_out);
+
 private:
+    [[nodiscard]]
+    const EMA& fast_ema() const;
+
+    [[nodiscard]]
+    const EMA& slow_ema() const;
+
+    [[nodiscard]]
+    std::size_t warm_up_bars() const;
+
     EMA _fast_ema;
     EMA _slow_ema;
     EMA _signal_ema;
+
+    const EMA* _shared_fast_ema{nullptr};
+    const EMA* _shared_slow_ema{nullptr};
+
+    // bars seen, saturating at warm_up_bars(); the signal EMA starts with the bar after both EMAs became ready
+    std::size_t _bars{0};
 };
@@ -1,22 +1,64 @@
 #pragma once
 
 #include "Bar.hpp"
+#include "IndicatorConfig.hpp"
+#include "StateSerialization.hpp"
 
-#include <string>
-#include <unordered_map>
+#include <span>
+#include <string_view>
+#include <vector>
 
 class OHLCVIndicator
 {
 public:
-    using Snapshot = std::unordered_map<std::string, double>;
-
     virtual ~OHLCVIndicator() = default;
 
     [[nodiscard]]
     virtual bool is_ready() const = 0;
 
+    /**
+     * @return names of the values read() produces, in output order; fixed for the lifetime of the indicator
+     */
     [[nodiscard]]
-    virtual Snapshot read() const = 0;
+    virtual std::span<const std::string_view> fields() const = 0;
+
+    /**
+     * Writes fields().size() values into out.
+     *
+     * @throws std::runtime_error if the indicator is not ready
+     */
+    virtual void read(std::span<double> out) const = 0;
 
     virtual void write(const OHLCV& ohlcv) = 0;
+
+    //
+    // Checkpointing, see StateCheckpointer
+
+    virtual void save_state(StateWriter& writer) const = 0;
+
+    /**
+     * Restores what save_state() wrote. Shared dependency nodes are saved and restored by the engine, not by their
+     * consumers.
+     *
+     * @throws std::runtime_error if the state is truncated or was saved by an indicator with different parameters
+     */
+    virtual void load_state(StateReader& reader) = 0;
+
+    //
+    // Dependency graph hooks, see IndicatorEngine
+
+    /**
+     * @return configs of sub-computations this indicator can take from shared nodes instead of computing itself
+     */
+    [[nodiscard]]
+    virtual std::vector<IndicatorConfig> dependencies() const
+    {
+        return {};
+    }
+
+    /**
+     * Called once before the first write() with one node per dependencies() entry, in the same order. Bound nodes
+     * are written by the engine before this indicator on every bar, and this indicator must only read them.
+     */
+    virtual void bind_dependencies(std::span<const OHLCVIndicator* const> /*nodes*/) {}
 };
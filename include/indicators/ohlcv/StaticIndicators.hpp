@@ -0,0 +1,284 @@
+#pragma once
+
+#include "ATR.hpp"
+#include "Bar.hpp"
+#include "EMA.hpp"
+#include "MACD.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * Compile-time parameterized counterparts of EMA, ATR and MACD for StaticIndicatorEngine.
+ *
+ * Periods are template arguments, so smoothing factors are constants and the update of a whole indicator set can be
+ * inlined into one function. There are no virtual functions; the arithmetic matches the runtime indicators, and
+ * names/fields are shared with them so snapshots look the same.
+ */
+namespace static_indicators
+{
+
+template<std::size_t Period>
+    requires(Period > 0)
+class EMA
+{
+public:
+    static constexpr std::string_view name{::EMA::name};
+    static constexpr auto             FIELDS{::EMA::FIELDS};
+    static constexpr std::size_t      period{Period};
+    static constexpr double           alpha{
+        static_cast<double>(::EMA::SMOOTHING_FACTOR) / (1 + static_cast<double>(Period))};
+
+    [[nodiscard]]
+    bool is_ready() const;
+
+    void write(const OHLCV& ohlcv);
+
+    void write(double close);
+
+    /**
+     * @throws std::runtime_error if not ready
+     */
+    [[nodiscard]]
+    double value() const;
+
+    void read(std::span<double, FIELDS.size()> out) const;
+
+private:
+    double      _value{0.0};
+    std::size_t _n{0};
+};
+
+template<std::size_t Period>
+    requires(Period > 0)
+class ATR
+{
+public:
+    static constexpr std::string_view name{::ATR::name};
+    static constexpr auto             FIELDS{::ATR::FIELDS};
+    static constexpr std::size_t      period{Period};
+
+    [[nodiscard]]
+    bool is_ready() const;
+
+    void write(const OHLCV& ohlcv);
+
+    /**
+     * @throws std::runtime_error if not ready
+     */
+    [[nodiscard]]
+    double value() const;
+
+    void read(std::span<double, FIELDS.size()> out) const;
+
+private:
+    double      _val{0.0};
+    double      _prev_close{0.0};
+    bool        _has_prev_close{false};
+    std::size_t _n{0};
+};
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+class MACD
+{
+public:
+    static constexpr std::string_view name{::MACD::name};
+    static constexpr auto             FIELDS{::MACD::FIELDS};
+
+    [[nodiscard]]
+    bool is_ready() const;
+
+    void write(const OHLCV& ohlcv);
+
+    /**
+     * Typed accessors; each throws std::runtime_error if the MACD is not ready.
+     */
+    [[nodiscard]]
+    double macd() const;
+
+    [[nodiscard]]
+    double signal() const;
+
+    [[nodiscard]]
+    double histogram() const;
+
+    void read(std::span<double, FIELDS.size()> out) const;
+
+private:
+    EMA<FastPeriod>   _fast_ema{};
+    EMA<SlowPeriod>   _slow_ema{};
+    EMA<SignalPeriod> _signal_ema{};
+};
+
+//
+// EMA implementation
+
+template<std::size_t Period>
+    requires(Period > 0)
+bool EMA<Period>::is_ready() const
+{
+    return _n >= Period;
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+void EMA<Period>::write(const OHLCV& ohlcv)
+{
+    write(ohlcv.close);
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+void EMA<Period>::write(const double close)
+{
+    if (is_ready())
+    {
+        _value = close * alpha + _value * (1 - alpha);
+    }
+    else
+    {
+        ++_n;
+        _value = (_value * static_cast<double>(_n - 1) + close) / static_cast<double>(_n);
+    }
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+double EMA<Period>::value() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("Not ready");
+    }
+    return _value;
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+void EMA<Period>::read(const std::span<double, FIELDS.size()> out) const
+{
+    out[0] = value();
+}
+
+//
+// ATR implementation
+
+template<std::size_t Period>
+    requires(Period > 0)
+bool ATR<Period>::is_ready() const
+{
+    return _n >= Period;
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+void ATR<Period>::write(const OHLCV& ohlcv)
+{
+    if (!_has_prev_close)
+    {
+        _prev_close     = ohlcv.close;
+        _has_prev_close = true;
+        return;
+    }
+
+    const double tr{std::max(
+        {std::abs(ohlcv.high - ohlcv.low), std::abs(ohlcv.high - _prev_close), std::abs(ohlcv.low - _prev_close)})};
+    if (!is_ready())
+    {
+        ++_n;
+    }
+
+    _val        = (_val * static_cast<double>(_n - 1) + tr) / static_cast<double>(_n);
+    _prev_close = ohlcv.close;
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+double ATR<Period>::value() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("ATR::value(): no valid ATR data");
+    }
+    return _val;
+}
+
+template<std::size_t Period>
+    requires(Period > 0)
+void ATR<Period>::read(const std::span<double, FIELDS.size()> out) const
+{
+    out[0] = value();
+}
+
+//
+// MACD implementation
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+bool MACD<FastPeriod, SlowPeriod, SignalPeriod>::is_ready() const
+{
+    return _slow_ema.is_ready() && _fast_ema.is_ready() && _signal_ema.is_ready();
+}
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+void MACD<FastPeriod, SlowPeriod, SignalPeriod>::write(const OHLCV& ohlcv)
+{
+    const bool should_calc_signal{_fast_ema.is_ready() && _slow_ema.is_ready()};
+
+    _fast_ema.write(ohlcv);
+    _slow_ema.write(ohlcv);
+
+    if (should_calc_signal)
+    {
+        _signal_ema.write(_fast_ema.value() - _slow_ema.value());
+    }
+}
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+double MACD<FastPeriod, SlowPeriod, SignalPeriod>::macd() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("MACD is not ready");
+    }
+    return _fast_ema.value() - _slow_ema.value();
+}
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+double MACD<FastPeriod, SlowPeriod, SignalPeriod>::signal() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("MACD is not ready");
+    }
+    return _signal_ema.value();
+}
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+double MACD<FastPeriod, SlowPeriod, SignalPeriod>::histogram() const
+{
+    return macd() - signal();
+}
+
+template<std::size_t FastPeriod, std::size_t SlowPeriod, std::size_t SignalPeriod>
+    requires(FastPeriod > 0 && SlowPeriod > 0 && SignalPeriod > 0)
+void MACD<FastPeriod, SlowPeriod, SignalPeriod>::read(const std::span<double, FIELDS.size()> out) const
+{
+    const double macd_line{macd()};
+    const double signal_line{_signal_ema.value()};
+
+    out[0] = macd_line;
+    out[1] = signal_line;
+    out[2] = macd_line - signal_line;
+}
+
+} // namespace static_indicators
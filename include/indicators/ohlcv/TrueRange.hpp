@@ -0,0 +1,57 @@
+#pragma once
+
+#include "IndicatorConfig.hpp"
+#include "OHLCVIndicator.hpp"
+
+#include <array>
+#include <string_view>
+
+/**
+ * True range of the latest bar: max(high - low, |high - prev_close|, |low - prev_close|). Ready from the second bar
+ * on. Volatility indicators such as ATR bind to it so the range is computed once per bar.
+ */
+class TrueRange final : public OHLCVIndicator
+{
+public:
+    static constexpr std::string_view name{"TR"};
+
+    static constexpr std::array<std::string_view, 1> FIELDS{"tr"};
+
+    TrueRange() = default;
+    explicit TrueRange(const IndicatorConfig& config);
+
+    //
+    // Indicator methods
+
+    [[nodiscard]]
+    bool is_ready() const override;
+
+    [[nodiscard]]
+    std::span<const std::string_view> fields() const override;
+
+    void read(std::span<double> out) const override;
+
+    void write(const OHLCV& ohlcv) override;
+
+    void save_state(StateWriter& writer) const override;
+
+    void load_state(StateReader& reader) override;
+
+    //
+    // TrueRange methods
+
+    [[nodiscard]]
+    static double calc(double high, double low, double prev_close);
+
+    /**
+     * @throws std::runtime_error if not ready
+     */
+    [[nodiscard]]
+    double value() const;
+
+private:
+    double _value{0.0};
+    double _prev_close{0.0};
+    bool   _has_prev_close{false};
+    bool   _ready{false};
+};
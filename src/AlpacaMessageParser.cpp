@@ -0,0 +1,415 @@
+#include "AlpacaMessageParser.hpp"
+
+#include "Utils.hpp"
+
+#include <array>
+#include <chrono>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+/**
+ * A message object's fields as views into the frame. String values are stored without their quotes; escape sequences
+ * are left as-is, which is fine for the fields used here (symbols, type codes, timestamps, status text).
+ */
+class MessageFields
+{
+public:
+    // Alpaca messages have at most a dozen fields; extras are ignored
+    static constexpr std::size_t MAX_FIELDS{24};
+
+    void clear() { _count = 0; }
+
+    void add(const std::string_view key, const std::string_view value)
+    {
+        if (_count < MAX_FIELDS)
+        {
+            _fields[_count++] = {key, value};
+        }
+    }
+
+    [[nodiscard]]
+    std::optional<std::string_view> find(const std::string_view key) const
+    {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            if (_fields[i].first == key)
+            {
+                return _fields[i].second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]]
+    std::optional<double> number(const std::string_view key) const
+    {
+        const auto text{find(key)};
+        if (!text.has_value())
+        {
+            return std::nullopt;
+        }
+
+        double value{};
+        if (const auto [ptr, ec]{std::from_chars(text->data(), text->data() + text->size(), value)};
+            ec != std::errc{} || ptr != text->data() + text->size())
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    [[nodiscard]]
+    std::optional<std::uint64_t> unsigned_integer(const std::string_view key) const
+    {
+        const auto text{find(key)};
+        if (!text.has_value())
+        {
+            return std::nullopt;
+        }
+
+        std::uint64_t value{};
+        if (const auto [ptr, ec]{std::from_chars(text->data(), text->data() + text->size(), value)};
+            ec == std::errc{} && ptr == text->data() + text->size())
+        {
+            return value;
+        }
+
+        // fractional sizes are truncated to whole units
+        const auto fractional{number(key)};
+        if (!fractional.has_value() || *fractional < 0)
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::uint64_t>(*fractional);
+    }
+
+private:
+    std::array<std::pair<std::string_view, std::string_view>, MAX_FIELDS> _fields{};
+    std::size_t                                                           _count{0};
+};
+
+class Scanner
+{
+public:
+    explicit Scanner(const std::string_view text) : _text{text} {}
+
+    void skip_whitespace()
+    {
+        while (_pos < _text.size()
+               && (_text[_pos] == ' ' || _text[_pos] == '\n' || _text[_pos] == '\r' || _text[_pos] == '\t'))
+        {
+            ++_pos;
+        }
+    }
+
+    [[nodiscard]]
+    bool at_end()
+    {
+        skip_whitespace();
+        return _pos == _text.size();
+    }
+
+    [[nodiscard]]
+    char peek()
+    {
+        skip_whitespace();
+        if (_pos == _text.size())
+        {
+            fail("unexpected end of frame");
+        }
+        return _text[_pos];
+    }
+
+    void expect(const char c)
+    {
+        if (peek() != c)
+        {
+            fail(std::string{"expected '"} + c + "'");
+        }
+        ++_pos;
+    }
+
+    /**
+     * Consumes c if it is the next non-whitespace character.
+     */
+    bool consume(const char c)
+    {
+        if (peek() == c)
+        {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @return contents of a string literal, without quotes
+     */
+    std::string_view string()
+    {
+        expect('"');
+        const std::size_t begin{_pos};
+        while (_pos < _text.size() && _text[_pos] != '"')
+        {
+            _pos += _text[_pos] == '\\' ? 2 : 1;
+        }
+        if (_pos >= _text.size())
+        {
+            fail("unterminated string");
+        }
+        return _text.substr(begin, _pos++ - begin);
+    }
+
+    /**
+     * Consumes any value.
+     *
+     * @return the string contents for string literals, the raw text otherwise
+     */
+    std::string_view value()
+    {
+        const char c{peek()};
+        if (c == '"')
+        {
+            return string();
+        }
+
+        const std::size_t begin{_pos};
+        if (c == '{' || c == '[')
+        {
+            skip_container();
+        }
+        else
+        {
+            while (_pos < _text.size() && _text[_pos] != ',' && _text[_pos] != '}' && _text[_pos] != ']'
+                   && _text[_pos] != ' ' && _text[_pos] != '\n' && _text[_pos] != '\r' && _text[_pos] != '\t')
+            {
+                ++_pos;
+            }
+            if (_pos == begin)
+            {
+                fail("expected a value");
+            }
+        }
+        return _text.substr(begin, _pos - begin);
+    }
+
+    [[noreturn]]
+    void fail(const std::string& what) const
+    {
+        throw std::runtime_error{"AlpacaMessageParser: " + what + " at offset " + std::to_string(_pos)};
+    }
+
+private:
+    void skip_container()
+    {
+        std::size_t depth{0};
+        do
+        {
+            const char c{_text[_pos]};
+            if (c == '"')
+            {
+                (void)string();
+                continue;
+            }
+            if (c == '{' || c == '[')
+            {
+                ++depth;
+            }
+            else if (c == '}' || c == ']')
+            {
+                --depth;
+            }
+            ++_pos;
+        } while (depth > 0 && _pos < _text.size());
+
+        if (depth > 0)
+        {
+            fail("unterminated array or object");
+        }
+    }
+
+    std::string_view _text;
+    std::size_t      _pos{0};
+};
+
+std::optional<std::chrono::sys_time<std::chrono::nanoseconds>> parseTimestamp(const std::string_view text)
+{
+    try
+    {
+        return parseRFC3339Timestamp(text);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return std::nullopt;
+    }
+}
+
+std::optional<Bar1min> makeBar(const MessageFields& fields)
+{
+    const auto symbol{fields.find("S")};
+    const auto open{fields.number("o")};
+    const auto high{fields.number("h")};
+    const auto low{fields.number("l")};
+    const auto close{fields.number("c")};
+    const auto volume{fields.unsigned_integer("v")};
+    const auto timestamp{fields.find("t")};
+    if (!symbol || !open || !high || !low || !close || !volume || !timestamp)
+    {
+        return std::nullopt;
+    }
+
+    Bar1min::Timestamp bar_timestamp{};
+    try
+    {
+        bar_timestamp = parseRFC3339UTCTimestamp(*timestamp);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return std::nullopt;
+    }
+
+    return Bar1min{SymbolTable::intern(*symbol), *open, *high, *low, *close, *volume, bar_timestamp};
+}
+
+std::optional<AlpacaTrade> makeTrade(const MessageFields& fields)
+{
+    const auto symbol{fields.find("S")};
+    const auto price{fields.number("p")};
+    const auto size{fields.unsigned_integer("s")};
+    const auto timestamp{fields.find("t")};
+    if (!symbol || !price || !size || !timestamp)
+    {
+        return std::nullopt;
+    }
+
+    const auto trade_timestamp{parseTimestamp(*timestamp)};
+    if (!trade_timestamp)
+    {
+        return std::nullopt;
+    }
+
+    return AlpacaTrade{
+        .symbol = SymbolTable::intern(*symbol), .price = *price, .size = *size, .timestamp = *trade_timestamp};
+}
+
+std::optional<AlpacaQuote> makeQuote(const MessageFields& fields)
+{
+    const auto symbol{fields.find("S")};
+    const auto bid_price{fields.number("bp")};
+    const auto bid_size{fields.unsigned_integer("bs")};
+    const auto ask_price{fields.number("ap")};
+    const auto ask_size{fields.unsigned_integer("as")};
+    const auto timestamp{fields.find("t")};
+    if (!symbol || !bid_price || !bid_size || !ask_price || !ask_size || !timestamp)
+    {
+        return std::nullopt;
+    }
+
+    const auto quote_timestamp{parseTimestamp(*timestamp)};
+    if (!quote_timestamp)
+    {
+        return std::nullopt;
+    }
+
+    return AlpacaQuote{
+        .symbol    = SymbolTable::intern(*symbol),
+        .bid_price = *bid_price,
+        .bid_size  = *bid_size,
+        .ask_price = *ask_price,
+        .ask_size  = *ask_size,
+        .timestamp = *quote_timestamp};
+}
+
+std::optional<AlpacaControlMessage> makeControl(const AlpacaControlMessage::Type type, const MessageFields& fields)
+{
+    AlpacaControlMessage message{.type = type, .msg = fields.find("msg").value_or(std::string_view{})};
+    if (const auto code{fields.find("code")}; code.has_value())
+    {
+        std::from_chars(code->data(), code->data() + code->size(), message.code);
+    }
+    return message;
+}
+
+} // namespace
+
+AlpacaMessageParser::AlpacaMessageParser(Handlers handlers)
+    : _handlers{std::move(handlers)}
+{
+}
+
+std::size_t AlpacaMessageParser::parse(const std::string_view frame) const
+{
+    Scanner       scanner{frame};
+    MessageFields fields{};
+    std::size_t   dispatched{0};
+
+    const auto dispatch{[&](auto& handler, const auto& message)
+                        {
+                            if (handler && message.has_value())
+                            {
+                                handler(*message);
+                                ++dispatched;
+                            }
+                        }};
+
+    scanner.expect('[');
+    if (scanner.consume(']'))
+    {
+        return 0;
+    }
+
+    do
+    {
+        fields.clear();
+        scanner.expect('{');
+        if (!scanner.consume('}'))
+        {
+            do
+            {
+                const std::string_view key{scanner.string()};
+                scanner.expect(':');
+                fields.add(key, scanner.value());
+            } while (scanner.consume(','));
+            scanner.expect('}');
+        }
+
+        const std::string_view type{fields.find("T").value_or(std::string_view{})};
+        if (type == "b")
+        {
+            dispatch(_handlers.on_bar, _handlers.on_bar ? makeBar(fields) : std::nullopt);
+        }
+        else if (type == "t")
+        {
+            dispatch(_handlers.on_trade, _handlers.on_trade ? makeTrade(fields) : std::nullopt);
+        }
+        else if (type == "q")
+        {
+            dispatch(_handlers.on_quote, _handlers.on_quote ? makeQuote(fields) : std::nullopt);
+        }
+        else if (type == "success")
+        {
+            dispatch(_handlers.on_control, makeControl(AlpacaControlMessage::Type::Success, fields));
+        }
+        else if (type == "error")
+        {
+            dispatch(_handlers.on_control, makeControl(AlpacaControlMessage::Type::Error, fields));
+        }
+        else if (type == "subscription")
+        {
+            dispatch(_handlers.on_control, makeControl(AlpacaControlMessage::Type::Subscription, fields));
+        }
+    } while (scanner.consume(','));
+
+    scanner.expect(']');
+    if (!scanner.at_end())
+    {
+        scanner.fail("trailing data after message array");
+    }
+    return dispatched;
+}
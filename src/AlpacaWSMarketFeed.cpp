@@ -1,14 +1,17 @@
 #include "AlpacaWSMarketFeed.hpp"
 
 #include "Bar.hpp"
-#include "Utils.hpp"
 
+#include <nlohmann/json.hpp>
 #include <sstream>
 
 AlpacaWSMarketFeed::AlpacaWSMarketFeed(asio::io_context& ioc, config cfg)
     : _ioc{ioc},
       _config{std::move(cfg)},
-      _ssl_context{ssl::context::tls_client}
+      _ssl_context{ssl::context::tls_client},
+      _parser{AlpacaMessageParser::Handlers{
+          .on_bar     = [this](const Bar1min& bar) { emit_bar(bar); },
+          .on_control = [this](const AlpacaControlMessage& message) { on_control_message(message); }}}
 {
     _ssl_context.set_verify_mode(ssl::context::verify_none);
 }
@@ -50,6 +53,14 @@ void AlpacaWSMarketFeed::start()
     _ws_session =
         WebSocketSession::create(_ioc, ws_config, [this](const std::string_view frame) { on_websocket_frame(frame); });
 
+    // the server greets the new connection with "connected" again, which replays auth and the bar subscription
+    _ws_session->set_disconnect_handler(
+        [this]
+        {
+            _authenticated = false;
+            _subscribed    = false;
+        });
+
     _ws_session->start();
 }
 
@@ -88,45 +99,48 @@ void AlpacaWSMarketFeed::on_websocket_frame(std::string_view frame)
 {
     try
     {
-        const auto json_array = nlohmann::json::parse(frame);
-
-        if (!json_array.is_array() || json_array.empty())
-        {
-            return;
-        }
+        _parser.parse(frame);
+    }
+    catch (const std::exception& e)
+    {
+        // a malformed frame is dropped from the point the scanner failed; subscriber errors never reach here
+    }
+}
 
-        for (const auto& json_msg : json_array)
-        {
-            if (!json_msg.contains("T"))
-                continue;
-
-            if (const std::string msg_type = json_msg["T"]; msg_type == "success" && json_msg.contains("msg"))
-            {
-                if (const std::string msg = json_msg["msg"]; msg == "connected")
-                {
-                    send_auth_message();
-                }
-                else if (msg == "authenticated")
-                {
-                    _authenticated = true;
-                    if (!_subscribed_symbols.empty())
-                    {
-                        send_subscription_message();
-                    }
-                }
-            }
-            else if (msg_type == "b")
-            {
-                parse_bar_message(json_msg);
-            }
-            else if (msg_type == "error") {}
-        }
+void AlpacaWSMarketFeed::emit_bar(const Bar1min& bar)
+{
+    // one failing subscriber (e.g. BarAggregator rejecting an out-of-sequence bar) must not cost the remaining
+    // messages of the frame, which may be bars of other symbols
+    try
+    {
+        _bar_signal(bar);
     }
     catch (const std::exception& e)
     {
     }
 }
 
+void AlpacaWSMarketFeed::on_control_message(const AlpacaControlMessage& message)
+{
+    if (message.type != AlpacaControlMessage::Type::Success)
+    {
+        return;
+    }
+
+    if (message.msg == "connected")
+    {
+        send_auth_message();
+    }
+    else if (message.msg == "authenticated")
+    {
+        _authenticated = true;
+        if (!_subscribed_symbols.empty())
+        {
+            send_subscription_message();
+        }
+    }
+}
+
 void AlpacaWSMarketFeed::send_auth_message()
 {
     nlohmann::json auth_msg = {{"action", "auth"}, {"key", _config.api_key}, {"secret", _config.api_secret}};
@@ -154,27 +168,6 @@ void AlpacaWSMarketFeed::send_subscription_message()
     }
 }
 
-void AlpacaWSMarketFeed::parse_bar_message(const nlohmann::json& message)
-{
-    try
-    {
-        const std::string  symbol        = message["S"];
-        const double       open          = message["o"];
-        const double       high          = message["h"];
-        const double       low           = message["l"];
-        const double       close         = message["c"];
-        const uint64_t     volume        = message["v"];
-        const std::string  timestamp_str = message["t"];
-        Bar1min::Timestamp timestamp{parseRFC3339UTCTimestamp(timestamp_str)};
-
-        Bar1min newBar{symbol, open, high, low, close, volume, timestamp};
-        _bar_signal(newBar);
-    }
-    catch (const std::exception& e)
-    {
-    }
-}
-
 std::string AlpacaWSMarketFeed::get_websocket_url() const
 {
     if (_config.test_mode)
@@ -0,0 +1,322 @@
+#include "BarArchive.hpp"
+
+#include "SymbolTable.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr std::array<char, 8> ARCHIVE_MAGIC{'M', 'A', 'C', 'D', 'B', 'A', 'R', 'S'};
+constexpr std::uint32_t       ARCHIVE_VERSION{1};
+
+struct FileHeader
+{
+    std::array<char, 8> magic{};
+    std::uint32_t       version{};
+    std::uint32_t       block_count{};
+    std::uint64_t       bar_count{};
+};
+
+struct DirectoryEntry
+{
+    std::uint64_t symbol_offset{};
+    std::uint32_t symbol_length{};
+    std::uint32_t reserved{};
+    std::uint64_t data_offset{};
+    std::uint64_t rows{};
+    std::int64_t  first_timestamp{};
+};
+
+// open, high, low, close, volume (8 bytes each) and the minute offset (4 bytes)
+constexpr std::size_t BYTES_PER_ROW{5 * sizeof(double) + sizeof(std::uint32_t)};
+
+constexpr std::size_t alignTo8(const std::size_t n)
+{
+    return (n + 7) & ~std::size_t{7};
+}
+
+constexpr std::size_t blockBytes(const std::size_t rows)
+{
+    return alignTo8(rows * BYTES_PER_ROW);
+}
+
+[[noreturn]]
+void corrupt(const std::string& what)
+{
+    throw std::runtime_error{"BarArchive: " + what};
+}
+
+template<typename T>
+std::span<const T> column(const std::byte* data, const std::size_t offset, const std::size_t rows)
+{
+    return {reinterpret_cast<const T*>(data + offset), rows};
+}
+
+void writeRaw(std::ofstream& file, const void* data, const std::size_t size)
+{
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+template<typename T>
+void writeColumn(std::ofstream& file, const std::span<const T> values, const std::vector<std::size_t>& rows)
+{
+    std::vector<T> buffer{};
+    buffer.reserve(rows.size());
+    for (const std::size_t row : rows)
+    {
+        buffer.push_back(values[row]);
+    }
+    writeRaw(file, buffer.data(), buffer.size() * sizeof(T));
+}
+
+} // namespace
+
+//
+// BarArchive
+
+Bar1min::Timestamp BarArchive::Block::timestamp(const std::size_t row) const
+{
+    return first_timestamp + std::chrono::minutes{minute_offsets[row]};
+}
+
+BarArchive::BarArchive(const std::string& path)
+    : _file{path}
+{
+    const std::span<const std::byte> bytes{_file.bytes()};
+
+    FileHeader header{};
+    if (bytes.size() < sizeof(header))
+    {
+        corrupt(path + " is too small to be an archive");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != ARCHIVE_MAGIC)
+    {
+        corrupt(path + " is not a bar archive");
+    }
+    if (header.version != ARCHIVE_VERSION)
+    {
+        corrupt(path + " has unsupported version " + std::to_string(header.version));
+    }
+    if (header.block_count > (bytes.size() - sizeof(header)) / sizeof(DirectoryEntry))
+    {
+        corrupt(path + " is truncated");
+    }
+
+    std::uint64_t bar_count{0};
+    _blocks.reserve(header.block_count);
+    for (std::size_t i = 0; i < header.block_count; ++i)
+    {
+        DirectoryEntry entry{};
+        std::memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+        if (entry.symbol_offset > bytes.size() || entry.symbol_length > bytes.size() - entry.symbol_offset
+            || entry.data_offset % 8 != 0 || entry.data_offset > bytes.size()
+            || entry.rows > (bytes.size() - entry.data_offset) / BYTES_PER_ROW)
+        {
+            corrupt(path + " has an out-of-range block");
+        }
+
+        const std::size_t rows{entry.rows};
+        const std::size_t base{entry.data_offset};
+        _blocks.push_back(Block{
+            .symbol = {reinterpret_cast<const char*>(bytes.data() + entry.symbol_offset), entry.symbol_length},
+            .first_timestamp = Bar1min::Timestamp{std::chrono::minutes{entry.first_timestamp}},
+            .open            = column<double>(bytes.data(), base, rows),
+            .high            = column<double>(bytes.data(), base + 1 * rows * sizeof(double), rows),
+            .low             = column<double>(bytes.data(), base + 2 * rows * sizeof(double), rows),
+            .close           = column<double>(bytes.data(), base + 3 * rows * sizeof(double), rows),
+            .volume          = column<std::uint64_t>(bytes.data(), base + 4 * rows * sizeof(double), rows),
+            .minute_offsets  = column<std::uint32_t>(bytes.data(), base + 5 * rows * sizeof(double), rows)});
+        bar_count += rows;
+    }
+
+    if (bar_count != header.bar_count)
+    {
+        corrupt(path + " has an inconsistent bar count");
+    }
+}
+
+std::span<const BarArchive::Block> BarArchive::blocks() const
+{
+    return _blocks;
+}
+
+const BarArchive::Block* BarArchive::find(const std::string_view symbol) const
+{
+    for (const auto& block : _blocks)
+    {
+        if (block.symbol == symbol)
+        {
+            return &block;
+        }
+    }
+    return nullptr;
+}
+
+void BarArchive::decode(const Block& block, std::vector<Bar1min>& out)
+{
+    out.clear();
+    out.reserve(block.size());
+
+    const SymbolId symbol{SymbolTable::intern(block.symbol)};
+    for (std::size_t row = 0; row < block.size(); ++row)
+    {
+        out.emplace_back(
+            symbol,
+            block.open[row],
+            block.high[row],
+            block.low[row],
+            block.close[row],
+            block.volume[row],
+            block.timestamp(row));
+    }
+}
+
+BarColumns BarArchive::load() const
+{
+    BarColumns bars{};
+    bars.resize(bar_count());
+
+    std::size_t row{0};
+    for (const auto& block : _blocks)
+    {
+        const SymbolId symbol{SymbolTable::intern(block.symbol)};
+        for (std::size_t i = 0; i < block.size(); ++i)
+        {
+            bars.set(
+                row++,
+                Bar1min{
+                    symbol,
+                    block.open[i],
+                    block.high[i],
+                    block.low[i],
+                    block.close[i],
+                    block.volume[i],
+                    block.timestamp(i)});
+        }
+    }
+    return bars;
+}
+
+std::size_t BarArchive::bar_count() const
+{
+    std::size_t count{0};
+    for (const auto& block : _blocks)
+    {
+        count += block.size();
+    }
+    return count;
+}
+
+//
+// Writer
+
+void writeBarArchive(const std::string& path, const BarColumns& bars)
+{
+    // rows of every symbol, symbols in order of first appearance
+    std::vector<std::vector<std::size_t>>          groups{};
+    std::unordered_map<std::uint32_t, std::size_t> group_of{};
+    for (std::size_t row = 0; row < bars.size(); ++row)
+    {
+        const auto [it, inserted]{group_of.try_emplace(bars.symbols()[row].value, groups.size())};
+        if (inserted)
+        {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(row);
+    }
+
+    const auto timestamps{bars.timestamps()};
+    for (const auto& rows : groups)
+    {
+        for (std::size_t i = 1; i < rows.size(); ++i)
+        {
+            if (timestamps[rows[i]] <= timestamps[rows[i - 1]])
+            {
+                throw std::invalid_argument{
+                    "writeBarArchive(): timestamps of " + std::string{SymbolTable::name(bars.symbols()[rows[i]])}
+                    + " are not strictly increasing"};
+            }
+        }
+        if (!rows.empty()
+            && timestamps[rows.back()] - timestamps[rows.front()]
+                   > std::chrono::minutes{std::numeric_limits<std::uint32_t>::max()})
+        {
+            throw std::invalid_argument{"writeBarArchive(): symbol history spans too many minutes for one block"};
+        }
+    }
+
+    // layout: header, directory, symbol names, 8-aligned data blocks
+    std::vector<DirectoryEntry> directory(groups.size());
+    std::size_t                 offset{sizeof(FileHeader) + groups.size() * sizeof(DirectoryEntry)};
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        const std::string_view symbol{SymbolTable::name(bars.symbols()[groups[i].front()])};
+        directory[i].symbol_offset   = offset;
+        directory[i].symbol_length   = static_cast<std::uint32_t>(symbol.size());
+        directory[i].rows            = groups[i].size();
+        directory[i].first_timestamp = timestamps[groups[i].front()].time_since_epoch().count();
+        offset += symbol.size();
+    }
+    offset = alignTo8(offset);
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        directory[i].data_offset = offset;
+        offset += blockBytes(groups[i].size());
+    }
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file)
+    {
+        throw std::runtime_error{"writeBarArchive(): failed to open " + path};
+    }
+
+    const FileHeader header{
+        .magic       = ARCHIVE_MAGIC,
+        .version     = ARCHIVE_VERSION,
+        .block_count = static_cast<std::uint32_t>(groups.size()),
+        .bar_count   = bars.size()};
+    writeRaw(file, &header, sizeof(header));
+    writeRaw(file, directory.data(), directory.size() * sizeof(DirectoryEntry));
+
+    std::size_t written{sizeof(header) + directory.size() * sizeof(DirectoryEntry)};
+    for (const auto& rows : groups)
+    {
+        const std::string_view symbol{SymbolTable::name(bars.symbols()[rows.front()])};
+        writeRaw(file, symbol.data(), symbol.size());
+        written += symbol.size();
+    }
+
+    constexpr std::array<char, 8> padding{};
+    writeRaw(file, padding.data(), alignTo8(written) - written);
+
+    for (const auto& rows : groups)
+    {
+        writeColumn(file, bars.opens(), rows);
+        writeColumn(file, bars.highs(), rows);
+        writeColumn(file, bars.lows(), rows);
+        writeColumn(file, bars.closes(), rows);
+        writeColumn(file, bars.volumes(), rows);
+
+        std::vector<std::uint32_t> minute_offsets{};
+        minute_offsets.reserve(rows.size());
+        for (const std::size_t row : rows)
+        {
+            minute_offsets.push_back(static_cast<std::uint32_t>((timestamps[row] - timestamps[rows.front()]).count()));
+        }
+        writeRaw(file, minute_offsets.data(), minute_offsets.size() * sizeof(std::uint32_t));
+        writeRaw(file, padding.data(), blockBytes(rows.size()) - rows.size() * BYTES_PER_ROW);
+    }
+
+    if (!file.flush())
+    {
+        throw std::runtime_error{"writeBarArchive(): failed to write " + path};
+    }
+}
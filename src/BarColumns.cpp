@@ -0,0 +1,107 @@
+#include "BarColumns.hpp"
+
+#include <stdexcept>
+
+std::size_t BarColumns::size() const
+{
+    return _symbol.size();
+}
+
+bool BarColumns::empty() const
+{
+    return _symbol.empty();
+}
+
+void BarColumns::resize(const std::size_t rows)
+{
+    _symbol.resize(rows);
+    _timestamp.resize(rows);
+    _open.resize(rows);
+    _high.resize(rows);
+    _low.resize(rows);
+    _close.resize(rows);
+    _volume.resize(rows);
+}
+
+void BarColumns::reserve(const std::size_t rows)
+{
+    _symbol.reserve(rows);
+    _timestamp.reserve(rows);
+    _open.reserve(rows);
+    _high.reserve(rows);
+    _low.reserve(rows);
+    _close.reserve(rows);
+    _volume.reserve(rows);
+}
+
+void BarColumns::push_back(const Bar1min& bar)
+{
+    resize(size() + 1);
+    set(size() - 1, bar);
+}
+
+void BarColumns::set(const std::size_t row, const Bar1min& bar)
+{
+    _symbol[row]    = bar.symbol();
+    _timestamp[row] = bar.timestamp();
+    _open[row]      = bar.open();
+    _high[row]      = bar.high();
+    _low[row]       = bar.low();
+    _close[row]     = bar.close();
+    _volume[row]    = bar.volume();
+}
+
+Bar1min BarColumns::bar(const std::size_t row) const
+{
+    if (row >= size())
+    {
+        throw std::out_of_range{"BarColumns::bar(): row out of range"};
+    }
+    return Bar1min{_symbol[row], _open[row], _high[row], _low[row], _close[row], _volume[row], _timestamp[row]};
+}
+
+std::vector<Bar1min> BarColumns::to_bars() const
+{
+    std::vector<Bar1min> bars{};
+    bars.reserve(size());
+    for (std::size_t row = 0; row < size(); ++row)
+    {
+        bars.emplace_back(_symbol[row], _open[row], _high[row], _low[row], _close[row], _volume[row], _timestamp[row]);
+    }
+    return bars;
+}
+
+std::span<const SymbolId> BarColumns::symbols() const
+{
+    return _symbol;
+}
+
+std::span<const Bar1min::Timestamp> BarColumns::timestamps() const
+{
+    return _timestamp;
+}
+
+std::span<const double> BarColumns::opens() const
+{
+    return _open;
+}
+
+std::span<const double> BarColumns::highs() const
+{
+    return _high;
+}
+
+std::span<const double> BarColumns::lows() const
+{
+    return _low;
+}
+
+std::span<const double> BarColumns::closes() const
+{
+    return _close;
+}
+
+std::span<const std::uint64_t> BarColumns::volumes() const
+{
+    return _volume;
+}
@@ -0,0 +1,242 @@
+#include "CSVBarLoader.hpp"
+
+#include "MappedFile.hpp"
+#include "SymbolTable.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// below this many bytes per chunk, thread startup costs more than it saves
+constexpr std::size_t MIN_CHUNK_BYTES{1 << 20};
+
+struct Chunk
+{
+    std::string_view text{};
+    std::size_t      first_row{0};
+    std::size_t      rows{0};
+};
+
+std::string_view nextLine(std::string_view& text)
+{
+    const auto*       newline{static_cast<const char*>(std::memchr(text.data(), '\n', text.size()))};
+    const std::size_t length{newline != nullptr ? static_cast<std::size_t>(newline - text.data()) : text.size()};
+
+    std::string_view line{text.substr(0, length)};
+    text.remove_prefix(std::min(length + 1, text.size()));
+    if (line.ends_with('\r'))
+    {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+std::size_t countRows(std::string_view text)
+{
+    std::size_t rows{0};
+    while (!text.empty())
+    {
+        rows += nextLine(text).empty() ? 0 : 1;
+    }
+    return rows;
+}
+
+/**
+ * Splits text into at most count pieces of similar size, each ending at a newline (or the end of text).
+ */
+std::vector<Chunk> splitAtLines(const std::string_view text, const std::size_t count)
+{
+    std::vector<Chunk> chunks{};
+    const std::size_t  target{std::max<std::size_t>(text.size() / count, 1)};
+
+    std::size_t begin{0};
+    while (begin < text.size())
+    {
+        std::size_t end{std::min(begin + target, text.size())};
+        if (end < text.size())
+        {
+            const auto* newline{static_cast<const char*>(std::memchr(text.data() + end, '\n', text.size() - end))};
+            end = newline != nullptr ? static_cast<std::size_t>(newline - text.data()) + 1 : text.size();
+        }
+        chunks.push_back(Chunk{.text = text.substr(begin, end - begin)});
+        begin = end;
+    }
+    return chunks;
+}
+
+[[noreturn]]
+void malformedRow(const std::string_view line, const char* what)
+{
+    throw std::invalid_argument{"Malformed CSV row (" + std::string{what} + "): " + std::string{line}};
+}
+
+template<typename T>
+T parseNumber(const std::string_view field, const std::string_view line)
+{
+    T value{};
+    if (const auto [ptr, ec]{std::from_chars(field.data(), field.data() + field.size(), value)};
+        ec != std::errc{} || ptr != field.data() + field.size())
+    {
+        malformedRow(line, "bad number");
+    }
+    return value;
+}
+
+std::uint64_t parseVolume(const std::string_view field, const std::string_view line)
+{
+    std::uint64_t volume{};
+    if (const auto [ptr, ec]{std::from_chars(field.data(), field.data() + field.size(), volume)};
+        ec == std::errc{} && ptr == field.data() + field.size())
+    {
+        return volume;
+    }
+    // some exports write volumes as floats; truncate like std::stod + cast did
+    return static_cast<std::uint64_t>(parseNumber<double>(field, line));
+}
+
+Bar1min::Timestamp parseTimestamp(const std::string_view field, const std::string_view line)
+{
+    try
+    {
+        return parseRFC3339UTCTimestamp(field);
+    }
+    catch (const std::invalid_argument&)
+    {
+        malformedRow(line, "bad timestamp");
+    }
+    return {};
+}
+
+/**
+ * Parses every row of chunk into rows [chunk.first_row, chunk.first_row + chunk.rows) of bars.
+ */
+void parseChunk(const Chunk& chunk, BarColumns& bars)
+{
+    // files are grouped by symbol, so the previous symbol almost always matches and interning is skipped
+    std::string_view cached_symbol{};
+    SymbolId         cached_id{};
+
+    std::string_view text{chunk.text};
+    std::size_t      row{chunk.first_row};
+    while (!text.empty())
+    {
+        const std::string_view line{nextLine(text)};
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::array<std::string_view, 7> fields{};
+        std::size_t                     pos{0};
+        for (auto& field : fields)
+        {
+            if (pos > line.size())
+            {
+                malformedRow(line, "fewer than 7 columns");
+            }
+            const std::size_t comma{std::min(line.find(',', pos), line.size())};
+            field = line.substr(pos, comma - pos);
+            pos   = comma + 1;
+        }
+
+        if (fields[0] != cached_symbol)
+        {
+            cached_symbol = fields[0];
+            cached_id     = SymbolTable::intern(cached_symbol);
+        }
+
+        bars.set(
+            row++,
+            Bar1min{
+                cached_id,
+                parseNumber<double>(fields[2], line),
+                parseNumber<double>(fields[3], line),
+                parseNumber<double>(fields[4], line),
+                parseNumber<double>(fields[5], line),
+                parseVolume(fields[6], line),
+                parseTimestamp(fields[1], line)});
+    }
+}
+
+} // namespace
+
+CSVBarLoader::CSVBarLoader(const std::size_t threads)
+    : _threads{threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())}
+{
+}
+
+BarColumns CSVBarLoader::load(const std::string& csvPath)
+{
+    const MappedFile file{csvPath};
+    return parse(file.text());
+}
+
+BarColumns CSVBarLoader::parse(std::string_view csv)
+{
+    const auto        start{std::chrono::steady_clock::now()};
+    const std::size_t bytes{csv.size()};
+
+    // header line
+    (void)nextLine(csv);
+
+    const std::size_t  chunk_count{std::clamp<std::size_t>(csv.size() / MIN_CHUNK_BYTES, 1, _threads)};
+    std::vector<Chunk> chunks{splitAtLines(csv, chunk_count)};
+
+    const auto run_parallel{[&chunks](const auto& work)
+                            {
+                                std::vector<std::future<void>> pending{};
+                                for (std::size_t i = 1; i < chunks.size(); ++i)
+                                {
+                                    pending.push_back(std::async(std::launch::async, work, std::ref(chunks[i])));
+                                }
+                                if (!chunks.empty())
+                                {
+                                    work(chunks[0]);
+                                }
+                                // get() rethrows the first worker exception after all workers are joined
+                                for (auto& future : pending)
+                                {
+                                    future.wait();
+                                }
+                                for (auto& future : pending)
+                                {
+                                    future.get();
+                                }
+                            }};
+
+    run_parallel([](Chunk& chunk) { chunk.rows = countRows(chunk.text); });
+
+    std::size_t rows{0};
+    for (auto& chunk : chunks)
+    {
+        chunk.first_row = rows;
+        rows += chunk.rows;
+    }
+
+    BarColumns bars{};
+    bars.resize(rows);
+    run_parallel([&bars](const Chunk& chunk) { parseChunk(chunk, bars); });
+
+    _last_stats = Stats{
+        .rows    = rows,
+        .bytes   = bytes,
+        .seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+    return bars;
+}
+
+const CSVBarLoader::Stats& CSVBarLoader::last_stats() const
+{
+    return _last_stats;
+}
@@ -0,0 +1,119 @@
+#include "Checkpoint.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+constexpr std::string_view CHECKPOINT_MAGIC{"MACDCKPT"};
+constexpr std::uint32_t    CHECKPOINT_VERSION{1};
+
+struct CheckpointHeader
+{
+    std::array<char, 8> magic{};
+    std::uint32_t       version{};
+    std::uint32_t       reserved{};
+    std::int64_t        last_bar_ticks{};
+    std::uint64_t       payload_size{};
+    std::uint64_t       checksum{};
+};
+
+// FNV-1a; catches torn or bit-flipped files, not tampering
+std::uint64_t checksum(const std::vector<std::byte>& bytes)
+{
+    std::uint64_t hash{14695981039346656037ULL};
+    for (const auto byte : bytes)
+    {
+        hash ^= static_cast<std::uint64_t>(byte);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+void saveCheckpoint(const std::filesystem::path& path, const Checkpoint& checkpoint)
+{
+    CheckpointHeader header{};
+    std::memcpy(header.magic.data(), CHECKPOINT_MAGIC.data(), header.magic.size());
+    header.version        = CHECKPOINT_VERSION;
+    header.last_bar_ticks = checkpoint.last_bar_timestamp.time_since_epoch().count();
+    header.payload_size   = checkpoint.payload.size();
+    header.checksum       = checksum(checkpoint.payload);
+
+    std::filesystem::path tmp_path{path};
+    tmp_path += ".tmp";
+    {
+        std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+        if (!file)
+        {
+            throw std::runtime_error{"Failed to open checkpoint file " + tmp_path.string()};
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(
+            reinterpret_cast<const char*>(checkpoint.payload.data()),
+            static_cast<std::streamsize>(checkpoint.payload.size()));
+        file.flush();
+        if (!file)
+        {
+            throw std::runtime_error{"Failed to write checkpoint file " + tmp_path.string()};
+        }
+    }
+
+    std::filesystem::rename(tmp_path, path);
+}
+
+std::optional<Checkpoint> loadCheckpoint(const std::filesystem::path& path)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+    {
+        if (!std::filesystem::exists(path))
+        {
+            return std::nullopt;
+        }
+        throw std::runtime_error{"Failed to open checkpoint file " + path.string()};
+    }
+
+    CheckpointHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        throw std::runtime_error{"Checkpoint file " + path.string() + " is truncated"};
+    }
+    if (std::string_view{header.magic.data(), header.magic.size()} != CHECKPOINT_MAGIC)
+    {
+        throw std::runtime_error{"File " + path.string() + " is not a checkpoint"};
+    }
+    if (header.version != CHECKPOINT_VERSION)
+    {
+        throw std::runtime_error{
+            "Checkpoint file " + path.string() + " has unsupported version " + std::to_string(header.version)};
+    }
+
+    const auto remaining{std::filesystem::file_size(path) - sizeof(header)};
+    if (header.payload_size != remaining)
+    {
+        throw std::runtime_error{"Checkpoint file " + path.string() + " is truncated"};
+    }
+
+    Checkpoint checkpoint{
+        .last_bar_timestamp = Bar1min::Timestamp{Bar1min::Timestamp::duration{header.last_bar_ticks}},
+        .payload            = std::vector<std::byte>(header.payload_size)};
+    if (!file.read(reinterpret_cast<char*>(checkpoint.payload.data()), static_cast<std::streamsize>(remaining)))
+    {
+        throw std::runtime_error{"Checkpoint file " + path.string() + " is truncated"};
+    }
+    if (checksum(checkpoint.payload) != header.checksum)
+    {
+        throw std::runtime_error{"Checkpoint file " + path.string() + " failed its checksum"};
+    }
+
+    return checkpoint;
+}
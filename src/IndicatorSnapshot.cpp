@@ -0,0 +1,128 @@
+#include "IndicatorSnapshot.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+//
+// Layout
+
+std::size_t IndicatorSnapshot::Layout::add(
+    const std::string_view indicator, const std::span<const std::string_view> fields)
+{
+    if (contains(indicator))
+    {
+        throw std::invalid_argument{"duplicate indicator in snapshot layout: " + std::string{indicator}};
+    }
+
+    const std::size_t offset{_entries.size()};
+    for (const auto field : fields)
+    {
+        _entries.push_back(Entry{.indicator = std::string{indicator}, .field = std::string{field}});
+    }
+    ++_indicator_count;
+    return offset;
+}
+
+void IndicatorSnapshot::Layout::add_alias(const std::string_view alias, const std::string_view indicator)
+{
+    if (contains(alias))
+    {
+        throw std::invalid_argument{"duplicate indicator in snapshot layout: " + std::string{alias}};
+    }
+    if (!contains(indicator))
+    {
+        throw std::out_of_range{"snapshot layout has no indicator " + std::string{indicator}};
+    }
+
+    _aliases.push_back(Alias{.alias = std::string{alias}, .indicator = std::string{resolve(indicator)}});
+}
+
+std::optional<IndicatorSnapshot::Handle>
+    IndicatorSnapshot::Layout::find(const std::string_view indicator, const std::string_view field) const
+{
+    const std::string_view name{resolve(indicator)};
+    const auto             it{std::ranges::find_if(
+        _entries, [&](const Entry& entry) { return entry.indicator == name && entry.field == field; })};
+    if (it == _entries.end())
+    {
+        return std::nullopt;
+    }
+    return Handle{static_cast<std::uint32_t>(it - _entries.begin())};
+}
+
+bool IndicatorSnapshot::Layout::contains(const std::string_view indicator) const
+{
+    const std::string_view name{resolve(indicator)};
+    return std::ranges::any_of(_entries, [&](const Entry& entry) { return entry.indicator == name; });
+}
+
+std::size_t IndicatorSnapshot::Layout::size() const
+{
+    return _entries.size();
+}
+
+std::size_t IndicatorSnapshot::Layout::indicator_count() const
+{
+    return _indicator_count;
+}
+
+std::string_view IndicatorSnapshot::Layout::resolve(const std::string_view indicator) const
+{
+    const auto it{std::ranges::find_if(_aliases, [&](const Alias& alias) { return alias.alias == indicator; })};
+    return it == _aliases.end() ? indicator : std::string_view{it->indicator};
+}
+
+//
+// IndicatorSnapshot
+
+IndicatorSnapshot::IndicatorSnapshot(std::shared_ptr<const Layout> layout)
+    : _layout{std::move(layout)},
+      _values(_layout->size(), 0.0)
+{
+}
+
+IndicatorSnapshot::Handle
+    IndicatorSnapshot::handle(const std::string_view indicator, const std::string_view field) const
+{
+    const auto handle{_layout->find(indicator, field)};
+    if (!handle.has_value())
+    {
+        throw std::out_of_range{"snapshot has no field " + std::string{indicator} + "." + std::string{field}};
+    }
+    return *handle;
+}
+
+double IndicatorSnapshot::at(const std::string_view indicator, const std::string_view field) const
+{
+    return (*this)[handle(indicator, field)];
+}
+
+bool IndicatorSnapshot::contains(const std::string_view indicator) const
+{
+    return _layout->contains(indicator);
+}
+
+bool IndicatorSnapshot::contains(const std::string_view indicator, const std::string_view field) const
+{
+    return _layout->find(indicator, field).has_value();
+}
+
+std::size_t IndicatorSnapshot::indicator_count() const
+{
+    return _layout->indicator_count();
+}
+
+std::span<const double> IndicatorSnapshot::values() const
+{
+    return _values;
+}
+
+std::span<double> IndicatorSnapshot::values()
+{
+    return _values;
+}
+
+const IndicatorSnapshot::Layout& IndicatorSnapshot::layout() const
+{
+    return *_layout;
+}
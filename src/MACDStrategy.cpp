@@ -0,0 +1,54 @@
+#include "MACDStrategy.hpp"
+
+std::vector<IndicatorConfig> MACDStrategy::indicator_configs(const Params& params)
+{
+    return {
+        IndicatorConfig{.name = "EMA", .params = {{"period", params.ema_period}}},
+        IndicatorConfig{
+            .name   = "MACD",
+            .params = {
+                {"fast_period", params.fast_period},
+                {"slow_period", params.slow_period},
+                {"signal_period", params.signal_period}}},
+        IndicatorConfig{.name = "ATR", .params = {{"period", params.atr_period}}}};
+}
+
+MACDStrategy::MACDStrategy(const IndicatorSnapshot& snapshot, const Params params)
+    : _params{params},
+      _ema{snapshot.handle("EMA", "ema")},
+      _macd{snapshot.handle("MACD", "macd")},
+      _signal{snapshot.handle("MACD", "signal")},
+      _atr{snapshot.handle("ATR", "atr")}
+{
+}
+
+MACDStrategy::Decision
+    MACDStrategy::on_snapshot(const IndicatorSnapshot& snapshot, const double close, const bool is_long)
+{
+    const double macd{snapshot[_macd]};
+    const double ema{snapshot[_ema]};
+    const double atr{snapshot[_atr]};
+    const bool   above{macd > snapshot[_signal]};
+
+    const bool crossed_above{_macd_above_signal.has_value() && !*_macd_above_signal && above};
+    const bool crossed_below{_macd_above_signal.has_value() && *_macd_above_signal && !above};
+    _macd_above_signal = above;
+
+    if (!is_long)
+    {
+        if (close > ema && crossed_above && macd < 0.0 && atr / close < _params.atr_threshold)
+        {
+            return Decision{.action = Action::Buy, .stop_distance = _params.stop_atr_multiple * atr};
+        }
+    }
+    else if (close < ema || crossed_below)
+    {
+        return Decision{.action = Action::Sell};
+    }
+    return Decision{};
+}
+
+const MACDStrategy::Params& MACDStrategy::params() const
+{
+    return _params;
+}
@@ -0,0 +1,92 @@
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd < 0)
+    {
+        throw std::runtime_error{"Failed to open " + path + ": " + std::strerror(errno)};
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        const int error{errno};
+        ::close(fd);
+        throw std::runtime_error{"Failed to stat " + path + ": " + std::strerror(error)};
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0)
+    {
+        _data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (_data == MAP_FAILED)
+        {
+            const int error{errno};
+            _data = nullptr;
+            ::close(fd);
+            throw std::runtime_error{"Failed to map " + path + ": " + std::strerror(error)};
+        }
+        // files are read front to back; let the kernel read ahead aggressively
+        ::madvise(_data, _size, MADV_SEQUENTIAL);
+    }
+
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data{std::exchange(other._data, nullptr)},
+      _size{std::exchange(other._size, 0)}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+std::span<const std::byte> MappedFile::bytes() const
+{
+    return {static_cast<const std::byte*>(_data), _size};
+}
+
+std::string_view MappedFile::text() const
+{
+    return {static_cast<const char*>(_data), _size};
+}
+
+std::size_t MappedFile::size() const
+{
+    return _size;
+}
+
+void MappedFile::unmap()
+{
+    if (_data != nullptr)
+    {
+        ::munmap(_data, _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
@@ -0,0 +1,226 @@
+#include "ParameterSweep.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+template<typename T>
+void requireCandidates(const std::vector<T>& values, const char* parameter)
+{
+    if (values.empty())
+    {
+        throw std::invalid_argument{std::string{"ParameterGrid: no candidates for "} + parameter};
+    }
+}
+
+std::invalid_argument unsupportedAggregation(const int minutes)
+{
+    return std::invalid_argument{"ParameterSweep: unsupported aggregation of " + std::to_string(minutes) + " minutes"};
+}
+
+/**
+ * Checks every parameter of grid has candidates before anything is enumerated.
+ *
+ * @return the (fast, slow) pairs with fast < slow
+ */
+std::vector<std::pair<int, int>> validMACDPeriods(const ParameterGrid& grid)
+{
+    requireCandidates(grid.ema_periods, "ema_periods");
+    requireCandidates(grid.fast_periods, "fast_periods");
+    requireCandidates(grid.slow_periods, "slow_periods");
+    requireCandidates(grid.signal_periods, "signal_periods");
+    requireCandidates(grid.atr_periods, "atr_periods");
+    requireCandidates(grid.atr_thresholds, "atr_thresholds");
+    requireCandidates(grid.stop_atr_multiples, "stop_atr_multiples");
+    requireCandidates(grid.aggregation_minutes, "aggregation_minutes");
+
+    std::vector<std::pair<int, int>> macd_periods{};
+    for (const int fast : grid.fast_periods)
+    {
+        for (const int slow : grid.slow_periods)
+        {
+            if (fast < slow)
+            {
+                macd_periods.emplace_back(fast, slow);
+            }
+        }
+    }
+    if (macd_periods.empty())
+    {
+        throw std::invalid_argument{"ParameterGrid: no fast period is below a slow period"};
+    }
+    return macd_periods;
+}
+
+template<int Minutes>
+BacktestReport backtestAt(const std::span<const Bar1min> bars, const BacktestConfig& config)
+{
+    Backtester<Minutes, std::chrono::minutes> backtester{config};
+    return backtester.run(bars);
+}
+
+} // namespace
+
+std::vector<SweepParams> ParameterGrid::expand() const
+{
+    const auto macd_periods{validMACDPeriods(*this)};
+    const auto count{
+        ema_periods.size() * macd_periods.size() * signal_periods.size() * atr_periods.size() * atr_thresholds.size()
+        * stop_atr_multiples.size() * aggregation_minutes.size()};
+
+    std::vector<SweepParams> points{};
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // i in mixed radix, one digit per parameter; the last parameter varies fastest
+        std::size_t rest{i};
+        const auto  digit{[&rest](const auto& values) -> const auto&
+                         {
+                             const auto& value{values[rest % values.size()]};
+                             rest /= values.size();
+                             return value;
+                         }};
+
+        const int    minutes{digit(aggregation_minutes)};
+        const double stop{digit(stop_atr_multiples)};
+        const double threshold{digit(atr_thresholds)};
+        const int    atr{digit(atr_periods)};
+        const int    signal{digit(signal_periods)};
+        const auto [fast, slow]{digit(macd_periods)};
+        const int ema{digit(ema_periods)};
+        points.push_back(SweepParams{
+            .strategy =
+                {.ema_period        = ema,
+                 .fast_period       = fast,
+                 .slow_period       = slow,
+                 .signal_period     = signal,
+                 .atr_period        = atr,
+                 .atr_threshold     = threshold,
+                 .stop_atr_multiple = stop},
+            .aggregation_minutes = minutes});
+    }
+    return points;
+}
+
+std::vector<SweepParams> ParameterGrid::sample(const std::size_t count, const std::uint64_t seed) const
+{
+    const auto macd_periods{validMACDPeriods(*this)};
+
+    std::mt19937_64 rng{seed};
+    const auto      pick{[&rng](const auto& values) -> const auto&
+                    {
+                        std::uniform_int_distribution<std::size_t> index{0, values.size() - 1};
+                        return values[index(rng)];
+                    }};
+
+    std::vector<SweepParams> points{};
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto [fast, slow]{pick(macd_periods)};
+        points.push_back(SweepParams{
+            .strategy =
+                {.ema_period        = pick(ema_periods),
+                 .fast_period       = fast,
+                 .slow_period       = slow,
+                 .signal_period     = pick(signal_periods),
+                 .atr_period        = pick(atr_periods),
+                 .atr_threshold     = pick(atr_thresholds),
+                 .stop_atr_multiple = pick(stop_atr_multiples)},
+            .aggregation_minutes = pick(aggregation_minutes)});
+    }
+    return points;
+}
+
+ParameterSweep::ParameterSweep(
+    const std::span<const Bar1min> bars, const BacktestConfig& base, const std::size_t threads)
+    : _bars{bars},
+      _base{base},
+      _threads{threads}
+{
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::span<const SweepParams> candidates) const
+{
+    for (const auto& params : candidates)
+    {
+        if (std::ranges::find(SUPPORTED_AGGREGATION_MINUTES, params.aggregation_minutes)
+            == SUPPORTED_AGGREGATION_MINUTES.end())
+        {
+            throw unsupportedAggregation(params.aggregation_minutes);
+        }
+    }
+
+    // each task writes only its own slot, so results need no locking
+    std::vector<SweepResult> results(candidates.size());
+    {
+        WorkStealingPool pool{_threads};
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            pool.submit(
+                [this, &results, &candidates, i]
+                {
+                    results[i] = SweepResult{.params = candidates[i], .report = backtest(_bars, _base, candidates[i])};
+                });
+        }
+        pool.wait();
+    }
+
+    std::ranges::sort(
+        results,
+        [](const SweepResult& a, const SweepResult& b)
+        {
+            if (a.report.total_return() != b.report.total_return())
+            {
+                return a.report.total_return() > b.report.total_return();
+            }
+            return a.report.max_drawdown < b.report.max_drawdown;
+        });
+    return results;
+}
+
+BacktestReport
+    ParameterSweep::backtest(const std::span<const Bar1min> bars, const BacktestConfig& base, const SweepParams& params)
+{
+    BacktestConfig config{base};
+    config.strategy = params.strategy;
+
+    switch (params.aggregation_minutes)
+    {
+        case 1:
+            return backtestAt<1>(bars, config);
+        case 5:
+            return backtestAt<5>(bars, config);
+        case 15:
+            return backtestAt<15>(bars, config);
+        case 30:
+            return backtestAt<30>(bars, config);
+        case 60:
+            return backtestAt<60>(bars, config);
+        default:
+            throw unsupportedAggregation(params.aggregation_minutes);
+    }
+}
+
+void writeSweepResults(std::ostream& out, const std::span<const SweepResult> results, const std::size_t limit)
+{
+    out << "rank,aggregation_minutes,ema_period,fast_period,slow_period,signal_period,atr_period,atr_threshold,"
+           "stop_atr_multiple,total_return,max_drawdown,trades,winning_trades,stopped_out_trades,final_equity\n";
+    for (std::size_t i = 0; i < std::min(limit, results.size()); ++i)
+    {
+        const auto& [params, report]{results[i]};
+        const auto& strategy{params.strategy};
+        out << i + 1 << ',' << params.aggregation_minutes << ',' << strategy.ema_period << ',' << strategy.fast_period
+            << ',' << strategy.slow_period << ',' << strategy.signal_period << ',' << strategy.atr_period << ','
+            << strategy.atr_threshold << ',' << strategy.stop_atr_multiple << ',' << report.total_return() << ','
+            << report.max_drawdown << ',' << report.trades << ',' << report.winning_trades << ','
+            << report.stopped_out_trades << ',' << report.final_equity << '\n';
+    }
+}
@@ -0,0 +1,135 @@
+#include "SimulatedBroker.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+constexpr double BPS{1e-4};
+
+} // namespace
+
+SimulatedBroker::SimulatedBroker(const double starting_cash, const FillModel fill_model)
+    : _starting_cash{starting_cash},
+      _fill_model{fill_model},
+      _cash{starting_cash},
+      _peak_equity{starting_cash}
+{
+    if (!(starting_cash > 0.0))
+    {
+        throw std::invalid_argument{"SimulatedBroker: starting cash must be positive"};
+    }
+    if (fill_model.slippage_bps < 0.0 || fill_model.commission_per_share < 0.0)
+    {
+        throw std::invalid_argument{"SimulatedBroker: slippage and commission must not be negative"};
+    }
+}
+
+void SimulatedBroker::on_bar(const Bar1min& bar)
+{
+    switch (std::exchange(_pending, PendingOrder::None))
+    {
+        case PendingOrder::Buy:
+            buy(bar.open(), bar.timestamp());
+            _stop_price = _entry_price - _pending_stop_distance;
+            break;
+        case PendingOrder::Sell:
+            sell(bar.open(), bar.timestamp(), false);
+            break;
+        case PendingOrder::None:
+            break;
+    }
+
+    if (is_long() && bar.low() <= _stop_price)
+    {
+        sell(std::min(bar.open(), _stop_price), bar.timestamp(), true);
+    }
+
+    _last_close = bar.close();
+    const double current_equity{equity()};
+    _peak_equity  = std::max(_peak_equity, current_equity);
+    _max_drawdown = std::max(_max_drawdown, (_peak_equity - current_equity) / _peak_equity);
+}
+
+void SimulatedBroker::submit_buy(const double stop_distance)
+{
+    if (is_long() || has_pending_order())
+    {
+        return;
+    }
+    _pending               = PendingOrder::Buy;
+    _pending_stop_distance = stop_distance;
+}
+
+void SimulatedBroker::submit_sell()
+{
+    if (!is_long() || has_pending_order())
+    {
+        return;
+    }
+    _pending = PendingOrder::Sell;
+}
+
+bool SimulatedBroker::is_long() const
+{
+    return _quantity > 0.0;
+}
+
+bool SimulatedBroker::has_pending_order() const
+{
+    return _pending != PendingOrder::None;
+}
+
+double SimulatedBroker::starting_cash() const
+{
+    return _starting_cash;
+}
+
+double SimulatedBroker::cash() const
+{
+    return _cash;
+}
+
+double SimulatedBroker::equity() const
+{
+    return _cash + _quantity * _last_close;
+}
+
+double SimulatedBroker::max_drawdown() const
+{
+    return _max_drawdown;
+}
+
+const std::vector<SimulatedBroker::Trade>& SimulatedBroker::trades() const
+{
+    return _trades;
+}
+
+void SimulatedBroker::buy(const double price, const Bar1min::Timestamp timestamp)
+{
+    _entry_price = price * (1.0 + _fill_model.slippage_bps * BPS);
+    _quantity    = _cash / (_entry_price + _fill_model.commission_per_share);
+    _entry_cost  = _cash;
+    _entry_time  = timestamp;
+    _cash        = 0.0;
+}
+
+void SimulatedBroker::sell(const double price, const Bar1min::Timestamp timestamp, const bool stopped_out)
+{
+    const double exit_price{price * (1.0 - _fill_model.slippage_bps * BPS)};
+    const double proceeds{_quantity * (exit_price - _fill_model.commission_per_share)};
+
+    _trades.push_back(Trade{
+        .entry_time  = _entry_time,
+        .exit_time   = timestamp,
+        .quantity    = _quantity,
+        .entry_price = _entry_price,
+        .exit_price  = exit_price,
+        .pnl         = proceeds - _entry_cost,
+        .stopped_out = stopped_out});
+
+    _cash     += proceeds;
+    _quantity  = 0.0;
+}
@@ -0,0 +1,65 @@
+#include "SymbolTable.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+SymbolTable& SymbolTable::instance()
+{
+    static SymbolTable instance{};
+    return instance;
+}
+
+SymbolId SymbolTable::intern(const std::string_view symbol)
+{
+    auto& table{instance()};
+
+    {
+        std::shared_lock lock{table._mutex};
+        if (const auto it = table._ids.find(symbol); it != table._ids.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock{table._mutex};
+    if (const auto it = table._ids.find(symbol); it != table._ids.end())
+    {
+        return it->second;
+    }
+
+    const SymbolId     id{static_cast<std::uint32_t>(table._names.size())};
+    const std::string& stored{table._names.emplace_back(symbol)};
+    table._ids.emplace(stored, id);
+    return id;
+}
+
+std::optional<SymbolId> SymbolTable::find(const std::string_view symbol)
+{
+    auto&            table{instance()};
+    std::shared_lock lock{table._mutex};
+
+    if (const auto it = table._ids.find(symbol); it != table._ids.end())
+    {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::string_view SymbolTable::name(const SymbolId id)
+{
+    auto&            table{instance()};
+    std::shared_lock lock{table._mutex};
+
+    if (id.value >= table._names.size())
+    {
+        throw std::out_of_range{"SymbolTable::name(): unknown symbol id " + std::to_string(id.value)};
+    }
+    return table._names[id.value];
+}
+
+std::size_t SymbolTable::size()
+{
+    auto&            table{instance()};
+    std::shared_lock lock{table._mutex};
+    return table._names.size();
+}
@@ -1,45 +1,131 @@
 #include "Utils.hpp"
 
 #include "Bar.hpp"
+#include "CSVBarLoader.hpp"
+#include "SymbolTable.hpp"
 
 #include <chrono>
-#include <fstream>
-#include <iomanip>
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
-Bar1min::Timestamp parse_helper(const std::string& timestamp, const char* fmt_string)
+namespace
 {
-    std::stringstream ss{timestamp};
 
-    std::tm tm{};
-    ss >> std::get_time(&tm, fmt_string);
-    if (ss.fail())
+// digits at fixed offsets; returns -1 if any character is not a digit
+constexpr int parseDigits(const std::string_view text, const std::size_t offset, const std::size_t count)
+{
+    int value{0};
+    for (std::size_t i = offset; i < offset + count; ++i)
     {
-        throw std::invalid_argument{"Invalid timestamp format"};
+        const auto digit{static_cast<unsigned>(text[i] - '0')};
+        if (digit > 9)
+        {
+            return -1;
+        }
+        value = value * 10 + static_cast<int>(digit);
     }
+    return value;
+}
 
-    time_t epoch_ns{timegm(&tm)};
-    auto   ts{std::chrono::system_clock::from_time_t(epoch_ns)};
-
-    return {std::chrono::time_point_cast<std::chrono::minutes>(ts)};
+[[noreturn]]
+void invalidTimestamp(const std::string_view timestamp)
+{
+    throw std::invalid_argument{"Invalid RFC3339 timestamp: " + std::string{timestamp}};
 }
 
-Bar1min::Timestamp parseRFC3339UTCTimestamp(const std::string& timestamp)
+} // namespace
+
+std::chrono::sys_time<std::chrono::nanoseconds> parseRFC3339Timestamp(const std::string_view timestamp)
 {
-    if (timestamp.ends_with('Z') || timestamp.ends_with('z'))
+    using namespace std::chrono;
+
+    // YYYY-MM-DDThh:mm:ss is 19 characters; at least the 'Z' must follow
+    if (timestamp.size() < 20 || timestamp[4] != '-' || timestamp[7] != '-' || timestamp[13] != ':'
+        || timestamp[16] != ':')
+    {
+        invalidTimestamp(timestamp);
+    }
+    if (const char separator{timestamp[10]}; separator != 'T' && separator != 't' && separator != ' ')
     {
-        // Format: 2025-05-19T13:30:00Z
-        return parse_helper(timestamp, "%Y-%m-%dT%H:%M:%S");
+        invalidTimestamp(timestamp);
     }
-    if (timestamp.ends_with("+00:00"))
+
+    const int y{parseDigits(timestamp, 0, 4)};
+    const int mo{parseDigits(timestamp, 5, 2)};
+    const int d{parseDigits(timestamp, 8, 2)};
+    const int h{parseDigits(timestamp, 11, 2)};
+    const int mi{parseDigits(timestamp, 14, 2)};
+    const int s{parseDigits(timestamp, 17, 2)};
+    if (y < 0 || mo < 0 || d < 0 || h < 0 || h > 23 || mi < 0 || mi > 59 || s < 0 || s > 60)
     {
-        // Format: 2025-05-19 13:30:00+00:00
-        return parse_helper(timestamp, "%Y-%m-%d %H:%M:%S");
+        invalidTimestamp(timestamp);
     }
-    throw std::invalid_argument{"timestamp must be UTC (end with 'Z' or '+00:00')"};
 
-    return {};
+    const year_month_day date{year{y}, month{static_cast<unsigned>(mo)}, day{static_cast<unsigned>(d)}};
+    if (!date.ok())
+    {
+        invalidTimestamp(timestamp);
+    }
+
+    std::size_t pos{19};
+    nanoseconds fraction{0};
+    if (timestamp[pos] == '.')
+    {
+        // digits past nanosecond precision are truncated
+        std::int64_t scale{100'000'000};
+        ++pos;
+        const std::size_t fraction_begin{pos};
+        while (pos < timestamp.size() && timestamp[pos] >= '0' && timestamp[pos] <= '9')
+        {
+            fraction += nanoseconds{(timestamp[pos] - '0') * scale};
+            scale /= 10;
+            ++pos;
+        }
+        if (pos == fraction_begin)
+        {
+            invalidTimestamp(timestamp);
+        }
+    }
+
+    minutes offset{0};
+    if (pos + 1 == timestamp.size() && (timestamp[pos] == 'Z' || timestamp[pos] == 'z'))
+    {
+        // UTC
+    }
+    else if (pos + 6 == timestamp.size() && (timestamp[pos] == '+' || timestamp[pos] == '-')
+             && timestamp[pos + 3] == ':')
+    {
+        const int offset_hours{parseDigits(timestamp, pos + 1, 2)};
+        const int offset_minutes{parseDigits(timestamp, pos + 4, 2)};
+        if (offset_hours < 0 || offset_hours > 23 || offset_minutes < 0 || offset_minutes > 59)
+        {
+            invalidTimestamp(timestamp);
+        }
+        offset = hours{offset_hours} + minutes{offset_minutes};
+        if (timestamp[pos] == '-')
+        {
+            offset = -offset;
+        }
+    }
+    else
+    {
+        invalidTimestamp(timestamp);
+    }
+
+    // local time = UTC + offset
+    return sys_days{date} + hours{h} + minutes{mi} + seconds{s} + fraction - offset;
+}
+
+Bar1min::Timestamp parseRFC3339UTCTimestamp(const std::string_view timestamp)
+{
+    if (!timestamp.ends_with('Z') && !timestamp.ends_with('z') && !timestamp.ends_with("+00:00"))
+    {
+        throw std::invalid_argument{"timestamp must be UTC (end with 'Z' or '+00:00')"};
+    }
+    return truncateTimestamp<std::chrono::minutes>(parseRFC3339Timestamp(timestamp));
 }
 
 Bar1min createBarFromCSVLine(const std::string& line)
@@ -58,7 +144,7 @@ Bar1min createBarFromCSVLine(const std::string& line)
         throw std::invalid_argument{"CSV line must have at least 7 columns"};
     }
 
-    std::string symbol    = tokens[0];
+    SymbolId    symbol    = SymbolTable::intern(tokens[0]);
     std::string timestamp = tokens[1];
     double      open      = std::stod(tokens[2]);
     double      high      = std::stod(tokens[3]);
@@ -68,32 +154,10 @@ Bar1min createBarFromCSVLine(const std::string& line)
 
     Bar1min::Timestamp ts = parseRFC3339UTCTimestamp(timestamp);
 
-    return Bar1min{std::move(symbol), open, high, low, close, volume, ts};
+    return Bar1min{symbol, open, high, low, close, volume, ts};
 }
 
 std::vector<Bar1min> createBarsFromCSV(const std::string& csvPath)
 {
-    std::ifstream file{csvPath};
-    if (!file.is_open())
-    {
-        throw std::runtime_error{"Failed to open CSV file: " + csvPath};
-    }
-
-    std::vector<Bar1min> bars;
-    std::string          line;
-
-    if (std::getline(file, line))
-    {
-        // Skip header line
-    }
-
-    while (std::getline(file, line))
-    {
-        if (!line.empty())
-        {
-            bars.push_back(createBarFromCSVLine(line));
-        }
-    }
-
-    return bars;
+    return CSVBarLoader{}.load(csvPath).to_bars();
 }
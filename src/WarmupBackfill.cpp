@@ -0,0 +1,123 @@
+#include "WarmupBackfill.hpp"
+
+#include "BarArchive.hpp"
+#include "Utils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+// sorts before every real bar, so a symbol without history accepts its first bar
+constexpr Bar1min::Timestamp NO_BAR{Bar1min::Timestamp::min()};
+
+} // namespace
+
+WarmupBackfill::WarmupBackfill(BarSink sink, GapSink gap_sink)
+    : _sink{std::move(sink)},
+      _gap_sink{std::move(gap_sink)}
+{
+    if (!_sink)
+    {
+        throw std::invalid_argument{"WarmupBackfill: sink must be callable"};
+    }
+}
+
+void WarmupBackfill::resume_after(const SymbolId symbol, const Bar1min::Timestamp timestamp)
+{
+    if (symbol.value >= _last_timestamps.size())
+    {
+        _last_timestamps.resize(symbol.value + 1, NO_BAR);
+    }
+    _last_timestamps[symbol.value] = std::max(_last_timestamps[symbol.value], timestamp);
+}
+
+std::size_t WarmupBackfill::replay(const std::span<const Bar1min> bars)
+{
+    std::size_t forwarded{0};
+    for (const auto& bar : bars)
+    {
+        if (accept(bar))
+        {
+            _sink(bar);
+            ++forwarded;
+        }
+    }
+    return forwarded;
+}
+
+std::size_t WarmupBackfill::replay_csv(const std::string& csv_path)
+{
+    return replay(createBarsFromCSV(csv_path));
+}
+
+std::size_t WarmupBackfill::replay_archive(const std::string& archive_path)
+{
+    const BarArchive     archive{archive_path};
+    std::vector<Bar1min> bars{};
+    std::size_t          forwarded{0};
+    for (const auto& block : archive.blocks())
+    {
+        BarArchive::decode(block, bars);
+        forwarded += replay(bars);
+    }
+    return forwarded;
+}
+
+bool WarmupBackfill::on_live_bar(const Bar1min& bar)
+{
+    if (!accept(bar))
+    {
+        return false;
+    }
+    _sink(bar);
+    return true;
+}
+
+std::optional<Bar1min::Timestamp> WarmupBackfill::last_timestamp(const SymbolId symbol) const
+{
+    if (symbol.value >= _last_timestamps.size() || _last_timestamps[symbol.value] == NO_BAR)
+    {
+        return std::nullopt;
+    }
+    return _last_timestamps[symbol.value];
+}
+
+std::size_t WarmupBackfill::duplicates_dropped() const
+{
+    return _duplicates_dropped;
+}
+
+std::size_t WarmupBackfill::gaps() const
+{
+    return _gaps;
+}
+
+bool WarmupBackfill::accept(const Bar1min& bar)
+{
+    const std::uint32_t index{bar.symbol().value};
+    if (index >= _last_timestamps.size())
+    {
+        _last_timestamps.resize(index + 1, NO_BAR);
+    }
+
+    Bar1min::Timestamp& last{_last_timestamps[index]};
+    if (bar.timestamp() <= last)
+    {
+        ++_duplicates_dropped;
+        return false;
+    }
+
+    if (last != NO_BAR && bar.timestamp() - last != Bar1min::duration())
+    {
+        ++_gaps;
+        if (_gap_sink)
+        {
+            _gap_sink(bar.symbol());
+        }
+    }
+    last = bar.timestamp();
+    return true;
+}
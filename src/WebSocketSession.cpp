@@ -1,6 +1,5 @@
 #include "WebSocketSession.hpp"
 
-#include <thread>
 
 std::shared_ptr<WebSocketSession>
     WebSocketSession::create(net::io_context& ioc, const WebSocketSessionConfig& config, const frame_handler& on_frame)
@@ -11,13 +10,18 @@ std::shared_ptr<WebSocketSession>
 }
 
 WebSocketSession::WebSocketSession(net::io_context& ioc, WebSocketSessionConfig cfg)
-    : _config{std::move(cfg)},
+    : _ioc{ioc},
+      _config{std::move(cfg)},
       _resolver{net::make_strand(ioc)},
-      _ws{net::make_strand(ioc), _config.ssl_ctxt},
+      _ws{std::make_shared<ws_stream_t>(net::make_strand(ioc), _config.ssl_ctxt)},
       _ping_timer{net::make_strand(ioc)},
+      _reconnect_timer{net::make_strand(ioc)},
+      _backoff{RECONNECT_INITIAL_DELAY, RECONNECT_MAX_DELAY},
       _connected{false},
-      _should_reconnect{true}
+      _should_reconnect{true},
+      _reconnect_pending{false}
 {
+    _buffer.reserve(INITIAL_READ_BUFFER_CAPACITY);
 }
 
 void WebSocketSession::start()
@@ -33,16 +37,17 @@ void WebSocketSession::stop()
     _should_reconnect = false;
     _connected        = false;
     _ping_timer.cancel();
+    _reconnect_timer.cancel();
 
-    if (_ws.is_open())
+    if (_ws->is_open())
     {
-        _ws.async_close(
+        _ws->async_close(
             websocket::close_code::normal,
-            [self = shared_from_this(), this](const beast::error_code& ec)
+            [self = shared_from_this(), ws = _ws](const beast::error_code& ec)
             {
-                if (ec)
+                if (ec && self->is_current(ws))
                 {
-                    fail(ec, "close");
+                    self->fail(ec, "close");
                 }
             });
     }
@@ -57,9 +62,26 @@ void WebSocketSession::send(const std::string_view text)
     }
 }
 
+void WebSocketSession::set_disconnect_handler(disconnect_handler handler)
+{
+    _disconnect_handler = std::move(handler);
+}
+
 void WebSocketSession::fail(const beast::error_code& ec, char const* what)
 {
+    // operations aborted by the teardown of a dropped connection land here too; one reconnect is enough
+    if (_reconnect_pending)
+    {
+        return;
+    }
+
+    const bool was_connected{_connected};
     _connected = false;
+    if (was_connected && _disconnect_handler)
+    {
+        _disconnect_handler();
+    }
+
     if (_should_reconnect)
     {
         reconnect();
@@ -82,11 +104,17 @@ void WebSocketSession::on_resolve(const beast::error_code& ec, const tcp::resolv
         return fail(ec, "resolve");
     }
 
-    beast::get_lowest_layer(_ws).expires_after(std::chrono::seconds(30));
-    beast::get_lowest_layer(_ws).async_connect(
+    beast::get_lowest_layer(*_ws).expires_after(std::chrono::seconds(30));
+    beast::get_lowest_layer(*_ws).async_connect(
         results,
-        [self = shared_from_this()](const beast::error_code& ec, const tcp::resolver::results_type::endpoint_type& ep)
-        { self->on_connect(ec, ep); });
+        [self = shared_from_this(),
+         ws   = _ws](const beast::error_code& ec, const tcp::resolver::results_type::endpoint_type& ep)
+        {
+            if (self->is_current(ws))
+            {
+                self->on_connect(ec, ep);
+            }
+        });
 }
 
 void WebSocketSession::on_connect(
@@ -97,9 +125,9 @@ void WebSocketSession::on_connect(
         return fail(error_code, "connect");
     }
 
-    beast::get_lowest_layer(_ws).expires_after(std::chrono::seconds(30));
+    beast::get_lowest_layer(*_ws).expires_after(std::chrono::seconds(30));
 
-    if (!SSL_set_tlsext_host_name(_ws.next_layer().native_handle(), _config.host.c_str()))
+    if (!SSL_set_tlsext_host_name(_ws->next_layer().native_handle(), _config.host.c_str()))
     {
         error_code = beast::error_code(static_cast<int>(::ERR_get_error()), net::error::get_ssl_category());
         return fail(error_code, "connect");
@@ -107,9 +135,15 @@ void WebSocketSession::on_connect(
 
     _host_port = _config.host + ':' + std::to_string(endpoint_type.port());
 
-    _ws.next_layer().async_handshake(
+    _ws->next_layer().async_handshake(
         ssl::stream_base::client,
-        [self = shared_from_this()](const beast::error_code& ec) { self->on_ssl_handshake(ec); });
+        [self = shared_from_this(), ws = _ws](const beast::error_code& ec)
+        {
+            if (self->is_current(ws))
+            {
+                self->on_ssl_handshake(ec);
+            }
+        });
 }
 
 void WebSocketSession::on_ssl_handshake(const beast::error_code& error_code)
@@ -119,17 +153,23 @@ void WebSocketSession::on_ssl_handshake(const beast::error_code& error_code)
         return fail(error_code, "ssl_handshake");
     }
 
-    beast::get_lowest_layer(_ws).expires_never();
-    _ws.set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
-    _ws.set_option(
+    beast::get_lowest_layer(*_ws).expires_never();
+    _ws->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+    _ws->set_option(
         websocket::stream_base::decorator(
             [](websocket::request_type& req)
             { req.set(http::field::user_agent, std::string(BOOST_BEAST_VERSION_STRING) + " macd-trading-bot"); }));
 
-    _ws.async_handshake(
+    _ws->async_handshake(
         _host_port,
         _config.endpoint,
-        [self = shared_from_this()](const beast::error_code& ec) { self->on_handshake(ec); });
+        [self = shared_from_this(), ws = _ws](const beast::error_code& ec)
+        {
+            if (self->is_current(ws))
+            {
+                self->on_handshake(ec);
+            }
+        });
 }
 
 void WebSocketSession::on_handshake(const beast::error_code& ec)
@@ -140,21 +180,19 @@ void WebSocketSession::on_handshake(const beast::error_code& ec)
     }
 
     _connected = true;
+    _backoff.reset();
 
     if (!_config.auth_msg.empty())
     {
-        send(_config.auth_msg);
+        _write_queue.emplace(_config.auth_msg);
     }
     if (!_config.sub_msg.empty())
     {
-        send(_config.sub_msg);
+        _write_queue.emplace(_config.sub_msg);
     }
 
-    // Flush any queued messages
-    if (!_write_queue.empty())
-    {
-        do_write();
-    }
+    // a single write chain drains the queue; send() would already have started one for the first message
+    do_write();
 
     arm_heartbeat();
     do_read();
@@ -162,12 +200,15 @@ void WebSocketSession::on_handshake(const beast::error_code& ec)
 
 void WebSocketSession::do_read()
 { // NOLINT (misc-no-recursion)
-    _ws.async_read(
+    _ws->async_read(
     _buffer,
-    [self = shared_from_this()]( // NOLINT (misc-no-recursion)
+    [self = shared_from_this(), ws = _ws]( // NOLINT (misc-no-recursion)
       const beast::error_code &ec,
       const std::size_t bytes_transferred) {
-      self->on_read(ec, bytes_transferred);
+      if (self->is_current(ws))
+      {
+          self->on_read(ec, bytes_transferred);
+      }
     });
 }
 
@@ -185,10 +226,12 @@ WebSocketSession::on_read( // NOLINT (misc-no-recursion)
 
     if (_frame_handler)
     {
-        const auto data = beast::buffers_to_string(_buffer.data());
-        _frame_handler(data);
+        // flat_buffer holds the whole message contiguously, so the handler reads it in place
+        const auto data = _buffer.cdata();
+        _frame_handler(std::string_view{static_cast<const char*>(data.data()), data.size()});
     }
 
+    // clear() keeps the allocation: once the buffer has grown to the largest burst frame, reads stop allocating
     _buffer.clear();
     do_read();
 }
@@ -198,12 +241,15 @@ void WebSocketSession::do_write()
     if (_write_queue.empty() || !_connected)
         return;
 
-    _ws.async_write(
+    _ws->async_write(
     net::buffer(_write_queue.front()),
-    [self = shared_from_this()]( // NOLINT (misc-no-recursion)
+    [self = shared_from_this(), ws = _ws]( // NOLINT (misc-no-recursion)
       const beast::error_code &ec,
       std::size_t bytes_transferred) {
-      self->on_write(ec, bytes_transferred);
+      if (self->is_current(ws))
+      {
+          self->on_write(ec, bytes_transferred);
+      }
     });
 }
 
@@ -237,10 +283,14 @@ void WebSocketSession::on_ping_timer(const beast::error_code& ec)
     if (ec || !_connected)
         return;
 
-    _ws.async_ping(
+    _ws->async_ping(
         {},
-        [self = shared_from_this()](const beast::error_code& ec)
+        [self = shared_from_this(), ws = _ws](const beast::error_code& ec)
         {
+            if (!self->is_current(ws))
+            {
+                return;
+            }
             if (ec)
             {
                 self->fail(ec, "ping");
@@ -255,10 +305,34 @@ void WebSocketSession::reconnect()
     if (!_should_reconnect)
         return;
 
-    std::this_thread::sleep_for(std::chrono::seconds(5));
+    _reconnect_pending = true;
+    _ping_timer.cancel();
 
-    if (_should_reconnect)
+    // closing the socket aborts outstanding reads/writes; whenever they complete, they hold on to this stream and are
+    // ignored once on_reconnect_timer() has replaced it
+    beast::error_code ignored;
+    beast::get_lowest_layer(*_ws).socket().close(ignored);
+
+    _reconnect_timer.expires_after(_backoff.next_delay());
+    _reconnect_timer.async_wait([self = shared_from_this()](const beast::error_code& ec)
+                                { self->on_reconnect_timer(ec); });
+}
+
+void WebSocketSession::on_reconnect_timer(const beast::error_code& ec)
+{
+    _reconnect_pending = false;
+    if (ec || !_should_reconnect)
     {
-        start();
+        return;
     }
+
+    _write_queue = {};
+    _buffer.clear();
+    _ws = std::make_shared<ws_stream_t>(net::make_strand(_ioc), _config.ssl_ctxt);
+    resolve();
+}
+
+bool WebSocketSession::is_current(const std::shared_ptr<ws_stream_t>& ws) const
+{
+    return ws == _ws;
 }
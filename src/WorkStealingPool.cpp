@@ -0,0 +1,135 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    _queues.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+
+    // workers start last, once every queue they may steal from exists
+    _workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        _workers.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock{_mutex};
+        _stopping = true;
+    }
+    _work_available.notify_all();
+    _workers.clear();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    auto& queue{*_queues[_next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size()]};
+    {
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard lock{_mutex};
+        ++_queued;
+        ++_unfinished;
+    }
+    _work_available.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock lock{_mutex};
+    _all_done.wait(lock, [this] { return _unfinished == 0; });
+    if (_error)
+    {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+std::size_t WorkStealingPool::thread_count() const
+{
+    return _workers.size();
+}
+
+void WorkStealingPool::worker_loop(const std::size_t index)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock{_mutex};
+            _work_available.wait(lock, [this] { return _queued > 0 || _stopping; });
+            if (_queued == 0)
+            {
+                return;
+            }
+            // claims one queued task; it stays in some deque until taken below
+            --_queued;
+        }
+
+        std::optional<Task> task{};
+        while (!task)
+        {
+            task = take(index);
+        }
+
+        std::exception_ptr error{};
+        try
+        {
+            (*task)();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock{_mutex};
+        if (error && !_error)
+        {
+            _error = error;
+        }
+        if (--_unfinished == 0)
+        {
+            _all_done.notify_all();
+        }
+    }
+}
+
+std::optional<WorkStealingPool::Task> WorkStealingPool::take(const std::size_t index)
+{
+    {
+        auto&           own{*_queues[index]};
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty())
+        {
+            Task task{std::move(own.tasks.back())};
+            own.tasks.pop_back();
+            return task;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < _queues.size(); ++offset)
+    {
+        auto&           victim{*_queues[(index + offset) % _queues.size()]};
+        std::lock_guard lock{victim.mutex};
+        if (!victim.tasks.empty())
+        {
+            Task task{std::move(victim.tasks.front())};
+            victim.tasks.pop_front();
+            return task;
+        }
+    }
+    return std::nullopt;
+}
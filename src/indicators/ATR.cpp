@@ -1,8 +1,12 @@
 #include "indicators/ohlcv/ATR.hpp"
 
 #include "IndicatorRegistrar.hpp"
+#include "indicators/Kernels.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <vector>
 
 REGISTER_INDICATOR(ATR, OHLCVIndicator)
 
@@ -34,35 +38,184 @@ bool ATR::is_ready() const
 
 void ATR::write(const OHLCV& ohlcv)
 {
+    if (_shared_tr != nullptr)
+    {
+        // the engine has already written the TR node for this bar
+        if (_shared_tr->is_ready())
+        {
+            update(_shared_tr->value());
+        }
+        return;
+    }
+
     if (_prev_close == -1.0)
     {
         _prev_close = ohlcv.close;
         return;
     }
 
-    const double high{ohlcv.high};
-    const double low{ohlcv.low};
-    const double tr{calc_tr(high, low, _prev_close)};
+    update(TrueRange::calc(ohlcv.high, ohlcv.low, _prev_close));
+    _prev_close = ohlcv.close;
+}
+
+void ATR::save_state(StateWriter& writer) const
+{
+    writer.write<std::uint64_t>(_period);
+    writer.write(_val);
+    writer.write(_prev_close);
+    writer.write<std::uint64_t>(_n);
+}
+
+void ATR::load_state(StateReader& reader)
+{
+    if (reader.read<std::uint64_t>() != _period)
+    {
+        throw std::runtime_error{"ATR::load_state(): state was saved with a different period"};
+    }
+    _val        = reader.read<double>();
+    _prev_close = reader.read<double>();
+    _n          = reader.read<std::uint64_t>();
+}
+
+std::vector<IndicatorConfig> ATR::dependencies() const
+{
+    return {IndicatorConfig{.name = TrueRange::name}};
+}
+
+void ATR::bind_dependencies(const std::span<const OHLCVIndicator* const> nodes)
+{
+    _shared_tr = nodes.size() == 1 ? dynamic_cast<const TrueRange*>(nodes[0]) : nullptr;
+    if (_shared_tr == nullptr)
+    {
+        throw std::invalid_argument{"ATR::bind_dependencies(): expected one TR node"};
+    }
+}
+
+void ATR::write(
+    const std::span<const double> highs, const std::span<const double> lows, const std::span<const double> closes)
+{
+    write_batch(highs, lows, closes, nullptr);
+}
+
+void ATR::write(
+    const std::span<const double> highs,
+    const std::span<const double> lows,
+    const std::span<const double> closes,
+    const std::span<double>       out)
+{
+    if (out.size() != closes.size())
+    {
+        throw std::invalid_argument{"ATR::write(): output column must match input length"};
+    }
+    write_batch(highs, lows, closes, out.data());
+}
+
+std::span<const std::string_view> ATR::fields() const
+{
+    return FIELDS;
+}
+
+void ATR::read(const std::span<double> out) const
+{
+    out[0] = value();
+}
+
+double ATR::value() const
+{
     if (!is_ready())
     {
-        ++_n;
+        throw std::runtime_error("ATR::value(): no valid ATR data");
     }
 
-    _val        = (_val * static_cast<double>(_n - 1) + tr) / static_cast<double>(_n);
-    _prev_close = ohlcv.close;
+    return _val;
 }
 
-OHLCVIndicator::Snapshot ATR::read() const
+void ATR::update(const double tr)
 {
     if (!is_ready())
     {
-        throw std::runtime_error("ATR::read(): no valid ATR data");
+        ++_n;
     }
 
-    return {{"atr", _val}};
+    _val = (_val * static_cast<double>(_n - 1) + tr) / static_cast<double>(_n);
 }
 
-double ATR::calc_tr(const double high, const double low, const double prev_close)
+void ATR::write_batch(
+    const std::span<const double> highs,
+    const std::span<const double> lows,
+    const std::span<const double> closes,
+    double* const                 out)
 {
-    return std::max({std::abs(high - low), std::abs(high - prev_close), std::abs(low - prev_close)});
+    if (_shared_tr != nullptr)
+    {
+        throw std::logic_error{"ATR::write(): batch writes are not available once bound to a TR node"};
+    }
+    if (highs.size() != closes.size() || lows.size() != closes.size())
+    {
+        throw std::invalid_argument{"ATR::write(): high, low and close columns must have the same length"};
+    }
+
+    constexpr double  nan{std::numeric_limits<double>::quiet_NaN()};
+    const std::size_t n{closes.size()};
+    if (n == 0)
+    {
+        return;
+    }
+
+    std::size_t first{0};
+    if (_prev_close == -1.0)
+    {
+        // the very first bar only provides the previous close
+        _prev_close = closes[0];
+        if (out != nullptr)
+        {
+            out[0] = nan;
+        }
+        first = 1;
+    }
+
+    std::vector<double> tr(n - first);
+    if (!tr.empty())
+    {
+        tr[0] = TrueRange::calc(highs[first], lows[first], _prev_close);
+        const std::size_t rest{tr.size() - 1};
+        kernels::true_range(
+            highs.subspan(first + 1, rest),
+            lows.subspan(first + 1, rest),
+            closes.subspan(first, rest),
+            std::span{tr}.subspan(1));
+    }
+
+    std::size_t i{0};
+    if (!is_ready())
+    {
+        const std::size_t count{std::min(_period - _n, tr.size())};
+        if (count > 0)
+        {
+            const double total{kernels::sum(std::span{tr}.first(count))};
+            _val = (_val * static_cast<double>(_n) + total) / static_cast<double>(_n + count);
+            _n += count;
+        }
+        if (out != nullptr)
+        {
+            std::fill_n(out + first, count, nan);
+            if (count > 0 && is_ready())
+            {
+                out[first + count - 1] = _val;
+            }
+        }
+        i = count;
+    }
+
+    const auto period{static_cast<double>(_n)};
+    for (; i < tr.size(); ++i)
+    {
+        _val = (_val * (period - 1) + tr[i]) / period;
+        if (out != nullptr)
+        {
+            out[first + i] = _val;
+        }
+    }
+
+    _prev_close = closes[n - 1];
 }
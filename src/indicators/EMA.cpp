@@ -1,7 +1,10 @@
 #include "indicators/ohlcv/EMA.hpp"
 
 #include "IndicatorRegistrar.hpp"
+#include "indicators/Kernels.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 REGISTER_INDICATOR(EMA, OHLCVIndicator);
@@ -32,14 +35,14 @@ bool EMA::is_ready() const
     return _n >= _period;
 }
 
-OHLCVIndicator::Snapshot EMA::read() const
+std::span<const std::string_view> EMA::fields() const
 {
-    if (!is_ready())
-    {
-        throw std::runtime_error("Not ready");
-    }
+    return FIELDS;
+}
 
-    return {{"ema", _value}};
+void EMA::read(const std::span<double> out) const
+{
+    out[0] = value();
 }
 
 void EMA::write(const OHLCV& ohlcv)
@@ -47,6 +50,23 @@ void EMA::write(const OHLCV& ohlcv)
     write(ohlcv.close);
 }
 
+void EMA::save_state(StateWriter& writer) const
+{
+    writer.write<std::uint64_t>(_period);
+    writer.write(_value);
+    writer.write<std::uint64_t>(_n);
+}
+
+void EMA::load_state(StateReader& reader)
+{
+    if (reader.read<std::uint64_t>() != _period)
+    {
+        throw std::runtime_error{"EMA::load_state(): state was saved with a different period"};
+    }
+    _value = reader.read<double>();
+    _n     = reader.read<std::uint64_t>();
+}
+
 //
 // EMA methods
 
@@ -63,7 +83,63 @@ void EMA::write(const double close)
     }
 }
 
+void EMA::write(const std::span<const double> closes)
+{
+    for (const double close : closes.subspan(seed(closes)))
+    {
+        _value = close * _alpha + _value * (1 - _alpha);
+    }
+}
+
+void EMA::write(const std::span<const double> closes, const std::span<double> out)
+{
+    if (closes.size() != out.size())
+    {
+        throw std::invalid_argument{"EMA::write(): output column must match input length"};
+    }
+
+    const std::size_t seeded{seed(closes)};
+    std::fill_n(out.begin(), seeded, std::numeric_limits<double>::quiet_NaN());
+    if (seeded > 0 && is_ready())
+    {
+        out[seeded - 1] = _value;
+    }
+
+    for (std::size_t i = seeded; i < closes.size(); ++i)
+    {
+        _value = closes[i] * _alpha + _value * (1 - _alpha);
+        out[i] = _value;
+    }
+}
+
+double EMA::value() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("Not ready");
+    }
+
+    return _value;
+}
+
 std::size_t EMA::period() const
 {
     return _period;
 }
+
+std::size_t EMA::seed(const std::span<const double> closes)
+{
+    if (is_ready())
+    {
+        return 0;
+    }
+
+    const std::size_t count{std::min(_period - _n, closes.size())};
+    if (count > 0)
+    {
+        const double total{kernels::sum(closes.first(count))};
+        _value = (_value * static_cast<double>(_n) + total) / static_cast<double>(_n + count);
+        _n += count;
+    }
+    return count;
+}
@@ -0,0 +1,92 @@
+#include "indicators/Kernels.hpp"
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace kernels
+{
+
+double sum(const std::span<const double> values)
+{
+    constexpr std::size_t W{simd::f64::width};
+
+    const std::size_t n{values.size()};
+    const double*     in{values.data()};
+
+    simd::f64   acc0{simd::f64::broadcast(0.0)};
+    simd::f64   acc1{simd::f64::broadcast(0.0)};
+    std::size_t i{0};
+
+    // two accumulators hide the add latency
+    for (; i + 2 * W <= n; i += 2 * W)
+    {
+        acc0 = acc0 + simd::f64::load(in + i);
+        acc1 = acc1 + simd::f64::load(in + i + W);
+    }
+    for (; i + W <= n; i += W)
+    {
+        acc0 = acc0 + simd::f64::load(in + i);
+    }
+
+    double total{simd::reduce_add(acc0 + acc1)};
+    for (; i < n; ++i)
+    {
+        total += in[i];
+    }
+    return total;
+}
+
+void subtract(const std::span<const double> a, const std::span<const double> b, const std::span<double> out)
+{
+    assert(a.size() == b.size() && a.size() == out.size());
+
+    constexpr std::size_t W{simd::f64::width};
+
+    const std::size_t n{out.size()};
+    std::size_t       i{0};
+
+    for (; i + W <= n; i += W)
+    {
+        (simd::f64::load(a.data() + i) - simd::f64::load(b.data() + i)).store(out.data() + i);
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = a[i] - b[i];
+    }
+}
+
+void true_range(
+    const std::span<const double> highs,
+    const std::span<const double> lows,
+    const std::span<const double> prev_closes,
+    const std::span<double>       out)
+{
+    assert(highs.size() == lows.size() && highs.size() == prev_closes.size() && highs.size() == out.size());
+
+    constexpr std::size_t W{simd::f64::width};
+
+    const std::size_t n{out.size()};
+    std::size_t       i{0};
+
+    for (; i + W <= n; i += W)
+    {
+        const auto high{simd::f64::load(highs.data() + i)};
+        const auto low{simd::f64::load(lows.data() + i)};
+        const auto prev_close{simd::f64::load(prev_closes.data() + i)};
+
+        const auto range{simd::abs(high - low)};
+        const auto gap_up{simd::abs(high - prev_close)};
+        const auto gap_down{simd::abs(low - prev_close)};
+        simd::max(range, simd::max(gap_up, gap_down)).store(out.data() + i);
+    }
+    for (; i < n; ++i)
+    {
+        out[i] = std::max(
+            {std::abs(highs[i] - lows[i]), std::abs(highs[i] - prev_closes[i]), std::abs(lows[i] - prev_closes[i])});
+    }
+}
+
+} // namespace kernels
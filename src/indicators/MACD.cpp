@@ -1,6 +1,11 @@
 #include "indicators/ohlcv/MACD.hpp"
 
 #include "IndicatorRegistrar.hpp"
+#include "indicators/Kernels.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 REGISTER_INDICATOR(MACD, OHLCVIndicator);
 
@@ -34,36 +39,163 @@ MACD::MACD(const IndicatorConfig& config)
 
 bool MACD::is_ready() const
 {
-    return _slow_ema.is_ready() && _fast_ema.is_ready() && _signal_ema.is_ready();
+    return slow_ema().is_ready() && fast_ema().is_ready() && _signal_ema.is_ready();
 }
 
 void MACD::write(const OHLCV& ohlcv)
 {
-    bool should_calc_signal{_fast_ema.is_ready() && _slow_ema.is_ready()};
+    const bool should_calc_signal{_bars >= warm_up_bars()};
+    if (!should_calc_signal)
+    {
+        ++_bars;
+    }
 
-    _fast_ema.write(ohlcv);
-    _slow_ema.write(ohlcv);
+    // shared EMAs have already been written by the engine for this bar
+    if (_shared_fast_ema == nullptr)
+    {
+        _fast_ema.write(ohlcv);
+    }
+    if (_shared_slow_ema == nullptr)
+    {
+        _slow_ema.write(ohlcv);
+    }
 
     if (should_calc_signal)
     {
-        const double fast_ema_value = _fast_ema.read().begin()->second;
-        const double slow_ema_value = _slow_ema.read().begin()->second;
-        _signal_ema.write(fast_ema_value - slow_ema_value);
+        _signal_ema.write(fast_ema().value() - slow_ema().value());
+    }
+}
+
+void MACD::save_state(StateWriter& writer) const
+{
+    // the EMAs actually feeding the MACD are saved, so the state also loads into a MACD that owns its EMAs
+    fast_ema().save_state(writer);
+    slow_ema().save_state(writer);
+    _signal_ema.save_state(writer);
+    writer.write<std::uint64_t>(_bars);
+}
+
+void MACD::load_state(StateReader& reader)
+{
+    _fast_ema.load_state(reader);
+    _slow_ema.load_state(reader);
+    _signal_ema.load_state(reader);
+    _bars = reader.read<std::uint64_t>();
+}
+
+std::vector<IndicatorConfig> MACD::dependencies() const
+{
+    return {
+        IndicatorConfig{.name = EMA::name, .params = {{"period", static_cast<int>(_fast_ema.period())}}},
+        IndicatorConfig{.name = EMA::name, .params = {{"period", static_cast<int>(_slow_ema.period())}}}};
+}
+
+void MACD::bind_dependencies(const std::span<const OHLCVIndicator* const> nodes)
+{
+    if (nodes.size() != 2)
+    {
+        throw std::invalid_argument{"MACD::bind_dependencies(): expected fast and slow EMA nodes"};
+    }
+
+    _shared_fast_ema = dynamic_cast<const EMA*>(nodes[0]);
+    _shared_slow_ema = dynamic_cast<const EMA*>(nodes[1]);
+    if (_shared_fast_ema == nullptr || _shared_slow_ema == nullptr)
+    {
+        throw std::invalid_argument{"MACD::bind_dependencies(): dependency nodes must be EMAs"};
+    }
+}
+
+void MACD::write(const std::span<const double> closes)
+{
+    std::vector<double> macd(closes.size());
+    std::vector<double> signal(closes.size());
+    std::vector<double> histogram(closes.size());
+    write(closes, macd, signal, histogram);
+}
+
+void MACD::write(
+    const std::span<const double> closes,
+    const std::span<double>       macd_out,
+    const std::span<double>       signal_out,
+    const std::span<double>       histogram_out)
+{
+    const std::size_t n{closes.size()};
+    if (macd_out.size() != n || signal_out.size() != n || histogram_out.size() != n)
+    {
+        throw std::invalid_argument{"MACD::write(): output columns must match input length"};
     }
+
+    if (_shared_fast_ema != nullptr || _shared_slow_ema != nullptr)
+    {
+        throw std::logic_error{"MACD::write(): batch writes are not available once bound to shared EMAs"};
+    }
+
+    std::vector<double> fast(n);
+    std::vector<double> slow(n);
+    _fast_ema.write(closes, fast);
+    _slow_ema.write(closes, slow);
+    kernels::subtract(fast, slow, macd_out);
+
+    // like write(const OHLCV&), the signal EMA starts with the bar after both EMAs became ready
+    const std::size_t first_signal_input{std::min(warm_up_bars() - _bars, n)};
+    _bars += first_signal_input;
+
+    std::fill_n(signal_out.begin(), first_signal_input, std::numeric_limits<double>::quiet_NaN());
+    _signal_ema.write(macd_out.subspan(first_signal_input), signal_out.subspan(first_signal_input));
+    kernels::subtract(macd_out, signal_out, histogram_out);
+}
+
+std::span<const std::string_view> MACD::fields() const
+{
+    return FIELDS;
+}
+
+void MACD::read(const std::span<double> out) const
+{
+    const double macd_line{macd()};
+    const double signal_line{_signal_ema.value()};
+
+    out[0] = macd_line;
+    out[1] = signal_line;
+    out[2] = macd_line - signal_line;
+}
+
+double MACD::macd() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("MACD is not ready");
+    }
+
+    return fast_ema().value() - slow_ema().value();
 }
 
-OHLCVIndicator::Snapshot MACD::read() const
+double MACD::signal() const
 {
     if (!is_ready())
     {
         throw std::runtime_error("MACD is not ready");
     }
-    const double fast_ema_value = _fast_ema.read().begin()->second;
-    const double slow_ema_value = _slow_ema.read().begin()->second;
-    const double signal_line    = _signal_ema.read().begin()->second;
 
-    const double macd_line = fast_ema_value - slow_ema_value;
-    const double histogram = macd_line - signal_line;
+    return _signal_ema.value();
+}
+
+double MACD::histogram() const
+{
+    return macd() - signal();
+}
+
+const EMA& MACD::fast_ema() const
+{
+    return _shared_fast_ema != nullptr ? *_shared_fast_ema : _fast_ema;
+}
+
+const EMA& MACD::slow_ema() const
+{
+    return _shared_slow_ema != nullptr ? *_shared_slow_ema : _slow_ema;
+}
 
-    return {{"macd", macd_line}, {"signal", signal_line}, {"histogram", histogram}};
+std::size_t MACD::warm_up_bars() const
+{
+    return std::max(_fast_ema.period(), _slow_ema.period());
 }
@@ -0,0 +1,273 @@
+#include "indicators/SymbolLanes.hpp"
+
+#include "Simd.hpp"
+#include "indicators/Kernels.hpp"
+#include "indicators/ohlcv/ATR.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace lanes
+{
+
+namespace
+{
+
+using simd::f64;
+
+constexpr std::size_t W{f64::width};
+
+static_assert(LANE_PADDING % W == 0, "lane padding must be a whole number of vectors");
+
+void check_lane(const Column& column, const std::size_t lane)
+{
+    if (lane >= column.size())
+    {
+        throw std::out_of_range{"lane index out of range"};
+    }
+}
+
+} // namespace
+
+//
+// EMALanes
+
+EMALanes::EMALanes(const std::size_t period)
+    : _alpha{static_cast<double>(EMA::SMOOTHING_FACTOR) / (1 + static_cast<double>(period))},
+      _period{period}
+{
+}
+
+void EMALanes::resize(const std::size_t lane_count)
+{
+    if (padded(lane_count) > _value.size())
+    {
+        _value.resize(padded(lane_count), 0.0);
+        _n.resize(padded(lane_count), 0.0);
+    }
+}
+
+void EMALanes::update(const std::span<const double> values, const std::span<const double> present)
+{
+    assert(values.size() >= _value.size() && present.size() >= _value.size());
+
+    const f64 zero{f64::broadcast(0.0)};
+    const f64 one{f64::broadcast(1.0)};
+    const f64 period{f64::broadcast(static_cast<double>(_period))};
+    const f64 alpha{f64::broadcast(_alpha)};
+    const f64 keep{f64::broadcast(1 - _alpha)};
+
+    for (std::size_t i = 0; i < _value.size(); i += W)
+    {
+        const f64 value{f64::load(_value.data() + i)};
+        const f64 n{f64::load(_n.data() + i)};
+        const f64 x{f64::load(values.data() + i)};
+
+        // same arithmetic as EMA::write(double): running mean until ready, then the alpha recurrence
+        const f64 n_next{simd::min(n + one, period)};
+        const f64 warm{(value * (n_next - one) + x) / n_next};
+        const f64 ready{x * alpha + value * keep};
+
+        const simd::mask active{zero < f64::load(present.data() + i)};
+        simd::select(active, simd::select(n < period, warm, ready), value).store(_value.data() + i);
+        simd::select(active, n_next, n).store(_n.data() + i);
+    }
+}
+
+std::size_t EMALanes::lane_count() const
+{
+    return _value.size();
+}
+
+bool EMALanes::is_ready(const std::size_t lane) const
+{
+    check_lane(_n, lane);
+    return _n[lane] >= static_cast<double>(_period);
+}
+
+std::span<const std::string_view> EMALanes::fields()
+{
+    return EMA::FIELDS;
+}
+
+void EMALanes::read(const std::size_t lane, const std::span<double> out) const
+{
+    if (!is_ready(lane))
+    {
+        throw std::runtime_error("Not ready");
+    }
+    out[0] = _value[lane];
+}
+
+std::span<const double> EMALanes::values() const
+{
+    return _value;
+}
+
+std::span<const double> EMALanes::counts() const
+{
+    return _n;
+}
+
+std::size_t EMALanes::period() const
+{
+    return _period;
+}
+
+//
+// ATRLanes
+
+ATRLanes::ATRLanes(const std::size_t period) : _period{period}
+{
+}
+
+void ATRLanes::resize(const std::size_t lane_count)
+{
+    if (padded(lane_count) > _value.size())
+    {
+        _value.resize(padded(lane_count), 0.0);
+        _n.resize(padded(lane_count), 0.0);
+        _prev_close.resize(padded(lane_count), 0.0);
+        _has_prev_close.resize(padded(lane_count), 0.0);
+    }
+}
+
+void ATRLanes::update(const LaneInputs& inputs)
+{
+    assert(inputs.high.size() >= _value.size() && inputs.low.size() >= _value.size());
+    assert(inputs.close.size() >= _value.size() && inputs.present.size() >= _value.size());
+
+    const f64 zero{f64::broadcast(0.0)};
+    const f64 one{f64::broadcast(1.0)};
+    const f64 period{f64::broadcast(static_cast<double>(_period))};
+
+    for (std::size_t i = 0; i < _value.size(); i += W)
+    {
+        const f64 value{f64::load(_value.data() + i)};
+        const f64 n{f64::load(_n.data() + i)};
+        const f64 prev_close{f64::load(_prev_close.data() + i)};
+        const f64 high{f64::load(inputs.high.data() + i)};
+        const f64 low{f64::load(inputs.low.data() + i)};
+        const f64 close{f64::load(inputs.close.data() + i)};
+
+        const f64 tr{simd::max(
+            simd::abs(high - low), simd::max(simd::abs(high - prev_close), simd::abs(low - prev_close)))};
+
+        // same arithmetic as ATR::write(): the first bar of a lane only provides the previous close
+        const f64 n_next{simd::min(n + one, period)};
+        const f64 next{(value * (n_next - one) + tr) / n_next};
+
+        const simd::mask active{zero < f64::load(inputs.present.data() + i)};
+        const simd::mask accumulate{active & (zero < f64::load(_has_prev_close.data() + i))};
+        simd::select(accumulate, next, value).store(_value.data() + i);
+        simd::select(accumulate, n_next, n).store(_n.data() + i);
+        simd::select(active, close, prev_close).store(_prev_close.data() + i);
+        simd::select(active, one, f64::load(_has_prev_close.data() + i)).store(_has_prev_close.data() + i);
+    }
+}
+
+std::size_t ATRLanes::lane_count() const
+{
+    return _value.size();
+}
+
+bool ATRLanes::is_ready(const std::size_t lane) const
+{
+    check_lane(_n, lane);
+    return _n[lane] >= static_cast<double>(_period);
+}
+
+std::span<const std::string_view> ATRLanes::fields()
+{
+    return ATR::FIELDS;
+}
+
+void ATRLanes::read(const std::size_t lane, const std::span<double> out) const
+{
+    if (!is_ready(lane))
+    {
+        throw std::runtime_error("ATR is not ready");
+    }
+    out[0] = _value[lane];
+}
+
+//
+// MACDLanes
+
+MACDLanes::MACDLanes(const std::size_t fast_period, const std::size_t slow_period, const std::size_t signal_period)
+    : _fast_ema{fast_period},
+      _slow_ema{slow_period},
+      _signal_ema{signal_period}
+{
+}
+
+void MACDLanes::resize(const std::size_t lane_count)
+{
+    _fast_ema.resize(lane_count);
+    _slow_ema.resize(lane_count);
+    _signal_ema.resize(lane_count);
+    if (padded(lane_count) > _line.size())
+    {
+        _line.resize(padded(lane_count), 0.0);
+        _signal_present.resize(padded(lane_count), 0.0);
+    }
+}
+
+void MACDLanes::update(const LaneInputs& inputs)
+{
+    assert(inputs.close.size() >= _line.size() && inputs.present.size() >= _line.size());
+
+    const f64 zero{f64::broadcast(0.0)};
+    const f64 one{f64::broadcast(1.0)};
+    const f64 fast_period{f64::broadcast(static_cast<double>(_fast_ema.period()))};
+    const f64 slow_period{f64::broadcast(static_cast<double>(_slow_ema.period()))};
+
+    // like MACD::write(), the signal EMA only sees lanes whose fast and slow EMAs were ready before this bar
+    const double* fast_n{_fast_ema.counts().data()};
+    const double* slow_n{_slow_ema.counts().data()};
+    for (std::size_t i = 0; i < _line.size(); i += W)
+    {
+        const simd::mask gate{
+            (zero < f64::load(inputs.present.data() + i)) & (fast_period <= f64::load(fast_n + i)) &
+            (slow_period <= f64::load(slow_n + i))};
+        simd::select(gate, one, zero).store(_signal_present.data() + i);
+    }
+
+    _fast_ema.update(inputs.close, inputs.present);
+    _slow_ema.update(inputs.close, inputs.present);
+    kernels::subtract(_fast_ema.values(), _slow_ema.values(), _line);
+    _signal_ema.update(_line, _signal_present);
+}
+
+std::size_t MACDLanes::lane_count() const
+{
+    return _line.size();
+}
+
+bool MACDLanes::is_ready(const std::size_t lane) const
+{
+    return _fast_ema.is_ready(lane) && _slow_ema.is_ready(lane) && _signal_ema.is_ready(lane);
+}
+
+std::span<const std::string_view> MACDLanes::fields()
+{
+    return MACD::FIELDS;
+}
+
+void MACDLanes::read(const std::size_t lane, const std::span<double> out) const
+{
+    if (!is_ready(lane))
+    {
+        throw std::runtime_error("MACD is not ready");
+    }
+
+    const double macd_line{_line[lane]};
+    const double signal_line{_signal_ema.values()[lane]};
+    out[0] = macd_line;
+    out[1] = signal_line;
+    out[2] = macd_line - signal_line;
+}
+
+} // namespace lanes
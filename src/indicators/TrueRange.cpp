@@ -0,0 +1,77 @@
+#include "indicators/ohlcv/TrueRange.hpp"
+
+#include "IndicatorRegistrar.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+REGISTER_INDICATOR(TrueRange, OHLCVIndicator)
+
+TrueRange::TrueRange(const IndicatorConfig& /*config*/)
+{
+}
+
+//
+// Indicator methods
+
+bool TrueRange::is_ready() const
+{
+    return _ready;
+}
+
+std::span<const std::string_view> TrueRange::fields() const
+{
+    return FIELDS;
+}
+
+void TrueRange::read(const std::span<double> out) const
+{
+    out[0] = value();
+}
+
+void TrueRange::write(const OHLCV& ohlcv)
+{
+    if (_has_prev_close)
+    {
+        _value = calc(ohlcv.high, ohlcv.low, _prev_close);
+        _ready = true;
+    }
+
+    _prev_close     = ohlcv.close;
+    _has_prev_close = true;
+}
+
+void TrueRange::save_state(StateWriter& writer) const
+{
+    writer.write(_value);
+    writer.write(_prev_close);
+    writer.write(_has_prev_close);
+    writer.write(_ready);
+}
+
+void TrueRange::load_state(StateReader& reader)
+{
+    _value          = reader.read<double>();
+    _prev_close     = reader.read<double>();
+    _has_prev_close = reader.read<bool>();
+    _ready          = reader.read<bool>();
+}
+
+//
+// TrueRange methods
+
+double TrueRange::calc(const double high, const double low, const double prev_close)
+{
+    return std::max({std::abs(high - low), std::abs(high - prev_close), std::abs(low - prev_close)});
+}
+
+double TrueRange::value() const
+{
+    if (!is_ready())
+    {
+        throw std::runtime_error("TrueRange::value(): no previous close yet");
+    }
+
+    return _value;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Bar.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Sessions of 390 one-minute bars a day apart, so each has an overnight gap before it. With the default drift this is
+ * an uptrend with regular pullbacks, so MACD crosses above its signal below zero while the close stays above the EMA;
+ * a drift of 0 oscillates around the start price instead. Deterministic per seed.
+ */
+inline std::vector<Bar1min> makeSyntheticSessions(
+    const std::string&                                symbol,
+    const int                                         sessions,
+    const std::chrono::sys_time<std::chrono::minutes> start,
+    const std::uint32_t                               seed,
+    const double                                      drift = 0.005)
+{
+    std::mt19937                     rng{seed};
+    std::normal_distribution<double> noise{0.0, 0.04};
+
+    std::vector<Bar1min> bars{};
+    bars.reserve(static_cast<std::size_t>(sessions) * 390);
+    double price{50.0};
+    for (int day = 0; day < sessions; ++day)
+    {
+        for (int i = 0; i < 390; ++i)
+        {
+            const double open{price};
+            price = std::max(1.0, price + drift + 0.05 * std::sin((day * 390 + i) / 30.0) + noise(rng));
+            bars.emplace_back(
+                symbol,
+                open,
+                std::max(open, price) + 0.02,
+                std::min(open, price) - 0.02,
+                price,
+                500,
+                start + std::chrono::days{day} + std::chrono::minutes{i});
+        }
+    }
+    return bars;
+}
@@ -0,0 +1,118 @@
+#include "AlpacaMessageParser.hpp"
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+TEST(AlpacaMessageParserTest, ParsesBars)
+{
+    std::vector<Bar1min>      bars{};
+    const AlpacaMessageParser parser{{.on_bar = [&bars](const Bar1min& bar) { bars.push_back(bar); }}};
+
+    const std::string frame{
+        R"([{"T":"b","S":"SPY","o":388.985,"h":389.13,"l":388.975,"c":389.12,"v":49378,)"
+        R"("t":"2021-02-22T19:15:00Z","n":461,"vw":389.062639},)"
+        R"( {"v":12,"T":"b","S":"AAPL","o":1.5,"h":2,"l":1,"c":1.75,"t":"2021-02-22T19:16:00Z"}])"};
+
+    EXPECT_EQ(parser.parse(frame), 2u);
+    ASSERT_EQ(bars.size(), 2u);
+
+    EXPECT_EQ(bars[0].symbol(), SymbolTable::intern("SPY"));
+    EXPECT_DOUBLE_EQ(bars[0].open(), 388.985);
+    EXPECT_DOUBLE_EQ(bars[0].high(), 389.13);
+    EXPECT_DOUBLE_EQ(bars[0].low(), 388.975);
+    EXPECT_DOUBLE_EQ(bars[0].close(), 389.12);
+    EXPECT_EQ(bars[0].volume(), 49378u);
+    EXPECT_EQ(bars[0].timestamp(), sys_days{2021y / February / 22} + hours{19} + minutes{15});
+
+    // field order does not matter
+    EXPECT_EQ(bars[1].symbol_name(), "AAPL");
+    EXPECT_EQ(bars[1].volume(), 12u);
+    EXPECT_DOUBLE_EQ(bars[1].high(), 2.0);
+}
+
+TEST(AlpacaMessageParserTest, DispatchesTradesQuotesAndControlMessages)
+{
+    std::vector<AlpacaTrade>          trades{};
+    std::vector<AlpacaQuote>          quotes{};
+    std::vector<AlpacaControlMessage> control{};
+    std::vector<std::string>          texts{};
+
+    const AlpacaMessageParser parser{
+        {.on_trade = [&trades](const AlpacaTrade& trade) { trades.push_back(trade); },
+         .on_quote = [&quotes](const AlpacaQuote& quote) { quotes.push_back(quote); },
+         .on_control =
+             [&](const AlpacaControlMessage& message)
+         {
+             control.push_back(message);
+             texts.emplace_back(message.msg);
+         }}};
+
+    const std::string frame{
+        R"([{"T":"success","msg":"authenticated"},)"
+        R"({"T":"t","i":96921,"S":"AAPL","x":"D","p":126.55,"s":1,"t":"2021-02-22T15:51:44.208Z",)"
+        R"("c":["@","I"],"z":"C"},)"
+        R"({"T":"q","S":"AMD","bx":"U","bp":87.66,"bs":1,"ax":"Q","ap":87.68,"as":4,"t":"2021-02-22T15:51:45.335Z"},)"
+        R"({"T":"subscription","trades":["AAPL"],"quotes":["AMD"],"bars":[]},)"
+        R"({"T":"error","code":402,"msg":"auth failed"}])"};
+
+    EXPECT_EQ(parser.parse(frame), 5u);
+
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].symbol, SymbolTable::intern("AAPL"));
+    EXPECT_DOUBLE_EQ(trades[0].price, 126.55);
+    EXPECT_EQ(trades[0].size, 1u);
+    EXPECT_EQ(
+        trades[0].timestamp,
+        sys_days{2021y / February / 22} + hours{15} + minutes{51} + seconds{44} + milliseconds{208});
+
+    ASSERT_EQ(quotes.size(), 1u);
+    EXPECT_EQ(quotes[0].symbol, SymbolTable::intern("AMD"));
+    EXPECT_DOUBLE_EQ(quotes[0].bid_price, 87.66);
+    EXPECT_EQ(quotes[0].bid_size, 1u);
+    EXPECT_DOUBLE_EQ(quotes[0].ask_price, 87.68);
+    EXPECT_EQ(quotes[0].ask_size, 4u);
+
+    ASSERT_EQ(control.size(), 3u);
+    EXPECT_EQ(control[0].type, AlpacaControlMessage::Type::Success);
+    EXPECT_EQ(texts[0], "authenticated");
+    EXPECT_EQ(control[1].type, AlpacaControlMessage::Type::Subscription);
+    EXPECT_EQ(control[2].type, AlpacaControlMessage::Type::Error);
+    EXPECT_EQ(control[2].code, 402);
+    EXPECT_EQ(texts[2], "auth failed");
+}
+
+TEST(AlpacaMessageParserTest, SkipsUnhandledAndIncompleteMessages)
+{
+    int                       bars{0};
+    const AlpacaMessageParser parser{{.on_bar = [&bars](const Bar1min&) { ++bars; }}};
+
+    // no trade handler; second bar has no close; third has a non-UTC timestamp
+    const std::string frame{
+        R"([{"T":"t","S":"AAPL","p":1,"s":1,"t":"2021-02-22T15:51:44Z"},)"
+        R"({"T":"b","S":"X","o":1,"h":1,"l":1,"v":1,"t":"2021-02-22T19:15:00Z"},)"
+        R"({"T":"b","S":"X","o":1,"h":1,"l":1,"c":1,"v":1,"t":"2021-02-22T19:15:00-05:00"},)"
+        R"({"T":"b","S":"X","o":1,"h":1,"l":1,"c":1,"v":1,"t":"2021-02-22T19:15:00Z"}])"};
+
+    EXPECT_EQ(parser.parse(frame), 1u);
+    EXPECT_EQ(bars, 1);
+    EXPECT_EQ(parser.parse("[]"), 0u);
+    EXPECT_EQ(parser.parse(" [ {} ] "), 0u);
+}
+
+TEST(AlpacaMessageParserTest, RejectsMalformedFrames)
+{
+    const AlpacaMessageParser parser{{}};
+
+    EXPECT_THROW(parser.parse(""), std::runtime_error);
+    EXPECT_THROW(parser.parse(R"({"T":"b"})"), std::runtime_error);
+    EXPECT_THROW(parser.parse(R"([{"T":"b"})"), std::runtime_error);
+    EXPECT_THROW(parser.parse(R"([{"T":"b}])"), std::runtime_error);
+    EXPECT_THROW(parser.parse(R"([{"T":"b","c":[1,2}])"), std::runtime_error);
+    EXPECT_THROW(parser.parse(R"([{"T":"b"}] x)"), std::runtime_error);
+}
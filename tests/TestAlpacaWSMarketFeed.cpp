@@ -1,6 +1,7 @@
 #include "AlpacaWSMarketFeed.hpp"
 #include "Bar.hpp"
 #include "HistoricalDataTestUtils.hpp"
+#include "LoopbackWebSocketServer.hpp"
 
 #include <atomic>
 #include <boost/asio.hpp>
@@ -8,9 +9,32 @@
 #include <cstdlib>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 #include <unistd.h>
 
+namespace
+{
+
+// what Alpaca's stream sends and expects after the WebSocket handshake: greeting, auth, subscription
+asio::awaitable<void> alpaca_session_setup(LoopbackWebSocketServer::Stream& ws, std::vector<std::string>& received)
+{
+    co_await LoopbackWebSocketServer::write(ws, R"([{"T":"success","msg":"connected"}])");
+    received.push_back(co_await LoopbackWebSocketServer::read(ws));
+    co_await LoopbackWebSocketServer::write(ws, R"([{"T":"success","msg":"authenticated"}])");
+    received.push_back(co_await LoopbackWebSocketServer::read(ws));
+}
+
+std::string loopback_bar(const std::string_view symbol, const std::string_view timestamp)
+{
+    return R"({"T":"b","S":")" + std::string{symbol} + R"(","o":10.0,"h":11.0,"l":9.5,"c":10.5,"v":100,"t":")"
+         + std::string{timestamp} + R"(","n":5,"vw":10.2})";
+}
+
+} // namespace
+
 class AlpacaWSMarketFeedTest : public ::testing::Test
 {
 protected:
@@ -71,7 +95,7 @@ TEST_F(AlpacaWSMarketFeedTest, ConnectsToFAKEPACAStream)
 
     EXPECT_TRUE(received_bar.load()) << "Should have received at least one bar from FAKEPACA stream";
     EXPECT_GT(bar_count.load(), 0) << "Bar count should be greater than 0";
-    EXPECT_EQ(latest_bar.symbol(), "FAKEPACA") << "Symbol should be FAKEPACA";
+    EXPECT_EQ(latest_bar.symbol_name(), "FAKEPACA") << "Symbol should be FAKEPACA";
     EXPECT_GT(latest_bar.open(), 0) << "Open price should be greater than 0";
     EXPECT_GT(latest_bar.high(), 0) << "High price should be greater than 0";
     EXPECT_GT(latest_bar.low(), 0) << "Low price should be greater than 0";
@@ -141,3 +165,95 @@ TEST_F(AlpacaWSMarketFeedTest, HistoricalDataFeedTest)
             << "Bar string " << i << " should contain symbol PLTR";
     }
 }
+
+TEST(AlpacaWSMarketFeedLoopbackTest, ReauthenticatesAndResubscribesAfterDrop)
+{
+    std::vector<std::vector<std::string>> received(2);
+    LoopbackWebSocketServer               server{
+        2,
+        [&received](const std::size_t connection, LoopbackWebSocketServer::Stream& ws) -> asio::awaitable<void>
+        {
+            co_await alpaca_session_setup(ws, received[connection]);
+            if (connection == 0)
+            {
+                co_return;
+            }
+
+            co_await LoopbackWebSocketServer::write(ws, "[" + loopback_bar("LOOP", "2025-05-19T13:30:00Z") + "]");
+            for (;;)
+            {
+                (void)co_await LoopbackWebSocketServer::read(ws);
+            }
+        }};
+
+    asio::io_context                 ioc;
+    const AlpacaWSMarketFeed::config config{
+        .api_key = "key", .api_secret = "secret", .host = "127.0.0.1", .port = server.port()};
+    AlpacaWSMarketFeed       feed{ioc, config};
+    std::vector<std::string> bars{};
+    auto                     connection = feed.connect_bar_handler(
+        [&](const Bar1min& bar)
+        {
+            bars.emplace_back(bar.symbol_name());
+            feed.stop();
+        });
+
+    feed.subscribe_to_bars({"LOOP"});
+    feed.start();
+    ioc.run_for(std::chrono::seconds(10));
+
+    ASSERT_TRUE(server.wait_for(std::chrono::seconds(5)));
+    for (const auto& messages : received)
+    {
+        ASSERT_EQ(messages.size(), 2u);
+        EXPECT_NE(messages[0].find(R"("action":"auth")"), std::string::npos) << messages[0];
+        EXPECT_NE(messages[1].find(R"("action":"subscribe")"), std::string::npos) << messages[1];
+        EXPECT_NE(messages[1].find("LOOP"), std::string::npos) << messages[1];
+    }
+    EXPECT_EQ(bars, std::vector<std::string>{"LOOP"});
+}
+
+TEST(AlpacaWSMarketFeedLoopbackTest, ThrowingBarHandlerDoesNotDropRestOfFrame)
+{
+    std::vector<std::string> setup{};
+    LoopbackWebSocketServer  server{
+        1,
+        [&setup](std::size_t, LoopbackWebSocketServer::Stream& ws) -> asio::awaitable<void>
+        {
+            co_await alpaca_session_setup(ws, setup);
+            co_await LoopbackWebSocketServer::write(
+                ws,
+                "[" + loopback_bar("AAA", "2025-05-19T13:30:00Z") + "," + loopback_bar("BBB", "2025-05-19T13:30:00Z")
+                    + "," + loopback_bar("CCC", "2025-05-19T13:30:00Z") + "]");
+            for (;;)
+            {
+                (void)co_await LoopbackWebSocketServer::read(ws);
+            }
+        }};
+
+    asio::io_context                 ioc;
+    const AlpacaWSMarketFeed::config config{
+        .api_key = "key", .api_secret = "secret", .host = "127.0.0.1", .port = server.port()};
+    AlpacaWSMarketFeed       feed{ioc, config};
+    std::vector<std::string> bars{};
+    auto                     connection = feed.connect_bar_handler(
+        [&](const Bar1min& bar)
+        {
+            bars.emplace_back(bar.symbol_name());
+            if (bars.size() == 1)
+            {
+                throw std::runtime_error("Bar timestamp does not match expected sequence");
+            }
+            if (bars.size() == 3)
+            {
+                feed.stop();
+            }
+        });
+
+    feed.subscribe_to_bars({"AAA", "BBB", "CCC"});
+    feed.start();
+    ioc.run_for(std::chrono::seconds(10));
+
+    ASSERT_TRUE(server.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(bars, (std::vector<std::string>{"AAA", "BBB", "CCC"}));
+}
@@ -0,0 +1,177 @@
+#include "Backtester.hpp"
+#include "Bar.hpp"
+#include "IndicatorSnapshot.hpp"
+#include "MACDStrategy.hpp"
+#include "SimulatedBroker.hpp"
+#include "SyntheticSessions.hpp"
+
+#include <array>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+const sys_time<minutes> START{sys_days{2024y / March / 4} + 14h + 30min};
+
+Bar1min makeBar(const int minute, const double open, const double high, const double low, const double close)
+{
+    return Bar1min{"BTST", open, high, low, close, 1000, START + minutes{minute}};
+}
+
+IndicatorSnapshot makeSnapshot()
+{
+    constexpr std::array<std::string_view, 1> ema{"ema"};
+    constexpr std::array<std::string_view, 3> macd{"macd", "signal", "histogram"};
+    constexpr std::array<std::string_view, 1> atr{"atr"};
+
+    auto layout{std::make_shared<IndicatorSnapshot::Layout>()};
+    layout->add("EMA", ema);
+    layout->add("MACD", macd);
+    layout->add("ATR", atr);
+    return IndicatorSnapshot{std::move(layout)};
+}
+
+void setValues(IndicatorSnapshot& snapshot, const double ema, const double macd, const double signal, const double atr)
+{
+    const auto values{snapshot.values()};
+    values[0] = ema;
+    values[1] = macd;
+    values[2] = signal;
+    values[3] = macd - signal;
+    values[4] = atr;
+}
+
+std::vector<Bar1min> makeSessions(const int sessions)
+{
+    return makeSyntheticSessions("BTST", sessions, START, 17);
+}
+
+} // namespace
+
+TEST(SimulatedBrokerTest, FillsMarketOrdersAtNextOpen)
+{
+    SimulatedBroker broker{1000.0, FillModel{.slippage_bps = 10.0, .commission_per_share = 0.01}};
+    broker.on_bar(makeBar(0, 10.0, 10.5, 9.5, 10.0));
+    broker.submit_buy(2.0);
+    EXPECT_TRUE(broker.has_pending_order());
+    EXPECT_FALSE(broker.is_long());
+
+    broker.on_bar(makeBar(1, 10.0, 11.0, 9.5, 11.0));
+    ASSERT_TRUE(broker.is_long());
+    EXPECT_DOUBLE_EQ(broker.cash(), 0.0);
+    const double quantity{1000.0 / (10.0 * 1.001 + 0.01)};
+    EXPECT_NEAR(broker.equity(), quantity * 11.0, 1e-9);
+
+    broker.submit_buy(2.0); // ignored while long
+    broker.submit_sell();
+    broker.on_bar(makeBar(2, 12.0, 12.0, 11.0, 11.5));
+    ASSERT_FALSE(broker.is_long());
+    ASSERT_EQ(broker.trades().size(), 1u);
+
+    const auto& trade{broker.trades().front()};
+    EXPECT_EQ(trade.entry_time, START + 1min);
+    EXPECT_EQ(trade.exit_time, START + 2min);
+    EXPECT_DOUBLE_EQ(trade.entry_price, 10.01);
+    EXPECT_DOUBLE_EQ(trade.exit_price, 12.0 * 0.999);
+    EXPECT_NEAR(trade.pnl, quantity * (12.0 * 0.999 - 0.01) - 1000.0, 1e-9);
+    EXPECT_FALSE(trade.stopped_out);
+    EXPECT_NEAR(broker.cash(), 1000.0 + trade.pnl, 1e-9);
+}
+
+TEST(SimulatedBrokerTest, StopsOutAndTracksDrawdown)
+{
+    SimulatedBroker broker{100.0};
+    broker.submit_buy(1.0);
+    broker.on_bar(makeBar(0, 10.0, 10.2, 9.8, 10.0));
+    ASSERT_TRUE(broker.is_long());
+
+    // gaps below the stop at 9.0: fills at the open
+    broker.on_bar(makeBar(1, 8.0, 8.5, 7.5, 8.2));
+    ASSERT_FALSE(broker.is_long());
+    ASSERT_EQ(broker.trades().size(), 1u);
+    EXPECT_TRUE(broker.trades().front().stopped_out);
+    EXPECT_DOUBLE_EQ(broker.cash(), 80.0);
+    EXPECT_DOUBLE_EQ(broker.max_drawdown(), 0.2);
+
+    broker.submit_buy(0.5);
+    broker.on_bar(makeBar(2, 8.0, 8.1, 7.4, 7.8));
+    ASSERT_EQ(broker.trades().size(), 2u);
+    EXPECT_DOUBLE_EQ(broker.trades().back().exit_price, 7.5);
+    EXPECT_DOUBLE_EQ(broker.cash(), 75.0);
+    EXPECT_DOUBLE_EQ(broker.max_drawdown(), 0.25);
+
+    EXPECT_THROW(SimulatedBroker{0.0}, std::invalid_argument);
+}
+
+TEST(MACDStrategyTest, EntersOnCrossAboveAndExitsOnCrossBelow)
+{
+    IndicatorSnapshot snapshot{makeSnapshot()};
+    MACDStrategy      strategy{snapshot};
+
+    setValues(snapshot, 100.0, -0.5, -0.3, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 101.0, false).action, MACDStrategy::Action::None);
+
+    setValues(snapshot, 100.0, -0.2, -0.3, 0.5);
+    const auto buy{strategy.on_snapshot(snapshot, 101.0, false)};
+    EXPECT_EQ(buy.action, MACDStrategy::Action::Buy);
+    EXPECT_DOUBLE_EQ(buy.stop_distance, 0.75);
+
+    setValues(snapshot, 100.0, -0.1, -0.2, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 101.0, true).action, MACDStrategy::Action::None);
+
+    setValues(snapshot, 100.0, -0.3, -0.2, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 101.0, true).action, MACDStrategy::Action::Sell);
+
+    // a cross above with the close below the EMA, or with too much volatility, does not enter
+    setValues(snapshot, 100.0, -0.1, -0.2, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 99.0, false).action, MACDStrategy::Action::None);
+    setValues(snapshot, 100.0, -0.3, -0.2, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 101.0, false).action, MACDStrategy::Action::None);
+    setValues(snapshot, 100.0, -0.1, -0.2, 5.0);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 101.0, false).action, MACDStrategy::Action::None);
+
+    // closing below the EMA exits without a cross
+    setValues(snapshot, 100.0, -0.1, -0.2, 0.5);
+    EXPECT_EQ(strategy.on_snapshot(snapshot, 99.0, true).action, MACDStrategy::Action::Sell);
+}
+
+TEST(BacktesterTest, ReplaysSessionsThroughPipeline)
+{
+    const auto bars{makeSessions(20)};
+
+    Backtester<5, minutes> backtester{BacktestConfig{
+        .starting_cash = 1000.0,
+        .fill_model    = {.slippage_bps = 1.0},
+        .strategy      = {.ema_period = 50, .atr_threshold = 0.05}}};
+    backtester.run(std::span{bars}.first(bars.size() / 2));
+    const auto report{backtester.run(std::span{bars}.subspan(bars.size() / 2))};
+
+    EXPECT_EQ(report.bars, bars.size());
+    EXPECT_EQ(report.aggregated_bars, bars.size() / 5);
+    EXPECT_GT(report.trades, 0u);
+    EXPECT_LE(report.winning_trades, report.trades);
+    EXPECT_GE(report.max_drawdown, 0.0);
+    EXPECT_LT(report.max_drawdown, 1.0);
+    EXPECT_GT(report.bars_per_second(), 0.0);
+
+    const auto&  trades{backtester.broker().trades()};
+    const double realized{
+        std::accumulate(trades.begin(), trades.end(), 0.0, [](double sum, const auto& t) { return sum + t.pnl; })};
+    if (!backtester.broker().is_long())
+    {
+        EXPECT_NEAR(report.final_equity, 1000.0 + realized, 1e-6);
+    }
+    for (std::size_t i = 1; i < trades.size(); ++i)
+    {
+        EXPECT_LT(trades[i - 1].exit_time, trades[i].entry_time);
+    }
+
+    EXPECT_THROW(backtester.run(std::span{bars}.first(1)), std::runtime_error);
+}
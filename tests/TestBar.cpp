@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <gtest/gtest.h>
+#include <type_traits>
 
 #define START_TIME 1000
 
@@ -114,3 +115,24 @@ TEST_F(BarTest, EdgeCasePreciseConsecutive)
     EXPECT_TRUE(isConsecutive(bar1, bar2));
     EXPECT_TRUE(isConsecutive(bar2, bar1));
 }
+
+TEST_F(BarTest, SymbolsAreInternedOnce)
+{
+    Bar1min bar1{"AAPL", 100.0, 105.0, 99.0, 103.0, 1000, base_time};
+    Bar1min bar2{"AAPL", 103.0, 106.0, 102.0, 104.0, 1200, base_time + minutes{1}};
+    Bar1min bar3{"MSFT", 103.0, 106.0, 102.0, 104.0, 1200, base_time + minutes{1}};
+
+    EXPECT_EQ(bar1.symbol(), bar2.symbol());
+    EXPECT_NE(bar1.symbol(), bar3.symbol());
+    EXPECT_EQ(bar1.symbol(), SymbolTable::intern("AAPL"));
+    EXPECT_EQ(bar1.symbol_name(), "AAPL");
+    EXPECT_EQ(bar3.symbol_name(), "MSFT");
+    EXPECT_EQ(SymbolTable::find("MSFT"), bar3.symbol());
+    EXPECT_FALSE(SymbolTable::find("NOT_A_SYMBOL").has_value());
+}
+
+TEST_F(BarTest, BarsAreTriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable_v<Bar1min>);
+    EXPECT_TRUE(std::is_trivially_copyable_v<Bar5min>);
+}
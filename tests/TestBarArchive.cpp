@@ -0,0 +1,145 @@
+#include "Bar.hpp"
+#include "BarArchive.hpp"
+#include "BarColumns.hpp"
+#include "WarmupBackfill.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+const sys_time<minutes> START{sys_days{2024y / January / 2} + 14h + 30min};
+
+class BarArchiveTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = std::filesystem::temp_directory_path()
+              / (std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()} + ".bars");
+    }
+
+    void TearDown() override { std::filesystem::remove(_path); }
+
+    // interleaved symbols with an overnight gap, as a multi-symbol CSV export would contain them
+    static BarColumns makeBars()
+    {
+        BarColumns bars{};
+        for (int i = 0; i < 500; ++i)
+        {
+            const auto ts{START + minutes{i < 250 ? i : i + 1000}};
+            bars.push_back(Bar1min{"ARCH_A", 10.0 + i, 11.0 + i, 9.0 + i, 10.5 + i, 100u + i, ts});
+            if (i % 2 == 0)
+            {
+                bars.push_back(Bar1min{"ARCH_B", 0.25 * i, 0.5 * i, 0.125 * i, 0.375 * i, 7u * i, ts});
+            }
+        }
+        return bars;
+    }
+
+    std::filesystem::path _path{};
+};
+
+} // namespace
+
+TEST_F(BarArchiveTest, RoundTripsBySymbol)
+{
+    const BarColumns bars{makeBars()};
+    writeBarArchive(_path.string(), bars);
+
+    const BarArchive archive{_path.string()};
+    ASSERT_EQ(archive.blocks().size(), 2u);
+    EXPECT_EQ(archive.bar_count(), bars.size());
+
+    const auto* a{archive.find("ARCH_A")};
+    const auto* b{archive.find("ARCH_B")};
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(archive.find("ARCH_C"), nullptr);
+    EXPECT_EQ(a->size(), 500u);
+    EXPECT_EQ(b->size(), 250u);
+
+    // the value columns are zero-copy spans of the file
+    EXPECT_DOUBLE_EQ(a->close[260], 270.5);
+    EXPECT_EQ(a->volume[260], 360u);
+    EXPECT_EQ(a->timestamp(260), START + minutes{1260});
+
+    std::vector<Bar1min> decoded{};
+    BarArchive::decode(*b, decoded);
+    ASSERT_EQ(decoded.size(), 250u);
+    EXPECT_EQ(decoded[3].symbol_name(), "ARCH_B");
+    EXPECT_EQ(decoded[3].timestamp(), START + minutes{6});
+    EXPECT_DOUBLE_EQ(decoded[3].high(), 3.0);
+    EXPECT_EQ(decoded[3].volume(), 42u);
+
+    // load() returns symbol blocks in order of first appearance, rows in original order within a symbol
+    const BarColumns loaded{archive.load()};
+    ASSERT_EQ(loaded.size(), bars.size());
+    std::size_t row{0};
+    for (const char* symbol : {"ARCH_A", "ARCH_B"})
+    {
+        for (std::size_t i = 0; i < bars.size(); ++i)
+        {
+            if (bars.bar(i).symbol_name() != symbol)
+            {
+                continue;
+            }
+            ASSERT_EQ(loaded.timestamps()[row], bars.timestamps()[i]);
+            ASSERT_DOUBLE_EQ(loaded.opens()[row], bars.opens()[i]);
+            ASSERT_DOUBLE_EQ(loaded.lows()[row], bars.lows()[i]);
+            ASSERT_EQ(loaded.volumes()[row], bars.volumes()[i]);
+            ++row;
+        }
+    }
+}
+
+TEST_F(BarArchiveTest, WarmupReplaysArchive)
+{
+    writeBarArchive(_path.string(), makeBars());
+
+    std::size_t    count{0};
+    WarmupBackfill backfill{[&count](const Bar1min&) { ++count; }};
+    EXPECT_EQ(backfill.replay_archive(_path.string()), 750u);
+    EXPECT_EQ(backfill.replay_archive(_path.string()), 0u);
+    EXPECT_EQ(count, 750u);
+}
+
+TEST_F(BarArchiveTest, RejectsUnorderedInput)
+{
+    BarColumns bars{};
+    bars.push_back(Bar1min{"ARCH_A", 1, 1, 1, 1, 1, START + 1min});
+    bars.push_back(Bar1min{"ARCH_A", 1, 1, 1, 1, 1, START});
+    EXPECT_THROW(writeBarArchive(_path.string(), bars), std::invalid_argument);
+}
+
+TEST_F(BarArchiveTest, RejectsCorruptFiles)
+{
+    writeBarArchive(_path.string(), makeBars());
+    const auto size{std::filesystem::file_size(_path)};
+
+    std::filesystem::resize_file(_path, size / 2);
+    EXPECT_THROW(BarArchive{_path.string()}, std::runtime_error);
+
+    {
+        std::ofstream file{_path, std::ios::binary | std::ios::trunc};
+        file << "not an archive, just some text";
+    }
+    EXPECT_THROW(BarArchive{_path.string()}, std::runtime_error);
+
+    EXPECT_THROW(BarArchive{"/nonexistent/bars.archive"}, std::runtime_error);
+}
+
+TEST_F(BarArchiveTest, EmptyArchive)
+{
+    writeBarArchive(_path.string(), BarColumns{});
+    const BarArchive archive{_path.string()};
+    EXPECT_TRUE(archive.blocks().empty());
+    EXPECT_TRUE(archive.load().empty());
+}
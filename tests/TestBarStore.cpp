@@ -0,0 +1,100 @@
+#include "Bar.hpp"
+#include "BarStore.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace std::chrono;
+
+class BarStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { base_time = sys_time<minutes>{minutes{1000}}; }
+
+    Bar5min make_bar(const std::string_view symbol, const int i) const
+    {
+        const auto price{static_cast<double>(i)};
+        return Bar5min{
+            symbol,
+            price,
+            price + 1.0,
+            price - 1.0,
+            price + 0.5,
+            static_cast<uint64_t>(i) * 10,
+            base_time + minutes{5 * i}};
+    }
+
+    sys_time<minutes> base_time;
+};
+
+TEST_F(BarStoreTest, WindowsAreOldestFirstBeforeWrap)
+{
+    BarSeries<5, minutes> series{SymbolTable::intern("AAPL"), 8};
+    for (int i = 0; i < 5; ++i)
+    {
+        series.push(make_bar("AAPL", i));
+    }
+
+    ASSERT_EQ(series.size(), 5);
+    const auto opens{series.opens(5)};
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_DOUBLE_EQ(opens[i], static_cast<double>(i));
+    }
+
+    EXPECT_THROW((void)series.closes(6), std::out_of_range);
+}
+
+TEST_F(BarStoreTest, WindowsStayContiguousAcrossWrap)
+{
+    constexpr std::size_t capacity{4};
+    BarSeries<5, minutes> series{SymbolTable::intern("AAPL"), capacity};
+    for (int i = 0; i < 11; ++i)
+    {
+        series.push(make_bar("AAPL", i));
+    }
+
+    EXPECT_EQ(series.size(), capacity);
+
+    const auto closes{series.closes(capacity)};
+    const auto volumes{series.volumes(capacity)};
+    const auto timestamps{series.timestamps(capacity)};
+    for (std::size_t k = 0; k < capacity; ++k)
+    {
+        const int i{7 + static_cast<int>(k)};
+        EXPECT_DOUBLE_EQ(closes[k], i + 0.5);
+        EXPECT_EQ(volumes[k], static_cast<uint64_t>(i) * 10);
+        EXPECT_EQ(timestamps[k], base_time + minutes{5 * i});
+    }
+
+    EXPECT_DOUBLE_EQ(std::accumulate(closes.begin(), closes.end(), 0.0), 7.5 + 8.5 + 9.5 + 10.5);
+    EXPECT_EQ(series.bar(), make_bar("AAPL", 10));
+    EXPECT_EQ(series.bar(3), make_bar("AAPL", 7));
+    EXPECT_THROW((void)series.bar(4), std::out_of_range);
+}
+
+TEST_F(BarStoreTest, StoreKeepsSeparateHistoryPerSymbol)
+{
+    BarStore<5, minutes> store{16};
+    for (int i = 0; i < 6; ++i)
+    {
+        store.on_bar(make_bar("AAPL", i));
+        if (i % 2 == 0)
+        {
+            store.on_bar(make_bar("MSFT", 100 + i));
+        }
+    }
+
+    const auto aapl{SymbolTable::intern("AAPL")};
+    const auto msft{SymbolTable::intern("MSFT")};
+
+    ASSERT_TRUE(store.contains(aapl));
+    ASSERT_TRUE(store.contains(msft));
+    EXPECT_FALSE(store.contains(SymbolTable::intern("NOT_STORED")));
+
+    EXPECT_EQ(store.series(aapl).size(), 6);
+    EXPECT_EQ(store.series(msft).size(), 3);
+    EXPECT_EQ(store.series(msft).bar(), make_bar("MSFT", 104));
+    EXPECT_THROW((void)store.series(SymbolTable::intern("NOT_STORED")), std::out_of_range);
+}
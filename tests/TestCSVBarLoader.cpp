@@ -0,0 +1,160 @@
+#include "Bar.hpp"
+#include "BarColumns.hpp"
+#include "CSVBarLoader.hpp"
+#include "Utils.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+const std::string HEADER{"symbol,timestamp,open,high,low,close,volume,trade_count,vwap\n"};
+
+// several symbols, one block each, with enough rows that the file splits into many chunks
+std::string makeCSV(const int rows_per_symbol)
+{
+    std::mt19937                           rng{5};
+    std::uniform_real_distribution<double> price{10.0, 500.0};
+
+    std::ostringstream csv{};
+    csv << HEADER;
+    for (const char* symbol : {"AAPL", "MSFT", "PLTR", "SPY"})
+    {
+        sys_seconds ts{sys_days{2024y / January / 2} + 14h + 30min};
+        for (int i = 0; i < rows_per_symbol; ++i, ts += 1min)
+        {
+            const auto     day{floor<days>(ts)};
+            const hh_mm_ss time{ts - day};
+            char           stamp[32];
+            std::snprintf(
+                stamp,
+                sizeof(stamp),
+                "%04d-%02u-%02u %02ld:%02ld:00+00:00",
+                static_cast<int>(year_month_day{day}.year()),
+                static_cast<unsigned>(year_month_day{day}.month()),
+                static_cast<unsigned>(year_month_day{day}.day()),
+                static_cast<long>(time.hours().count()),
+                static_cast<long>(time.minutes().count()));
+            csv << symbol << ',' << stamp << ',' << price(rng) << ',' << price(rng) << ',' << price(rng) << ','
+                << price(rng) << ',' << 1000 + i << ".0,17," << price(rng) << '\n';
+        }
+    }
+    return csv.str();
+}
+
+void expectSameBars(const BarColumns& actual, const std::vector<Bar1min>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        const Bar1min bar{actual.bar(i)};
+        ASSERT_EQ(bar.symbol(), expected[i].symbol()) << "row " << i;
+        ASSERT_EQ(bar.timestamp(), expected[i].timestamp()) << "row " << i;
+        ASSERT_DOUBLE_EQ(bar.open(), expected[i].open()) << "row " << i;
+        ASSERT_DOUBLE_EQ(bar.high(), expected[i].high()) << "row " << i;
+        ASSERT_DOUBLE_EQ(bar.low(), expected[i].low()) << "row " << i;
+        ASSERT_DOUBLE_EQ(bar.close(), expected[i].close()) << "row " << i;
+        ASSERT_EQ(bar.volume(), expected[i].volume()) << "row " << i;
+    }
+}
+
+std::vector<Bar1min> parseLineByLine(const std::string& csv)
+{
+    std::istringstream   stream{csv};
+    std::string          line{};
+    std::vector<Bar1min> bars{};
+    std::getline(stream, line);
+    while (std::getline(stream, line))
+    {
+        if (!line.empty())
+        {
+            bars.push_back(createBarFromCSVLine(line));
+        }
+    }
+    return bars;
+}
+
+} // namespace
+
+TEST(CSVBarLoaderTest, ParallelLoadMatchesLineByLineParsing)
+{
+    const std::string          csv{makeCSV(20'000)};
+    const std::vector<Bar1min> expected{parseLineByLine(csv)};
+    ASSERT_GT(csv.size(), 4u << 20) << "file should span several chunks";
+
+    for (const std::size_t threads : {1u, 3u, 8u})
+    {
+        CSVBarLoader loader{threads};
+        expectSameBars(loader.parse(csv), expected);
+        EXPECT_EQ(loader.last_stats().rows, expected.size());
+        EXPECT_EQ(loader.last_stats().bytes, csv.size());
+    }
+}
+
+TEST(CSVBarLoaderTest, LoadsMappedFile)
+{
+    const auto        path{std::filesystem::temp_directory_path() / "csv_bar_loader_test.csv"};
+    const std::string csv{makeCSV(500)};
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << csv;
+    }
+
+    CSVBarLoader loader{4};
+    const auto   bars{loader.load(path.string())};
+    expectSameBars(bars, parseLineByLine(csv));
+    EXPECT_GT(loader.last_stats().rows_per_second(), 0.0);
+
+    const auto from_utils{createBarsFromCSV(path.string())};
+    EXPECT_EQ(from_utils.size(), bars.size());
+    std::filesystem::remove(path);
+}
+
+TEST(CSVBarLoaderTest, HandlesLineEndingsAndEmptyInput)
+{
+    CSVBarLoader loader{2};
+
+    EXPECT_TRUE(loader.parse("").empty());
+    EXPECT_TRUE(loader.parse(HEADER).empty());
+
+    const auto bars{loader.parse(
+        HEADER + "SPY,2024-01-02 14:30:00+00:00,1,2,0.5,1.5,100\r\n\r\n"
+                 "SPY,2024-01-02T14:31:00Z,1.5,2.5,1,2,200")};
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars.timestamps()[1], sys_days{2024y / January / 2} + 14h + 31min);
+    EXPECT_EQ(bars.volumes()[1], 200u);
+    EXPECT_DOUBLE_EQ(bars.closes()[0], 1.5);
+}
+
+TEST(CSVBarLoaderTest, RejectsMalformedRows)
+{
+    CSVBarLoader loader{2};
+
+    EXPECT_THROW((void)loader.parse(HEADER + "SPY,2024-01-02 14:30:00+00:00,1,2,0.5,1.5\n"), std::invalid_argument);
+    EXPECT_THROW((void)loader.parse(HEADER + "SPY,2024-01-02 14:30:00+00:00,1,x,0.5,1.5,1\n"), std::invalid_argument);
+    EXPECT_THROW((void)loader.parse(HEADER + "SPY,2024-01-02 14:30:00,1,2,0.5,1.5,1\n"), std::invalid_argument);
+    EXPECT_THROW((void)loader.load("/nonexistent/bars.csv"), std::runtime_error);
+
+    // the message names the offending row, not just the bad field
+    const std::string bad_timestamp_row{"SPY,2024-01-02 14:30:00,1,2,0.5,1.5,1"};
+    try
+    {
+        (void)loader.parse(HEADER + bad_timestamp_row + "\n");
+        FAIL() << "expected std::invalid_argument";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_NE(std::string{e.what()}.find("bad timestamp"), std::string::npos) << e.what();
+        EXPECT_NE(std::string{e.what()}.find(bad_timestamp_row), std::string::npos) << e.what();
+    }
+}
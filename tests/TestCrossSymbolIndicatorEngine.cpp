@@ -0,0 +1,150 @@
+#include "Bar.hpp"
+#include "CrossSymbolIndicatorEngine.hpp"
+#include "IndicatorConfig.hpp"
+#include "indicators/ohlcv/ATR.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+class CrossSymbolIndicatorEngineTest : public ::testing::Test
+{
+protected:
+    struct Reference
+    {
+        SymbolId symbol;
+        EMA      ema{20};
+        ATR      atr{14};
+        MACD     macd{12, 26, 9};
+    };
+
+    void SetUp() override
+    {
+        configs = {
+            IndicatorConfig{.name = "EMA", .params = {{"period", 20}}},
+            IndicatorConfig{.name = "ATR", .params = {{"period", 14}}},
+            IndicatorConfig{
+                .name = "MACD", .params = {{"fast_period", 12}, {"slow_period", 26}, {"signal_period", 9}}}};
+
+        // 11 symbols: more than one vector of lanes, and not a multiple of the lane padding
+        for (int i = 0; i < 11; ++i)
+        {
+            references.push_back(Reference{.symbol = SymbolTable::intern("LANE" + std::to_string(i))});
+            prices.push_back(50.0 + 10.0 * i);
+        }
+    }
+
+    Bar5min next_bar(const std::size_t i, const sys_time<minutes> timestamp)
+    {
+        const double open{prices[i]};
+        prices[i] += step(rng);
+        const double close{prices[i]};
+        return Bar5min{
+            references[i].symbol,
+            open,
+            std::max(open, close) + spread(rng),
+            std::min(open, close) - spread(rng),
+            close,
+            1000,
+            timestamp};
+    }
+
+    std::vector<IndicatorConfig> configs{};
+    std::vector<Reference>       references{};
+    std::vector<double>          prices{};
+
+    std::mt19937                           rng{7};
+    std::normal_distribution<double>       step{0.0, 1.0};
+    std::uniform_real_distribution<double> spread{0.1, 1.5};
+};
+
+TEST_F(CrossSymbolIndicatorEngineTest, LanesMatchPerSymbolIndicators)
+{
+    DefaultCrossSymbolIndicatorEngine engine{configs, references.size()};
+
+    std::size_t batches{0};
+    std::size_t updated{0};
+    auto        connection{engine.subscribe(
+        [&](const Bar5min::Timestamp, const std::span<const SymbolId> symbols)
+        {
+            ++batches;
+            updated += symbols.size();
+        })};
+
+    std::size_t             expected_updates{0};
+    const sys_time<minutes> start{minutes{600}};
+    for (int t = 0; t < 80; ++t)
+    {
+        const sys_time<minutes> timestamp{start + minutes{5 * t}};
+        for (std::size_t i = 0; i < references.size(); ++i)
+        {
+            // every third symbol skips some windows; its lane must keep its state across the gap
+            if (i % 3 == 2 && t % 4 == 1)
+            {
+                continue;
+            }
+
+            const Bar5min bar{next_bar(i, timestamp)};
+            engine.on_bar(bar);
+            references[i].ema.write(bar.ohlcv());
+            references[i].atr.write(bar.ohlcv());
+            references[i].macd.write(bar.ohlcv());
+            ++expected_updates;
+        }
+    }
+    engine.flush();
+    connection.disconnect();
+
+    EXPECT_EQ(batches, 80);
+
+    const auto ema{engine.handle("EMA", "ema")};
+    const auto atr{engine.handle("ATR", "atr")};
+    auto       snapshot{engine.make_snapshot()};
+    EXPECT_EQ(updated, expected_updates);
+
+    for (const auto& reference : references)
+    {
+        ASSERT_TRUE(engine.is_ready(reference.symbol));
+        engine.read(reference.symbol, snapshot);
+
+        EXPECT_NEAR(snapshot[ema], reference.ema.value(), 1e-9);
+        EXPECT_NEAR(snapshot[atr], reference.atr.value(), 1e-9);
+        EXPECT_NEAR(snapshot.at("MACD", "macd"), reference.macd.macd(), 1e-9);
+        EXPECT_NEAR(snapshot.at("MACD", "signal"), reference.macd.signal(), 1e-9);
+        EXPECT_NEAR(snapshot.at("MACD", "histogram"), reference.macd.histogram(), 1e-9);
+    }
+}
+
+TEST_F(CrossSymbolIndicatorEngineTest, ReadinessIsTrackedPerSymbol)
+{
+    DefaultCrossSymbolIndicatorEngine engine{{configs[0]}};
+
+    const sys_time<minutes> start{minutes{600}};
+    for (int t = 0; t < 20; ++t)
+    {
+        engine.on_bar(next_bar(0, start + minutes{5 * t}));
+        if (t >= 10)
+        {
+            engine.on_bar(next_bar(1, start + minutes{5 * t}));
+        }
+    }
+    engine.flush();
+
+    EXPECT_TRUE(engine.is_ready(references[0].symbol));
+    EXPECT_FALSE(engine.is_ready(references[1].symbol));
+    EXPECT_FALSE(engine.is_ready(SymbolTable::intern("NEVER_SEEN")));
+    EXPECT_THROW((void)engine.read(references[1].symbol), std::runtime_error);
+}
+
+TEST_F(CrossSymbolIndicatorEngineTest, RejectsIndicatorsWithoutLaneImplementation)
+{
+    EXPECT_THROW(
+        DefaultCrossSymbolIndicatorEngine({IndicatorConfig{.name = "RSI", .params = {{"period", 14}}}}),
+        std::runtime_error);
+}
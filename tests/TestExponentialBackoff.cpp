@@ -0,0 +1,38 @@
+#include "ExponentialBackoff.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+
+using namespace std::chrono;
+
+TEST(ExponentialBackoffTest, DelaysDoubleWithinJitterBounds)
+{
+    ExponentialBackoff backoff{milliseconds{500}, milliseconds{30'000}, 42};
+
+    milliseconds cap{500};
+    for (int attempt = 0; attempt < 12; ++attempt)
+    {
+        const auto delay{backoff.next_delay()};
+        EXPECT_GE(delay, cap / 2) << "attempt " << attempt;
+        EXPECT_LE(delay, cap) << "attempt " << attempt;
+        cap = std::min(cap * 2, milliseconds{30'000});
+    }
+    EXPECT_EQ(backoff.attempts(), 12u);
+}
+
+TEST(ExponentialBackoffTest, ResetStartsOver)
+{
+    ExponentialBackoff backoff{milliseconds{100}, milliseconds{10'000}, 7};
+    for (int i = 0; i < 20; ++i)
+        (void)backoff.next_delay();
+
+    backoff.reset();
+    EXPECT_EQ(backoff.attempts(), 0u);
+    EXPECT_LE(backoff.next_delay(), milliseconds{100});
+}
+
+TEST(ExponentialBackoffTest, RejectsInvalidBounds)
+{
+    EXPECT_THROW((ExponentialBackoff{milliseconds{0}, milliseconds{10}}), std::invalid_argument);
+    EXPECT_THROW((ExponentialBackoff{milliseconds{10}, milliseconds{5}}), std::invalid_argument);
+}
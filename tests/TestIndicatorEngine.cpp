@@ -3,6 +3,9 @@
 #include "IndicatorConfig.hpp"
 #include "IndicatorEngine.hpp"
 #include "Utils.hpp"
+#include "indicators/ohlcv/ATR.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
 
 #include <cstdlib>
 #include <filesystem>
@@ -33,8 +36,8 @@ protected:
                                                           { this->on_aggregated_bar(aggregated_bar); });
 
         // Connect to indicator updates
-        indicator_connection = indicator_engine->subscribe([this](const DefaultIndicatorEngine::Snapshots& snapshots)
-                                                           { this->on_indicator_update(snapshots); });
+        indicator_connection = indicator_engine->subscribe([this](const DefaultIndicatorEngine::Snapshot& snapshot)
+                                                           { this->on_indicator_update(snapshot); });
     }
 
     void TearDown() override
@@ -43,14 +46,14 @@ protected:
         indicator_connection.disconnect();
     }
 
-    void on_indicator_update(const DefaultIndicatorEngine::Snapshots& snapshots)
+    void on_indicator_update(const DefaultIndicatorEngine::Snapshot& snapshot)
     {
         if (!indicators_ready)
         {
             indicators_ready       = true;
             first_indicator_update = aggregated_bar_count;
         }
-        snapshot_history.push_back(snapshots);
+        snapshot_history.push_back(snapshot);
     }
 
     void on_aggregated_bar(const Bar5min& bar)
@@ -69,7 +72,7 @@ protected:
     int                                            aggregated_bar_count{0};
     bool                                           indicators_ready{false};
     int                                            first_indicator_update{0};
-    std::vector<DefaultIndicatorEngine::Snapshots> snapshot_history;
+    std::vector<DefaultIndicatorEngine::Snapshot>  snapshot_history;
 };
 
 TEST_F(IndicatorEngineIntegrationTest, ProcessesPLTRDataAndProducesSteadyIndicatorStream)
@@ -106,26 +109,23 @@ TEST_F(IndicatorEngineIntegrationTest, ProcessesPLTRDataAndProducesSteadyIndicat
     // Verify each snapshot contains all expected indicators
     for (const auto& snapshot : snapshot_history)
     {
-        EXPECT_EQ(snapshot.size(), 3) << "Snapshot missing indicators";
+        EXPECT_EQ(snapshot.indicator_count(), 3) << "Snapshot missing indicators";
         EXPECT_TRUE(snapshot.contains("EMA")) << "Missing EMA in snapshot";
         EXPECT_TRUE(snapshot.contains("ATR")) << "Missing ATR in snapshot";
         EXPECT_TRUE(snapshot.contains("MACD")) << "Missing MACD in snapshot";
 
         // Verify EMA snapshot structure
-        const auto& ema_values = snapshot.at("EMA");
-        EXPECT_TRUE(ema_values.contains("ema")) << "Missing 'ema' value in EMA snapshot";
-        EXPECT_GT(ema_values.at("ema"), 0.0) << "Invalid EMA value";
+        EXPECT_TRUE(snapshot.contains("EMA", "ema")) << "Missing 'ema' value in EMA snapshot";
+        EXPECT_GT(snapshot.at("EMA", "ema"), 0.0) << "Invalid EMA value";
 
         // Verify ATR snapshot structure
-        const auto& atr_values = snapshot.at("ATR");
-        EXPECT_TRUE(atr_values.contains("atr")) << "Missing 'atr' value in ATR snapshot";
-        EXPECT_GT(atr_values.at("atr"), 0.0) << "Invalid ATR value";
+        EXPECT_TRUE(snapshot.contains("ATR", "atr")) << "Missing 'atr' value in ATR snapshot";
+        EXPECT_GT(snapshot.at("ATR", "atr"), 0.0) << "Invalid ATR value";
 
         // Verify MACD snapshot structure
-        const auto& macd_values = snapshot.at("MACD");
-        EXPECT_TRUE(macd_values.contains("macd")) << "Missing 'macd' value in MACD snapshot";
-        EXPECT_TRUE(macd_values.contains("signal")) << "Missing 'signal' value in MACD snapshot";
-        EXPECT_TRUE(macd_values.contains("histogram")) << "Missing 'histogram' value in MACD snapshot";
+        EXPECT_TRUE(snapshot.contains("MACD", "macd")) << "Missing 'macd' value in MACD snapshot";
+        EXPECT_TRUE(snapshot.contains("MACD", "signal")) << "Missing 'signal' value in MACD snapshot";
+        EXPECT_TRUE(snapshot.contains("MACD", "histogram")) << "Missing 'histogram' value in MACD snapshot";
     }
 
     // Verify indicator values are changing (not stuck)
@@ -136,9 +136,9 @@ TEST_F(IndicatorEngineIntegrationTest, ProcessesPLTRDataAndProducesSteadyIndicat
 
         // At least one indicator should have different values
         bool values_changed = false;
-        values_changed |= (first_snapshot.at("EMA").at("ema") != last_snapshot.at("EMA").at("ema"));
-        values_changed |= (first_snapshot.at("ATR").at("atr") != last_snapshot.at("ATR").at("atr"));
-        values_changed |= (first_snapshot.at("MACD").at("macd") != last_snapshot.at("MACD").at("macd"));
+        values_changed |= (first_snapshot.at("EMA", "ema") != last_snapshot.at("EMA", "ema"));
+        values_changed |= (first_snapshot.at("ATR", "atr") != last_snapshot.at("ATR", "atr"));
+        values_changed |= (first_snapshot.at("MACD", "macd") != last_snapshot.at("MACD", "macd"));
 
         EXPECT_TRUE(values_changed) << "Indicator values did not change over time";
     }
@@ -154,12 +154,111 @@ TEST_F(IndicatorEngineIntegrationTest, ProcessesPLTRDataAndProducesSteadyIndicat
     {
         const auto& final_snapshot = snapshot_history.back();
         std::cout << "  Final indicator values:" << std::endl;
-        std::cout << "    EMA(20): " << final_snapshot.at("EMA").at("ema") << std::endl;
-        std::cout << "    ATR(14): " << final_snapshot.at("ATR").at("atr") << std::endl;
-        std::cout << "    MACD: " << final_snapshot.at("MACD").at("macd") << std::endl;
-        std::cout << "    Signal: " << final_snapshot.at("MACD").at("signal") << std::endl;
-        std::cout << "    Histogram: " << final_snapshot.at("MACD").at("histogram") << std::endl;
+        std::cout << "    EMA(20): " << final_snapshot.at("EMA", "ema") << std::endl;
+        std::cout << "    ATR(14): " << final_snapshot.at("ATR", "atr") << std::endl;
+        std::cout << "    MACD: " << final_snapshot.at("MACD", "macd") << std::endl;
+        std::cout << "    Signal: " << final_snapshot.at("MACD", "signal") << std::endl;
+        std::cout << "    Histogram: " << final_snapshot.at("MACD", "histogram") << std::endl;
     }
 
     std::filesystem::remove(csv_path);
 }
+
+TEST_F(IndicatorEngineIntegrationTest, HandlesIndexTheFlatSnapshot)
+{
+    EMA  ema{20};
+    ATR  atr{14};
+    MACD macd{12, 26, 9};
+
+    const auto ema_handle{indicator_engine->handle("EMA", "ema")};
+    const auto atr_handle{indicator_engine->handle("ATR", "atr")};
+    const auto signal_handle{indicator_engine->handle("MACD", "signal")};
+    EXPECT_THROW((void)indicator_engine->handle("MACD", "ema"), std::out_of_range);
+    EXPECT_THROW((void)indicator_engine->handle("RSI", "rsi"), std::out_of_range);
+
+    const std::chrono::sys_time<std::chrono::minutes> start{std::chrono::minutes{600}};
+    for (int i = 0; i < 60; ++i)
+    {
+        const double  price{100.0 + (i % 7) - 0.25 * i};
+        const Bar5min bar{
+            "ENGINE", price, price + 1.5, price - 1.0, price + 0.5, 1000, start + std::chrono::minutes{5 * i}};
+        indicator_engine->on_bar(bar);
+        ema.write(bar.ohlcv());
+        atr.write(bar.ohlcv());
+        macd.write(bar.ohlcv());
+    }
+
+    ASSERT_TRUE(indicator_engine->is_ready());
+    const auto& snapshot{indicator_engine->snapshot()};
+    EXPECT_EQ(snapshot.values().size(), 5);
+    EXPECT_DOUBLE_EQ(snapshot[ema_handle], ema.value());
+    EXPECT_DOUBLE_EQ(snapshot[atr_handle], atr.value());
+    EXPECT_DOUBLE_EQ(snapshot[signal_handle], macd.signal());
+    EXPECT_EQ(snapshot_history.size(), 60 - 34);
+}
+
+TEST_F(IndicatorEngineIntegrationTest, SharedDependenciesAreEvaluatedOnce)
+{
+    const IndicatorConfig ema_12{.name = "EMA", .params = {{"period", 12}}, .label = "EMA12"};
+    const IndicatorConfig macd_config{
+        .name = "MACD", .params = {{"signal_period", 9}, {"fast_period", 12}, {"slow_period", 26}}};
+    const IndicatorConfig atr_config{.name = "ATR", .params = {{"period", 14}}};
+
+    // EMA-12 is shared with MACD's fast EMA and listed twice; ATR pulls in a TR node
+    DefaultIndicatorEngine engine{{macd_config, ema_12, atr_config, ema_12}};
+    EXPECT_EQ(engine.node_count(), 5);
+    EXPECT_EQ(engine.snapshot().indicator_count(), 3);
+
+    EMA  ema{12};
+    ATR  atr{14};
+    MACD macd{12, 26, 9};
+
+    const std::chrono::sys_time<std::chrono::minutes> start{std::chrono::minutes{600}};
+    for (int i = 0; i < 60; ++i)
+    {
+        const double  price{80.0 + (i % 5) + 0.1 * i};
+        const Bar5min bar{
+            "SHARED", price, price + 0.75, price - 1.25, price + 0.25, 1000, start + std::chrono::minutes{5 * i}};
+        engine.on_bar(bar);
+        ema.write(bar.ohlcv());
+        atr.write(bar.ohlcv());
+        macd.write(bar.ohlcv());
+        ASSERT_EQ(engine.is_ready(), ema.is_ready() && atr.is_ready() && macd.is_ready()) << "bar " << i;
+    }
+
+    const auto& snapshot{engine.snapshot()};
+    EXPECT_DOUBLE_EQ(snapshot[engine.handle(ema_12, "ema")], ema.value());
+    EXPECT_DOUBLE_EQ(snapshot[engine.handle("EMA12", "ema")], ema.value());
+    EXPECT_DOUBLE_EQ(snapshot[engine.handle(atr_config, "atr")], atr.value());
+    EXPECT_DOUBLE_EQ(snapshot[engine.handle(macd_config, "macd")], macd.macd());
+    EXPECT_DOUBLE_EQ(snapshot[engine.handle(macd_config, "signal")], macd.signal());
+    EXPECT_THROW(
+        (void)engine.handle(IndicatorConfig{.name = "EMA", .params = {{"period", 26}}}, "ema"), std::out_of_range);
+}
+
+TEST(IndicatorEngineTest, DeduplicatedConfigsKeepTheirLabels)
+{
+    const IndicatorConfig fast{.name = "EMA", .params = {{"period", 12}}, .label = "fast"};
+    const IndicatorConfig entry{.name = "EMA", .params = {{"period", 12}}, .label = "entry"};
+
+    DefaultIndicatorEngine engine{{fast, entry}};
+    EXPECT_EQ(engine.node_count(), 1);
+    EXPECT_EQ(engine.snapshot().indicator_count(), 1);
+    EXPECT_EQ(engine.handle("entry", "ema"), engine.handle("fast", "ema"));
+    EXPECT_EQ(engine.handle(entry, "ema"), engine.handle("fast", "ema"));
+
+    // a label that already names a different computation is still rejected
+    const IndicatorConfig slow{.name = "EMA", .params = {{"period", 26}}, .label = "slow"};
+    const IndicatorConfig slow_as_fast{.name = "EMA", .params = {{"period", 26}}, .label = "fast"};
+    EXPECT_THROW((DefaultIndicatorEngine{{fast, slow, slow_as_fast}}), std::invalid_argument);
+}
+
+TEST(IndicatorConfigTest, KeyIsIndependentOfParamOrder)
+{
+    const IndicatorConfig a{.name = "MACD", .params = {{"fast_period", 12}, {"slow_period", 26}, {"signal_period", 9}}};
+    const IndicatorConfig b{.name = "MACD", .params = {{"signal_period", 9}, {"slow_period", 26}, {"fast_period", 12}}};
+
+    EXPECT_EQ(indicator_key(a), "MACD(fast_period=12,signal_period=9,slow_period=26)");
+    EXPECT_EQ(indicator_key(a), indicator_key(b));
+    EXPECT_EQ(indicator_key(IndicatorConfig{.name = "TR"}), "TR()");
+}
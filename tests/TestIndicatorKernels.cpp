@@ -0,0 +1,159 @@
+#include "Bar.hpp"
+#include "indicators/Kernels.hpp"
+#include "indicators/ohlcv/ATR.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+class IndicatorKernelsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // odd length so every kernel runs both its vector body and its scalar tail
+        constexpr std::size_t count{257};
+
+        std::mt19937                           rng{42};
+        std::normal_distribution<double>       step{0.0, 1.0};
+        std::uniform_real_distribution<double> spread{0.1, 2.0};
+
+        double price{100.0};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double open{price};
+            price += step(rng);
+            bars.emplace_back(
+                open, std::max(open, price) + spread(rng), std::min(open, price) - spread(rng), price, 1000);
+            highs.push_back(bars.back().high);
+            lows.push_back(bars.back().low);
+            closes.push_back(bars.back().close);
+        }
+    }
+
+    static void expectNear(const double expected, const double actual, const std::size_t i)
+    {
+        if (std::isnan(expected))
+        {
+            EXPECT_TRUE(std::isnan(actual)) << "index " << i;
+        }
+        else
+        {
+            EXPECT_NEAR(expected, actual, 1e-9) << "index " << i;
+        }
+    }
+
+    std::vector<OHLCV>  bars{};
+    std::vector<double> highs{};
+    std::vector<double> lows{};
+    std::vector<double> closes{};
+};
+
+TEST_F(IndicatorKernelsTest, KernelsMatchScalarReference)
+{
+    double expected_sum{0.0};
+    for (const double close : closes)
+    {
+        expected_sum += close;
+    }
+    EXPECT_NEAR(kernels::sum(closes), expected_sum, 1e-9);
+    EXPECT_DOUBLE_EQ(kernels::sum({}), 0.0);
+
+    const std::size_t   n{closes.size() - 1};
+    const std::span     prev_closes{std::span{closes}.first(n)};
+    std::vector<double> tr(n);
+    std::vector<double> diff(n);
+    kernels::true_range(std::span{highs}.subspan(1), std::span{lows}.subspan(1), prev_closes, tr);
+    kernels::subtract(std::span{highs}.subspan(1), prev_closes, diff);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double high{highs[i + 1]};
+        const double low{lows[i + 1]};
+        EXPECT_DOUBLE_EQ(
+            tr[i], std::max({high - low, std::abs(high - prev_closes[i]), std::abs(low - prev_closes[i])}));
+        EXPECT_DOUBLE_EQ(diff[i], high - prev_closes[i]);
+    }
+}
+
+TEST_F(IndicatorKernelsTest, BatchEMAMatchesStreaming)
+{
+    EMA streaming{20};
+    EMA batch{20};
+
+    std::vector<double> out(closes.size());
+    batch.write(closes, out);
+
+    for (std::size_t i = 0; i < closes.size(); ++i)
+    {
+        streaming.write(closes[i]);
+        expectNear(streaming.is_ready() ? streaming.value() : NAN, out[i], i);
+    }
+    EXPECT_NEAR(streaming.value(), batch.value(), 1e-9);
+
+    // split batches continue where the previous one stopped, including a warm-up that spans both
+    EMA split{20};
+    split.write(std::span{closes}.first(7));
+    EXPECT_FALSE(split.is_ready());
+    split.write(std::span{closes}.subspan(7));
+    EXPECT_NEAR(streaming.value(), split.value(), 1e-9);
+}
+
+TEST_F(IndicatorKernelsTest, BatchATRMatchesStreaming)
+{
+    ATR streaming{14};
+    ATR batch{14};
+
+    std::vector<double> out(closes.size());
+    batch.write(highs, lows, closes, out);
+
+    for (std::size_t i = 0; i < bars.size(); ++i)
+    {
+        streaming.write(bars[i]);
+        expectNear(streaming.is_ready() ? streaming.value() : NAN, out[i], i);
+    }
+
+    ATR split{14};
+    split.write(std::span{highs}.first(5), std::span{lows}.first(5), std::span{closes}.first(5));
+    split.write(std::span{highs}.subspan(5), std::span{lows}.subspan(5), std::span{closes}.subspan(5));
+    EXPECT_NEAR(streaming.value(), split.value(), 1e-9);
+
+    EXPECT_THROW(batch.write(highs, std::span{lows}.first(3), closes), std::invalid_argument);
+}
+
+TEST_F(IndicatorKernelsTest, BatchMACDMatchesStreaming)
+{
+    MACD streaming{12, 26, 9};
+    MACD batch{12, 26, 9};
+
+    std::vector<double> macd(closes.size());
+    std::vector<double> signal(closes.size());
+    std::vector<double> histogram(closes.size());
+    batch.write(closes, macd, signal, histogram);
+
+    for (std::size_t i = 0; i < bars.size(); ++i)
+    {
+        streaming.write(bars[i]);
+        if (streaming.is_ready())
+        {
+            expectNear(streaming.macd(), macd[i], i);
+            expectNear(streaming.signal(), signal[i], i);
+            expectNear(streaming.histogram(), histogram[i], i);
+        }
+        else
+        {
+            EXPECT_TRUE(std::isnan(signal[i])) << "index " << i;
+        }
+    }
+
+    MACD split{12, 26, 9};
+    split.write(std::span{closes}.first(30));
+    split.write(std::span{closes}.subspan(30));
+    EXPECT_TRUE(split.is_ready());
+    EXPECT_NEAR(streaming.signal(), split.signal(), 1e-9);
+}
@@ -98,7 +98,7 @@ TEST_F(IndicatorTest, EMA_CompareWithTALib)
     ASSERT_EQ(ret_code, TA_SUCCESS) << "TA-Lib EMA calculation failed";
     ASSERT_TRUE(my_ema.is_ready()) << "My EMA should be ready";
 
-    const double my_result{my_ema.read()["ema"]};
+    const double my_result{my_ema.value()};
     const double talib_value{talib_ema[out_nb_element - 1]};
 
     logComparison("EMA", period, my_result, talib_value, threshold);
@@ -154,7 +154,7 @@ TEST_F(IndicatorTest, ATR_CompareWithTALib)
     ASSERT_EQ(ret_code, TA_SUCCESS) << "TA-Lib ATR calculation failed";
     ASSERT_TRUE(my_atr.is_ready()) << "My ATR should be ready";
 
-    const double my_value{my_atr.read()["atr"]};
+    const double my_value{my_atr.value()};
     const double talib_value{talib_atr[out_nb_element - 1]};
 
     logComparison("ATR", period, my_value, talib_value, threshold);
@@ -213,10 +213,9 @@ TEST_F(IndicatorTest, MACD_CompareWithTALib)
     ASSERT_EQ(ret_code, TA_SUCCESS) << "TA-Lib MACD calculation failed";
     ASSERT_TRUE(my_macd.is_ready()) << "My MACD should be ready";
 
-    auto   my_snapshot        = my_macd.read();
-    double my_macd_value      = my_snapshot["macd"];
-    double my_signal_value    = my_snapshot["signal"];
-    double my_histogram_value = my_snapshot["histogram"];
+    double my_macd_value      = my_macd.macd();
+    double my_signal_value    = my_macd.signal();
+    double my_histogram_value = my_macd.histogram();
 
     double talib_macd_value      = talib_macd[out_nb_element - 1];
     double talib_signal_value    = talib_signal[out_nb_element - 1];
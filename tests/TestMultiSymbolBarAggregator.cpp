@@ -0,0 +1,104 @@
+#include "Bar.hpp"
+#include "BarAggregator.hpp"
+#include "MultiSymbolBarAggregator.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+class MultiSymbolBarAggregatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { base_time = sys_time<minutes>{minutes{1000}}; }
+
+    static Bar1min make_bar(const std::string& symbol, const sys_time<minutes> ts, const double seed)
+    {
+        return Bar1min{symbol, seed, seed + 2.0, seed - 1.0, seed + 1.0, static_cast<uint64_t>(seed * 10), ts};
+    }
+
+    sys_time<minutes> base_time;
+};
+
+TEST_F(MultiSymbolBarAggregatorTest, InterleavedSymbolsMatchPerSymbolAggregators)
+{
+    const std::vector<std::string> symbols{"AAPL", "MSFT", "PLTR"};
+
+    MultiSymbolBarAggregator<5, minutes> multi{symbols.size()};
+    std::vector<Bar5min>                 multi_out;
+    multi.subscribe([&](const Bar5min& bar) { multi_out.push_back(bar); });
+
+    std::vector<BarAggregator<5, minutes>> singles(symbols.size());
+    std::vector<Bar5min>                   single_out;
+    for (auto& single : singles)
+    {
+        single.subscribe([&](const Bar5min& bar) { single_out.push_back(bar); });
+    }
+
+    for (int minute = 0; minute < 10; ++minute)
+    {
+        for (std::size_t s = 0; s < symbols.size(); ++s)
+        {
+            const auto bar{make_bar(symbols[s], base_time + minutes{minute}, 100.0 * (s + 1) + minute)};
+            multi.on_bar(bar);
+            singles[s].on_bar(bar);
+        }
+    }
+
+    EXPECT_EQ(multi.symbol_count(), symbols.size());
+    ASSERT_EQ(multi_out.size(), 6);
+    ASSERT_EQ(multi_out.size(), single_out.size());
+    for (const auto& bar : single_out)
+    {
+        EXPECT_NE(std::find(multi_out.begin(), multi_out.end(), bar), multi_out.end())
+            << "missing aggregated bar for " << bar.symbol();
+    }
+}
+
+TEST_F(MultiSymbolBarAggregatorTest, AggregatesOHLCVWithinWindow)
+{
+    MultiSymbolBarAggregator<5, minutes> aggregator{};
+    std::vector<Bar5min>                 out;
+    aggregator.subscribe([&](const Bar5min& bar) { out.push_back(bar); });
+
+    for (int minute = 0; minute < 5; ++minute)
+    {
+        aggregator.on_bar(make_bar("AAPL", base_time + minutes{minute}, 100.0 + minute));
+    }
+
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], (Bar5min{"AAPL", 100.0, 106.0, 99.0, 105.0, 5100, base_time}));
+}
+
+TEST_F(MultiSymbolBarAggregatorTest, GapRestartsOnlyTheAffectedSymbol)
+{
+    MultiSymbolBarAggregator<5, minutes> aggregator{};
+    std::vector<Bar5min>                 out;
+    aggregator.subscribe([&](const Bar5min& bar) { out.push_back(bar); });
+
+    for (int minute = 0; minute < 3; ++minute)
+    {
+        aggregator.on_bar(make_bar("AAPL", base_time + minutes{minute}, 100.0));
+        aggregator.on_bar(make_bar("MSFT", base_time + minutes{minute}, 200.0));
+    }
+
+    // AAPL skips two minutes, MSFT keeps printing
+    for (int minute = 3; minute < 5; ++minute)
+    {
+        aggregator.on_bar(make_bar("MSFT", base_time + minutes{minute}, 200.0));
+    }
+
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].symbol_name(), "MSFT");
+
+    for (int minute = 5; minute < 10; ++minute)
+    {
+        EXPECT_NO_THROW(aggregator.on_bar(make_bar("AAPL", base_time + minutes{minute}, 100.0)));
+    }
+
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[1].symbol_name(), "AAPL");
+    EXPECT_EQ(out[1].timestamp(), base_time + minutes{5});
+}
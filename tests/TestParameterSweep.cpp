@@ -0,0 +1,92 @@
+#include "Backtester.hpp"
+#include "Bar.hpp"
+#include "ParameterSweep.hpp"
+#include "SyntheticSessions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+std::vector<Bar1min> makeSessions(const int sessions)
+{
+    return makeSyntheticSessions("SWEEP", sessions, sys_days{2024y / March / 4} + 14h + 30min, 23);
+}
+
+const ParameterGrid GRID{
+    .ema_periods         = {20, 50},
+    .fast_periods        = {8, 12, 26},
+    .slow_periods        = {21, 26},
+    .signal_periods      = {9},
+    .atr_periods         = {14},
+    .atr_thresholds      = {0.01, 0.05},
+    .stop_atr_multiples  = {1.5, 3.0},
+    .aggregation_minutes = {1, 5}};
+
+} // namespace
+
+TEST(ParameterGridTest, ExpandsAndSamples)
+{
+    // fast/slow pairs with fast < slow: (8, 21), (8, 26), (12, 21), (12, 26)
+    const auto points{GRID.expand()};
+    EXPECT_EQ(points.size(), 2u * 4u * 2u * 2u * 2u);
+    for (const auto& point : points)
+    {
+        EXPECT_LT(point.strategy.fast_period, point.strategy.slow_period);
+    }
+
+    const auto sampled{GRID.sample(50, 7)};
+    ASSERT_EQ(sampled.size(), 50u);
+    for (const auto& point : sampled)
+    {
+        EXPECT_LT(point.strategy.fast_period, point.strategy.slow_period);
+        EXPECT_TRUE(point.aggregation_minutes == 1 || point.aggregation_minutes == 5);
+    }
+    const auto resampled{GRID.sample(50, 7)};
+    EXPECT_EQ(resampled.front().strategy.ema_period, sampled.front().strategy.ema_period);
+    EXPECT_EQ(resampled.back().strategy.atr_threshold, sampled.back().strategy.atr_threshold);
+
+    ParameterGrid empty{GRID};
+    empty.atr_periods.clear();
+    EXPECT_THROW((void)empty.expand(), std::invalid_argument);
+    ParameterGrid inverted{GRID};
+    inverted.fast_periods = {30};
+    EXPECT_THROW((void)inverted.sample(1, 1), std::invalid_argument);
+    EXPECT_THROW((void)inverted.expand(), std::invalid_argument);
+}
+
+TEST(ParameterSweepTest, RanksParallelResultsLikeSequentialBacktests)
+{
+    const auto           bars{makeSessions(10)};
+    const BacktestConfig base{.starting_cash = 1000.0, .fill_model = {.slippage_bps = 1.0}};
+    const auto           candidates{GRID.expand()};
+
+    const ParameterSweep sweep{bars, base, 4};
+    const auto           results{sweep.run(candidates)};
+    ASSERT_EQ(results.size(), candidates.size());
+
+    for (std::size_t i = 1; i < results.size(); ++i)
+    {
+        EXPECT_GE(results[i - 1].report.total_return(), results[i].report.total_return());
+    }
+    for (const std::size_t i : {std::size_t{0}, results.size() / 2, results.size() - 1})
+    {
+        const auto expected{ParameterSweep::backtest(bars, base, results[i].params)};
+        EXPECT_EQ(results[i].report.trades, expected.trades);
+        EXPECT_DOUBLE_EQ(results[i].report.final_equity, expected.final_equity);
+    }
+
+    std::ostringstream table{};
+    writeSweepResults(table, results, 3);
+    EXPECT_EQ(std::ranges::count(table.str(), '\n'), 4);
+    EXPECT_TRUE(table.str().starts_with("rank,aggregation_minutes,"));
+
+    std::vector<SweepParams> unsupported{SweepParams{.aggregation_minutes = 7}};
+    EXPECT_THROW((void)sweep.run(unsupported), std::invalid_argument);
+}
@@ -0,0 +1,243 @@
+#include "Bar.hpp"
+#include "BarAggregator.hpp"
+#include "Checkpoint.hpp"
+#include "IndicatorConfig.hpp"
+#include "IndicatorEngine.hpp"
+#include "StateCheckpointer.hpp"
+#include "StateSerialization.hpp"
+#include "indicators/ohlcv/EMA.hpp"
+#include "indicators/ohlcv/MACD.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+using Checkpointer = StateCheckpointer<5, minutes>;
+
+const std::vector<IndicatorConfig> CONFIGS{
+    IndicatorConfig{.name = "EMA", .params = {{"period", 20}}},
+    IndicatorConfig{.name = "MACD", .params = {{"fast_period", 12}, {"slow_period", 26}, {"signal_period", 9}}},
+    IndicatorConfig{.name = "ATR", .params = {{"period", 14}}}};
+
+const sys_time<minutes> START{minutes{600}};
+
+std::vector<Bar1min> make_bars(const int count)
+{
+    std::mt19937                     rng{11};
+    std::normal_distribution<double> step{0.0, 0.3};
+
+    std::vector<Bar1min> bars{};
+    double               price{80.0};
+    for (int i = 0; i < count; ++i)
+    {
+        const double open{price};
+        price += step(rng);
+        bars.emplace_back(
+            "CKPT", open, std::max(open, price) + 0.1, std::min(open, price) - 0.1, price, 100, START + minutes{i});
+    }
+    return bars;
+}
+
+struct Pipeline
+{
+    explicit Pipeline(const std::filesystem::path& path, const std::size_t save_every_bars = 7)
+        : checkpointer{path, aggregator, engine, save_every_bars}
+    {
+        connection = aggregator.subscribe([this](const Bar5min& bar) { engine.on_bar(bar); });
+    }
+
+    void on_bar(const Bar1min& bar)
+    {
+        aggregator.on_bar(bar);
+        checkpointer.on_bar(bar);
+    }
+
+    BarAggregator<5, minutes>          aggregator{};
+    OHLCVIndicatorEngine<5, minutes>   engine{CONFIGS};
+    Checkpointer                       checkpointer;
+    boost::signals2::scoped_connection connection{};
+};
+
+class StateCheckpointTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = std::filesystem::temp_directory_path()
+              / (std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()} + ".ckpt");
+        std::filesystem::remove(_path);
+    }
+
+    void TearDown() override { std::filesystem::remove(_path); }
+
+    std::filesystem::path _path{};
+};
+
+} // namespace
+
+TEST_F(StateCheckpointTest, RestoredRunMatchesUninterruptedRun)
+{
+    const auto bars{make_bars(400)};
+
+    Pipeline uninterrupted{_path.string() + ".unused"};
+    for (const auto& bar : bars)
+        uninterrupted.on_bar(bar);
+    std::filesystem::remove(_path.string() + ".unused");
+
+    // stop mid-window (bar 212 is the 3rd bar of its 5-minute window), restart from the checkpoint
+    {
+        Pipeline before_restart{_path};
+        for (int i = 0; i < 213; ++i)
+            before_restart.on_bar(bars[i]);
+        before_restart.checkpointer.save();
+    }
+
+    Pipeline after_restart{_path};
+    ASSERT_EQ(after_restart.checkpointer.restore(bars[213].timestamp()), Checkpointer::RestoreResult::Restored);
+    EXPECT_EQ(after_restart.checkpointer.last_bar_timestamp(), bars[212].timestamp());
+    EXPECT_TRUE(after_restart.engine.is_ready());
+
+    for (std::size_t i = 213; i < bars.size(); ++i)
+        after_restart.on_bar(bars[i]);
+
+    const auto expected{uninterrupted.engine.snapshot().values()};
+    const auto actual{after_restart.engine.snapshot().values()};
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(expected[i], actual[i]) << "field " << i;
+    }
+}
+
+TEST_F(StateCheckpointTest, SavesPeriodically)
+{
+    const auto bars{make_bars(20)};
+
+    Pipeline pipeline{_path, 7};
+    for (int i = 0; i < 6; ++i)
+        pipeline.on_bar(bars[i]);
+    EXPECT_FALSE(std::filesystem::exists(_path));
+
+    for (int i = 6; i < 16; ++i)
+        pipeline.on_bar(bars[i]);
+    const auto checkpoint{loadCheckpoint(_path)};
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(checkpoint->last_bar_timestamp, bars[13].timestamp());
+}
+
+TEST_F(StateCheckpointTest, NoCheckpoint)
+{
+    Pipeline pipeline{_path};
+    EXPECT_EQ(pipeline.checkpointer.restore(START), Checkpointer::RestoreResult::NoCheckpoint);
+    EXPECT_FALSE(pipeline.checkpointer.last_bar_timestamp().has_value());
+}
+
+TEST_F(StateCheckpointTest, RejectsCheckpointNotOlderThanNextBar)
+{
+    const auto bars{make_bars(50)};
+    {
+        Pipeline pipeline{_path};
+        for (const auto& bar : bars)
+            pipeline.on_bar(bar);
+        pipeline.checkpointer.save();
+    }
+
+    Pipeline pipeline{_path};
+    EXPECT_EQ(pipeline.checkpointer.restore(bars.back().timestamp()), Checkpointer::RestoreResult::Rejected);
+    EXPECT_EQ(pipeline.checkpointer.restore(bars[10].timestamp()), Checkpointer::RestoreResult::Rejected);
+    EXPECT_FALSE(pipeline.engine.is_ready());
+}
+
+TEST_F(StateCheckpointTest, GapRestoresIndicatorsOnly)
+{
+    const auto bars{make_bars(300)};
+    {
+        Pipeline pipeline{_path};
+        for (int i = 0; i < 203; ++i)
+            pipeline.on_bar(bars[i]);
+        pipeline.checkpointer.save();
+    }
+
+    // bars 203..209 were missed; the next delivered bar starts a fresh window
+    Pipeline pipeline{_path};
+    ASSERT_EQ(
+        pipeline.checkpointer.restore(bars[210].timestamp()), Checkpointer::RestoreResult::RestoredIndicatorsOnly);
+    EXPECT_TRUE(pipeline.engine.is_ready());
+    EXPECT_NO_THROW(pipeline.on_bar(bars[210]));
+}
+
+TEST_F(StateCheckpointTest, RejectsDifferentIndicatorSet)
+{
+    const auto bars{make_bars(30)};
+    {
+        Pipeline pipeline{_path};
+        for (const auto& bar : bars)
+            pipeline.on_bar(bar);
+        pipeline.checkpointer.save();
+    }
+
+    BarAggregator<5, minutes>        aggregator{};
+    OHLCVIndicatorEngine<5, minutes> engine{{IndicatorConfig{.name = "EMA", .params = {{"period", 50}}}}};
+    Checkpointer                     checkpointer{_path, aggregator, engine, 7};
+    EXPECT_THROW(checkpointer.restore(bars.back().timestamp() + minutes{1}), std::runtime_error);
+}
+
+TEST_F(StateCheckpointTest, CorruptFileThrows)
+{
+    saveCheckpoint(
+        _path,
+        Checkpoint{.last_bar_timestamp = START, .payload = std::vector<std::byte>(64, std::byte{0x2a})});
+    ASSERT_TRUE(loadCheckpoint(_path).has_value());
+
+    {
+        std::fstream file{_path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(-1, std::ios::end);
+        file.put('\x00');
+    }
+    EXPECT_THROW((void)loadCheckpoint(_path), std::runtime_error);
+
+    std::filesystem::resize_file(_path, 16);
+    EXPECT_THROW((void)loadCheckpoint(_path), std::runtime_error);
+}
+
+TEST(MACDStateTest, SharedModeStateLoadsIntoStandaloneMACD)
+{
+    EMA  fast{12};
+    EMA  slow{26};
+    MACD shared{12, 26, 9};
+    shared.bind_dependencies(std::vector<const OHLCVIndicator*>{&fast, &slow});
+    MACD reference{12, 26, 9};
+
+    const auto bars{make_bars(80)};
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+        // the engine writes shared dependencies before their consumers
+        fast.write(bars[i].ohlcv());
+        slow.write(bars[i].ohlcv());
+        shared.write(bars[i].ohlcv());
+        reference.write(bars[i].ohlcv());
+    }
+
+    StateWriter writer{};
+    shared.save_state(writer);
+    MACD        restored{12, 26, 9};
+    StateReader reader{writer.buffer()};
+    restored.load_state(reader);
+    EXPECT_TRUE(reader.at_end());
+
+    for (std::size_t i = 50; i < bars.size(); ++i)
+    {
+        restored.write(bars[i].ohlcv());
+        reference.write(bars[i].ohlcv());
+        ASSERT_DOUBLE_EQ(restored.macd(), reference.macd()) << "bar " << i;
+        ASSERT_DOUBLE_EQ(restored.signal(), reference.signal()) << "bar " << i;
+    }
+}
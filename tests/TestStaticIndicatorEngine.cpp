@@ -0,0 +1,85 @@
+#include "Bar.hpp"
+#include "IndicatorConfig.hpp"
+#include "IndicatorEngine.hpp"
+#include "StaticIndicatorEngine.hpp"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+using StrategyEngine = StaticIndicatorEngine<
+    5,
+    minutes,
+    static_indicators::EMA<200>,
+    static_indicators::MACD<12, 26, 9>,
+    static_indicators::ATR<14>>;
+
+// handles are compile-time constants laid out in declaration order
+static_assert(StrategyEngine::FIELD_COUNT == 5);
+static_assert(StrategyEngine::handle<static_indicators::EMA<200>>("ema").index == 0);
+static_assert(StrategyEngine::handle<static_indicators::MACD<12, 26, 9>>("signal").index == 2);
+static_assert(StrategyEngine::handle<static_indicators::ATR<14>>("atr").index == 4);
+
+} // namespace
+
+TEST(StaticIndicatorEngineTest, MatchesRuntimeEngine)
+{
+    const std::vector<IndicatorConfig> configs{
+        IndicatorConfig{.name = "EMA", .params = {{"period", 200}}},
+        IndicatorConfig{.name = "MACD", .params = {{"fast_period", 12}, {"slow_period", 26}, {"signal_period", 9}}},
+        IndicatorConfig{.name = "ATR", .params = {{"period", 14}}}};
+
+    DefaultIndicatorEngine runtime_engine{configs};
+    StrategyEngine         static_engine{};
+
+    int  runtime_updates{0};
+    int  static_updates{0};
+    auto runtime_connection{runtime_engine.subscribe([&](const auto&) { ++runtime_updates; })};
+    auto static_connection{static_engine.subscribe([&](const auto&) { ++static_updates; })};
+
+    std::mt19937                     rng{3};
+    std::normal_distribution<double> step{0.0, 0.5};
+
+    double                  price{50.0};
+    const sys_time<minutes> start{minutes{600}};
+    for (int i = 0; i < 400; ++i)
+    {
+        const double open{price};
+        price += step(rng);
+        const Bar5min bar{
+            "STATIC",
+            open,
+            std::max(open, price) + 0.3,
+            std::min(open, price) - 0.2,
+            price,
+            1000,
+            start + minutes{5 * i}};
+
+        runtime_engine.on_bar(bar);
+        static_engine.on_bar(bar);
+        ASSERT_EQ(runtime_engine.is_ready(), static_engine.is_ready()) << "bar " << i;
+    }
+    runtime_connection.disconnect();
+    static_connection.disconnect();
+
+    EXPECT_EQ(runtime_updates, static_updates);
+    ASSERT_TRUE(static_engine.is_ready());
+
+    const auto& values{static_engine.values()};
+    ASSERT_EQ(runtime_engine.snapshot().values().size(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(runtime_engine.snapshot().values()[i], values[i]) << "field " << i;
+    }
+
+    constexpr auto signal{StrategyEngine::handle<static_indicators::MACD<12, 26, 9>>("signal")};
+    EXPECT_DOUBLE_EQ(values[signal.index], runtime_engine.snapshot()[runtime_engine.handle("MACD", "signal")]);
+    const auto& macd{static_engine.get<static_indicators::MACD<12, 26, 9>>()};
+    EXPECT_DOUBLE_EQ(macd.signal(), values[signal.index]);
+}
@@ -1,10 +1,17 @@
 #include "Bar.hpp"
 #include "Utils.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstdio>
+#include <ctime>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <iomanip>
+#include <random>
+#include <sstream>
 #include <string>
 
 using namespace std::chrono;
@@ -79,3 +86,98 @@ TEST_F(UtilsTest, CreateBarsFromCSV)
         EXPECT_EQ(bars[i], expected_bars[i]) << "Bar " << i << " does not match expected value";
     }
 }
+
+namespace
+{
+
+// the std::get_time-based implementation parseRFC3339UTCTimestamp used before the fixed-layout parser
+sys_time<minutes> referenceParse(const std::string& timestamp, const char* fmt_string)
+{
+    std::stringstream ss{timestamp};
+    std::tm           tm{};
+    ss >> std::get_time(&tm, fmt_string);
+    if (ss.fail())
+    {
+        throw std::invalid_argument{"Invalid timestamp format"};
+    }
+    return time_point_cast<minutes>(system_clock::from_time_t(timegm(&tm)));
+}
+
+std::string formatTimestamp(const sys_seconds ts, const char separator, const char* suffix)
+{
+    const auto              day{floor<days>(ts)};
+    const year_month_day    date{day};
+    const hh_mm_ss<seconds> time{ts - day};
+    std::array<char, 32>    text{};
+    std::snprintf(
+        text.data(),
+        text.size(),
+        "%04d-%02u-%02u%c%02ld:%02ld:%02ld%s",
+        static_cast<int>(date.year()),
+        static_cast<unsigned>(date.month()),
+        static_cast<unsigned>(date.day()),
+        separator,
+        static_cast<long>(time.hours().count()),
+        static_cast<long>(time.minutes().count()),
+        static_cast<long>(time.seconds().count()),
+        suffix);
+    return text.data();
+}
+
+} // namespace
+
+TEST(RFC3339TimestampTest, MatchesGetTimeImplementation)
+{
+    std::mt19937_64                             rng{2024};
+    std::uniform_int_distribution<std::int64_t> seconds_since_epoch{0, 4'102'444'800}; // 1970 .. 2100
+
+    for (int i = 0; i < 20'000; ++i)
+    {
+        const sys_seconds ts{seconds{seconds_since_epoch(rng)}};
+        const std::string zulu{formatTimestamp(ts, 'T', "Z")};
+        const std::string offset{formatTimestamp(ts, ' ', "+00:00")};
+
+        ASSERT_EQ(parseRFC3339UTCTimestamp(zulu), referenceParse(zulu, "%Y-%m-%dT%H:%M:%S")) << zulu;
+        ASSERT_EQ(parseRFC3339UTCTimestamp(offset), referenceParse(offset, "%Y-%m-%d %H:%M:%S")) << offset;
+        ASSERT_EQ(parseRFC3339Timestamp(zulu), ts) << zulu;
+    }
+}
+
+TEST(RFC3339TimestampTest, ParsesFractionsAndOffsets)
+{
+    const sys_time<nanoseconds> base{sys_days{2021y / February / 22} + hours{15} + minutes{51} + seconds{44}};
+
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-22T15:51:44.208Z"), base + milliseconds{208});
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-22T15:51:44.123456789Z"), base + nanoseconds{123'456'789});
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-22T15:51:44.1234567891234Z"), base + nanoseconds{123'456'789});
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-22t15:51:44z"), base);
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-22T10:51:44-05:00"), base);
+    EXPECT_EQ(parseRFC3339Timestamp("2021-02-23T01:21:44.5+09:30"), base + milliseconds{500});
+
+    EXPECT_EQ(truncateTimestamp<minutes>(base + milliseconds{208}), sys_days{2021y / February / 22} + 15h + 51min);
+    EXPECT_EQ(parseRFC3339UTCTimestamp("2021-02-22T15:51:44.999Z"), sys_days{2021y / February / 22} + 15h + 51min);
+}
+
+TEST(RFC3339TimestampTest, RejectsMalformedTimestamps)
+{
+    for (const char* timestamp :
+         {"",
+          "2021-02-22",
+          "2021-02-22T15:51:44",
+          "2021-02-22X15:51:44Z",
+          "2021/02/22T15:51:44Z",
+          "2021-02-30T15:51:44Z",
+          "2021-13-01T15:51:44Z",
+          "2021-02-22T24:00:00Z",
+          "2021-02-22T15:60:00Z",
+          "2021-02-22T15:51:4aZ",
+          "2021-02-22T15:51:44.Z",
+          "2021-02-22T15:51:44+0500",
+          "2021-02-22T15:51:44Zjunk"})
+    {
+        EXPECT_THROW((void)parseRFC3339Timestamp(timestamp), std::invalid_argument) << timestamp;
+    }
+
+    // valid RFC3339, but not UTC
+    EXPECT_THROW((void)parseRFC3339UTCTimestamp("2021-02-22T10:51:44-05:00"), std::invalid_argument);
+}
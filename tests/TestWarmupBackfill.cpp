@@ -0,0 +1,155 @@
+#include "Bar.hpp"
+#include "BarAggregator.hpp"
+#include "SymbolTable.hpp"
+#include "WarmupBackfill.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace
+{
+
+const sys_time<minutes> START{minutes{29'000'000}};
+
+std::vector<Bar1min> make_bars(const std::string_view symbol, const int first, const int last)
+{
+    std::vector<Bar1min> bars{};
+    for (int i = first; i < last; ++i)
+    {
+        const double price{100.0 + i};
+        bars.emplace_back(symbol, price, price + 1.0, price - 1.0, price + 0.5, 10, START + minutes{i});
+    }
+    return bars;
+}
+
+} // namespace
+
+TEST(WarmupBackfillTest, LiveFeedOverlappingArchiveIsDeduplicated)
+{
+    BarAggregator<5, minutes> aggregator{};
+    std::vector<Bar5min>      aggregated{};
+    auto connection{aggregator.subscribe([&](const Bar5min& bar) { aggregated.push_back(bar); })};
+
+    std::vector<Bar1min::Timestamp> forwarded{};
+    const auto                      sink{[&](const Bar1min& bar)
+                        {
+                            forwarded.push_back(bar.timestamp());
+                            aggregator.on_bar(bar);
+                        }};
+    WarmupBackfill                  backfill{sink};
+
+    EXPECT_EQ(backfill.replay(make_bars("WARM", 0, 100)), 100u);
+
+    // the feed starts a few minutes behind the end of the archive
+    for (const auto& bar : make_bars("WARM", 95, 120))
+    {
+        ASSERT_NO_THROW(backfill.on_live_bar(bar));
+    }
+    connection.disconnect();
+
+    EXPECT_EQ(backfill.duplicates_dropped(), 5u);
+    ASSERT_EQ(forwarded.size(), 120u);
+    for (std::size_t i = 0; i < forwarded.size(); ++i)
+    {
+        EXPECT_EQ(forwarded[i], START + minutes{i});
+    }
+    EXPECT_EQ(aggregated.size(), 24u);
+    EXPECT_EQ(backfill.last_timestamp(SymbolTable::intern("WARM")), START + minutes{119});
+}
+
+TEST(WarmupBackfillTest, GapsResetTheAggregatorInsteadOfBreakingIt)
+{
+    BarAggregator<5, minutes> aggregator{};
+    std::vector<Bar5min>      aggregated{};
+    auto connection{aggregator.subscribe([&](const Bar5min& bar) { aggregated.push_back(bar); })};
+
+    std::vector<SymbolId> gap_symbols{};
+    WarmupBackfill        backfill{
+        [&aggregator](const Bar1min& bar) { aggregator.on_bar(bar); },
+        [&](const SymbolId symbol)
+        {
+            gap_symbols.push_back(symbol);
+            aggregator.reset();
+        }};
+
+    // two archived sessions with an overnight gap, then a feed that starts well after the archive ends
+    std::vector<Bar1min> archive{make_bars("GAPS", 0, 12)};
+    std::ranges::copy(make_bars("GAPS", 1000, 1010), std::back_inserter(archive));
+    ASSERT_NO_THROW(EXPECT_EQ(backfill.replay(archive), 22u));
+    for (const auto& bar : make_bars("GAPS", 2000, 2005))
+    {
+        ASSERT_NO_THROW(EXPECT_TRUE(backfill.on_live_bar(bar)));
+    }
+    connection.disconnect();
+
+    EXPECT_EQ(backfill.gaps(), 2u);
+    EXPECT_EQ(gap_symbols, (std::vector<SymbolId>(2, SymbolTable::intern("GAPS"))));
+
+    // the partial window of minutes 10-11 is dropped at the gap; each later session aggregates from its own start
+    ASSERT_EQ(aggregated.size(), 5u);
+    EXPECT_EQ(aggregated[2].timestamp(), START + minutes{1000});
+    EXPECT_EQ(aggregated[3].timestamp(), START + minutes{1005});
+    EXPECT_EQ(aggregated[4].timestamp(), START + minutes{2000});
+}
+
+TEST(WarmupBackfillTest, InterleavedSymbolsAreFilteredIndependently)
+{
+    std::vector<Bar1min> archive{};
+    const auto           aaa{make_bars("AAA", 0, 10)};
+    const auto           bbb{make_bars("BBB", 5, 15)};
+    for (std::size_t i = 0; i < aaa.size(); ++i)
+    {
+        archive.push_back(aaa[i]);
+        archive.push_back(bbb[i]);
+    }
+
+    std::size_t    count{0};
+    WarmupBackfill backfill{[&count](const Bar1min&) { ++count; }};
+    EXPECT_EQ(backfill.replay(archive), 20u);
+
+    // AAA minute 12 is new, BBB minute 12 was already replayed
+    EXPECT_TRUE(backfill.on_live_bar(make_bars("AAA", 12, 13).front()));
+    EXPECT_FALSE(backfill.on_live_bar(make_bars("BBB", 12, 13).front()));
+    EXPECT_EQ(count, 21u);
+    EXPECT_FALSE(backfill.last_timestamp(SymbolTable::intern("NEVER_SEEN")).has_value());
+}
+
+TEST(WarmupBackfillTest, ResumeAfterSkipsCheckpointedBars)
+{
+    std::vector<Bar1min::Timestamp> forwarded{};
+    WarmupBackfill backfill{[&forwarded](const Bar1min& bar) { forwarded.push_back(bar.timestamp()); }};
+
+    backfill.resume_after(SymbolTable::intern("RESUME"), START + minutes{49});
+    EXPECT_EQ(backfill.replay(make_bars("RESUME", 0, 60)), 10u);
+    ASSERT_FALSE(forwarded.empty());
+    EXPECT_EQ(forwarded.front(), START + minutes{50});
+}
+
+TEST(WarmupBackfillTest, ReplaysCSVArchive)
+{
+    const auto path{std::filesystem::temp_directory_path() / "warmup_backfill_test.csv"};
+    {
+        std::ofstream file{path};
+        file << "symbol,timestamp,open,high,low,close,volume,trade_count,vwap\n";
+        file << "CSVW,2025-05-19T13:30:00Z,10.0,11.0,9.5,10.5,100,5,10.2\n";
+        file << "CSVW,2025-05-19T13:31:00Z,10.5,11.5,10.0,11.0,200,7,10.8\n";
+    }
+
+    std::vector<Bar1min> forwarded{};
+    WarmupBackfill       backfill{[&forwarded](const Bar1min& bar) { forwarded.push_back(bar); }};
+    EXPECT_EQ(backfill.replay_csv(path.string()), 2u);
+    EXPECT_EQ(backfill.replay_csv(path.string()), 0u);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(forwarded.size(), 2u);
+    EXPECT_EQ(forwarded[1].symbol_name(), "CSVW");
+    EXPECT_DOUBLE_EQ(forwarded[1].close(), 11.0);
+}
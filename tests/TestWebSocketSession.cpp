@@ -1,3 +1,4 @@
+#include "LoopbackWebSocketServer.hpp"
 #include "WebSocketSession.hpp"
 
 #include <boost/asio.hpp>
@@ -6,7 +7,9 @@
 #include <future>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace asio = boost::asio;
 namespace ssl  = asio::ssl;
@@ -64,3 +67,59 @@ TEST_F(WebSocketSessionTest, EchoRoundTrip)
     ioc.stop();
     t.join();
 }
+
+TEST(WebSocketSessionReconnectTest, DroppedConnectionReconnectsAndReplaysAuthAndSubscription)
+{
+    std::vector<std::vector<std::string>> received(2);
+    LoopbackWebSocketServer               server{
+        2,
+        [&received](const std::size_t connection, LoopbackWebSocketServer::Stream& ws) -> asio::awaitable<void>
+        {
+            received[connection].push_back(co_await LoopbackWebSocketServer::read(ws));
+            received[connection].push_back(co_await LoopbackWebSocketServer::read(ws));
+            if (connection == 0)
+            {
+                co_return;
+            }
+
+            co_await LoopbackWebSocketServer::write(ws, "ready");
+            for (;;)
+            {
+                (void)co_await LoopbackWebSocketServer::read(ws);
+            }
+        }};
+
+    asio::io_context ioc;
+    ssl::context     ssl_ctxt(ssl::context::tls_client);
+    ssl_ctxt.set_verify_mode(ssl::context::verify_none);
+
+    const WebSocketSessionConfig config{
+        .host     = "127.0.0.1",
+        .port     = server.port(),
+        .endpoint = "/",
+        .auth_msg = "auth",
+        .sub_msg  = "subscribe",
+        .ssl_ctxt = ssl_ctxt};
+
+    std::vector<std::string>          frames{};
+    int                               disconnects{0};
+    std::shared_ptr<WebSocketSession> wss;
+    wss = WebSocketSession::create(
+        ioc,
+        config,
+        [&](const std::string_view frame)
+        {
+            frames.emplace_back(frame);
+            wss->stop();
+        });
+    wss->set_disconnect_handler([&disconnects] { ++disconnects; });
+
+    wss->start();
+    ioc.run_for(std::chrono::seconds(10));
+
+    ASSERT_TRUE(server.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(disconnects, 1);
+    EXPECT_EQ(received[0], (std::vector<std::string>{"auth", "subscribe"}));
+    EXPECT_EQ(received[1], (std::vector<std::string>{"auth", "subscribe"}));
+    EXPECT_EQ(frames, std::vector<std::string>{"ready"});
+}
@@ -0,0 +1,119 @@
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingPoolTest, RunsEveryTask)
+{
+    WorkStealingPool pool{4};
+    EXPECT_EQ(pool.thread_count(), 4u);
+
+    std::vector<int> hits(1000, 0);
+    for (std::size_t i = 0; i < hits.size(); ++i)
+    {
+        pool.submit([&hits, i] { ++hits[i]; });
+    }
+    pool.wait();
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 1000);
+
+    // the pool is reusable after wait()
+    std::atomic<int> count{0};
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&count] { ++count; });
+    }
+    pool.wait();
+    EXPECT_EQ(count.load(), 10);
+}
+
+TEST(WorkStealingPoolTest, IdleWorkersStealFromBusyOnes)
+{
+    WorkStealingPool pool{2};
+
+    // once one worker is blocked, round-robin still deals half of the tasks onto its queue; the other worker has to
+    // steal them for all tasks to finish while it stays blocked
+    std::atomic<bool>            started{false};
+    std::atomic<bool>            release{false};
+    std::atomic<std::thread::id> blocked_worker{};
+    pool.submit(
+        [&]
+        {
+            blocked_worker = std::this_thread::get_id();
+            started        = true;
+            while (!release)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+        });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    std::mutex                mutex{};
+    std::set<std::thread::id> workers{};
+    std::atomic<int>          done{0};
+    for (int i = 0; i < 20; ++i)
+    {
+        pool.submit(
+            [&]
+            {
+                std::lock_guard lock{mutex};
+                workers.insert(std::this_thread::get_id());
+                ++done;
+            });
+    }
+
+    const auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds{10}};
+    while (done < 20 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ(done.load(), 20);
+    EXPECT_EQ(workers.size(), 1u);
+    EXPECT_FALSE(workers.contains(blocked_worker.load()));
+
+    release = true;
+    pool.wait();
+}
+
+TEST(WorkStealingPoolTest, RethrowsFirstTaskException)
+{
+    WorkStealingPool pool{3};
+    std::atomic<int> count{0};
+    for (int i = 0; i < 30; ++i)
+    {
+        pool.submit(
+            [&count, i]
+            {
+                ++count;
+                if (i == 7)
+                {
+                    throw std::runtime_error{"task failed"};
+                }
+            });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(count.load(), 30);
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(WorkStealingPoolTest, DestructorDrainsQueuedTasks)
+{
+    std::atomic<int> count{0};
+    {
+        WorkStealingPool pool{2};
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&count] { ++count; });
+        }
+    }
+    EXPECT_EQ(count.load(), 100);
+}
@@ -0,0 +1,36 @@
+#include "BarArchive.hpp"
+#include "CSVBarLoader.hpp"
+
+#include <exception>
+#include <iostream>
+
+/**
+ * Converts a bar CSV (the layout written by test-utils/historical_bars_to_csv.py) into a BarArchive.
+ *
+ *     csv_to_bar_archive <bars.csv> <bars.archive>
+ */
+int main(const int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <bars.csv> <bars.archive>\n";
+        return 1;
+    }
+
+    try
+    {
+        CSVBarLoader loader{};
+        const auto   bars{loader.load(argv[1])};
+        writeBarArchive(argv[2], bars);
+
+        const BarArchive archive{argv[2]};
+        std::cout << "wrote " << archive.bar_count() << " bars in " << archive.blocks().size() << " symbol blocks to "
+                  << argv[2] << " (CSV parsed at " << loader.last_stats().rows_per_second() << " rows/s)\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "csv_to_bar_archive: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
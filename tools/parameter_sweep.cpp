@@ -0,0 +1,58 @@
+#include "CSVBarLoader.hpp"
+#include "ParameterSweep.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+
+/**
+ * Tunes the MACD strategy on one symbol's bars and prints the 25 best configurations as CSV.
+ *
+ *     parameter_sweep <bars.csv> [samples [seed]]
+ *
+ * Without samples every point of the grid below is backtested; with samples, that many random points are drawn from
+ * it instead.
+ */
+int main(const int argc, char** argv)
+{
+    if (argc < 2 || argc > 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <bars.csv> [samples [seed]]\n";
+        return 1;
+    }
+
+    const ParameterGrid grid{
+        .ema_periods         = {50, 100, 150, 200},
+        .fast_periods        = {8, 10, 12, 15},
+        .slow_periods        = {21, 26, 30},
+        .signal_periods      = {7, 9, 12},
+        .atr_periods         = {10, 14, 20},
+        .atr_thresholds      = {0.005, 0.01, 0.02},
+        .stop_atr_multiples  = {1.0, 1.5, 2.0, 3.0},
+        .aggregation_minutes = {1, 5, 15, 30, 60}};
+
+    try
+    {
+        const auto bars{CSVBarLoader{}.load(argv[1]).to_bars()};
+        const auto candidates{
+            argc > 2 ? grid.sample(std::stoul(argv[2]), argc > 3 ? std::stoull(argv[3]) : std::uint64_t{1})
+                     : grid.expand()};
+
+        const auto                          start{std::chrono::steady_clock::now()};
+        const ParameterSweep                sweep{bars, BacktestConfig{.starting_cash = 10'000.0}};
+        const auto                          results{sweep.run(candidates)};
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+        std::cerr << "backtested " << results.size() << " configurations over " << bars.size() << " bars in "
+                  << elapsed.count() << " s\n";
+        writeSweepResults(std::cout, results, 25);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "parameter_sweep: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}